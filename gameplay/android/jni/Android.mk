@@ -30,8 +30,10 @@ LOCAL_SRC_FILES := \
     AudioController.cpp \
     AudioListener.cpp \
     AudioSource.cpp \
+    BlockPool.cpp \
     BoundingBox.cpp \
     BoundingSphere.cpp \
+    BoundingVolumeHierarchy.cpp \
     Bundle.cpp \
     Button.cpp \
     Camera.cpp \
@@ -56,6 +58,8 @@ LOCAL_SRC_FILES := \
     HorizontalLayout.cpp \
     Image.cpp \
     ImageControl.cpp \
+    InstancedModel.cpp \
+    JobScheduler.cpp \
     Joint.cpp \
     JoystickControl.cpp \
     Label.cpp \
@@ -73,6 +77,8 @@ LOCAL_SRC_FILES := \
     MeshSkin.cpp \
     Model.cpp \
     Node.cpp \
+    NullGL.cpp \
+    OcclusionCuller.cpp \
     Package.cpp \
     ParticleEmitter.cpp \
     Pass.cpp \
@@ -93,6 +99,7 @@ LOCAL_SRC_FILES := \
     Plane.cpp \
     Platform.cpp \
     PlatformAndroid.cpp \
+    ProgramCache.cpp \
     ProgressBar.cpp \
     Properties.cpp \
     Quaternion.cpp \
@@ -100,8 +107,11 @@ LOCAL_SRC_FILES := \
     Ray.cpp \
     Rectangle.cpp \
     Ref.cpp \
+    RenderQueue.cpp \
     RenderState.cpp \
     RenderTarget.cpp \
+    ResourceCache.cpp \
+    ResourceLoader.cpp \
     Scene.cpp \
     SceneLoader.cpp \
     ScreenDisplayer.cpp \
@@ -115,6 +125,7 @@ LOCAL_SRC_FILES := \
     SocialPlayer.cpp \
     SocialScore.cpp \
     SocialSessionListener.cpp \
+    SoftwareSkin.cpp \
     Sprite.cpp \
     SpriteBatch.cpp \
     Technique.cpp \
@@ -123,6 +134,7 @@ LOCAL_SRC_FILES := \
     Text.cpp \
     TextBox.cpp \
     Texture.cpp \
+    TextureAtlas.cpp \
     Theme.cpp \
     ThemeStyle.cpp \
     TileSet.cpp \
@@ -26,9 +26,11 @@ SOURCES += src/AbsoluteLayout.cpp \
     src/AudioController.cpp \
     src/AudioListener.cpp \
     src/AudioSource.cpp \
+    src/BlockPool.cpp \
     src/BoundingBox.cpp \
     src/BoundingBox.inl \
     src/BoundingSphere.cpp \
+    src/BoundingVolumeHierarchy.cpp \
     src/BoundingSphere.inl \
     src/Bundle.cpp \
     src/Button.cpp \
@@ -54,6 +56,8 @@ SOURCES += src/AbsoluteLayout.cpp \
     src/Image.cpp \
     src/Image.inl \
     src/ImageControl.cpp \
+    src/InstancedModel.cpp \
+    src/JobScheduler.cpp \
     src/Joint.cpp \
     src/JoystickControl.cpp \
     src/Label.cpp \
@@ -65,6 +69,7 @@ SOURCES += src/AbsoluteLayout.cpp \
     src/MathUtil.cpp \
     src/MathUtil.inl \
     src/MathUtilNeon.inl \
+    src/MathUtilSSE.inl \
     src/Matrix.cpp \
     src/Matrix.inl \
     src/Mesh.cpp \
@@ -74,6 +79,8 @@ SOURCES += src/AbsoluteLayout.cpp \
     src/MeshSkin.cpp \
     src/Model.cpp \
     src/Node.cpp \
+    src/NullGL.cpp \
+    src/OcclusionCuller.cpp \
     src/ParticleEmitter.cpp \
     src/Pass.cpp \
     src/PhysicsCharacter.cpp \
@@ -98,6 +105,7 @@ SOURCES += src/AbsoluteLayout.cpp \
     src/Plane.cpp \
     src/Plane.inl \
     src/Platform.cpp \
+    src/ProgramCache.cpp \
     src/Properties.cpp \
     src/Quaternion.cpp \
     src/Quaternion.inl \
@@ -106,8 +114,11 @@ SOURCES += src/AbsoluteLayout.cpp \
     src/Ray.inl \
     src/Rectangle.cpp \
     src/Ref.cpp \
+    src/RenderQueue.cpp \
     src/RenderState.cpp \
     src/RenderTarget.cpp \
+    src/ResourceCache.cpp \
+    src/ResourceLoader.cpp \
     src/Scene.cpp \
     src/SceneLoader.cpp \
     src/ScreenDisplayer.cpp \
@@ -116,6 +127,7 @@ SOURCES += src/AbsoluteLayout.cpp \
     src/ScriptController.inl \
     src/ScriptTarget.cpp \
     src/Slider.cpp \
+    src/SoftwareSkin.cpp \
     src/Sprite.cpp \
     src/SpriteBatch.cpp \
     src/Technique.cpp \
@@ -124,6 +136,7 @@ SOURCES += src/AbsoluteLayout.cpp \
     src/Text.cpp \
     src/TextBox.cpp \
     src/Texture.cpp \
+    src/TextureAtlas.cpp \
     src/Theme.cpp \
     src/ThemeStyle.cpp \
     src/TileSet.cpp \
@@ -288,8 +301,10 @@ HEADERS += src/AbsoluteLayout.h \
     src/AudioListener.h \
     src/AudioSource.h \
     src/Base.h \
+    src/BlockPool.h \
     src/BoundingBox.h \
     src/BoundingSphere.h \
+    src/BoundingVolumeHierarchy.h \
     src/Bundle.h \
     src/Button.h \
     src/Camera.h \
@@ -314,6 +329,8 @@ HEADERS += src/AbsoluteLayout.h \
     src/HeightField.h \
     src/Image.h \
     src/ImageControl.h \
+    src/InstancedModel.h \
+    src/JobScheduler.h \
     src/Joint.h \
     src/JoystickControl.h \
     src/Keyboard.h \
@@ -332,6 +349,8 @@ HEADERS += src/AbsoluteLayout.h \
     src/Model.h \
     src/Mouse.h \
     src/Node.h \
+    src/NullGL.h \
+    src/OcclusionCuller.h \
     src/ParticleEmitter.h \
     src/Pass.h \
     src/PhysicsCharacter.h \
@@ -350,14 +369,18 @@ HEADERS += src/AbsoluteLayout.h \
     src/PhysicsVehicleWheel.h \
     src/Plane.h \
     src/Platform.h \
+    src/ProgramCache.h \
     src/Properties.h \
     src/Quaternion.h \
     src/RadioButton.h \
     src/Ray.h \
     src/Rectangle.h \
     src/Ref.h \
+    src/RenderQueue.h \
     src/RenderState.h \
     src/RenderTarget.h \
+    src/ResourceCache.h \
+    src/ResourceLoader.h \
     src/Scene.h \
     src/SceneLoader.h \
     src/ScreenDisplayer.h \
@@ -365,6 +388,7 @@ HEADERS += src/AbsoluteLayout.h \
     src/ScriptController.h \
     src/ScriptTarget.h \
     src/Slider.h \
+    src/SoftwareSkin.h \
     src/Sprite.h \
     src/SpriteBatch.h \
     src/Stream.h \
@@ -374,6 +398,7 @@ HEADERS += src/AbsoluteLayout.h \
     src/Text.h \
     src/TextBox.h \
     src/Texture.h \
+    src/TextureAtlas.h \
     src/Theme.h \
     src/ThemeStyle.h \
     src/TileSet.h \
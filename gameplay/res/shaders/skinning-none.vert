@@ -1,3 +1,42 @@
+#if defined(INSTANCING)
+
+attribute vec4 a_instanceMatrix0;
+attribute vec4 a_instanceMatrix1;
+attribute vec4 a_instanceMatrix2;
+
+vec4 getPosition()
+{
+    return vec4(dot(a_position, a_instanceMatrix0), dot(a_position, a_instanceMatrix1), dot(a_position, a_instanceMatrix2), a_position.w);
+}
+
+vec3 getInstanceVector(vec3 vector)
+{
+    return vec3(dot(vector, a_instanceMatrix0.xyz), dot(vector, a_instanceMatrix1.xyz), dot(vector, a_instanceMatrix2.xyz));
+}
+
+#if defined(LIGHTING)
+
+vec3 getNormal()
+{
+    return getInstanceVector(a_normal);
+}
+
+#if defined(BUMPED)
+vec3 getTangent()
+{
+    return getInstanceVector(a_tangent);
+}
+
+vec3 getBinormal()
+{
+    return getInstanceVector(a_binormal);
+}
+#endif
+
+#endif
+
+#else
+
 vec4 getPosition()
 {
     return a_position;    
@@ -22,4 +61,6 @@ vec3 getBinormal()
 }
 #endif
 
-#endif
\ No newline at end of file
+#endif
+
+#endif
@@ -16,7 +16,7 @@ namespace gameplay
 {
 
 Animation::Animation(const char* id, AnimationTarget* target, int propertyId, unsigned int keyCount, unsigned int* keyTimes, float* keyValues, unsigned int type)
-    : _controller(Game::getInstance()->getAnimationController()), _id(id), _duration(0L), _defaultClip(NULL), _clips(NULL)
+    : _controller(Game::getInstance()->getAnimationController()), _id(id), _duration(0L), _defaultClip(NULL), _clips(NULL), _channelBatchesDirty(true)
 {
     createChannel(target, propertyId, keyCount, keyTimes, keyValues, type);
 
@@ -26,7 +26,7 @@ Animation::Animation(const char* id, AnimationTarget* target, int propertyId, un
 }
 
 Animation::Animation(const char* id, AnimationTarget* target, int propertyId, unsigned int keyCount, unsigned int* keyTimes, float* keyValues, float* keyInValue, float* keyOutValue, unsigned int type)
-    : _controller(Game::getInstance()->getAnimationController()), _id(id), _duration(0L), _defaultClip(NULL), _clips(NULL)
+    : _controller(Game::getInstance()->getAnimationController()), _id(id), _duration(0L), _defaultClip(NULL), _clips(NULL), _channelBatchesDirty(true)
 {
     createChannel(target, propertyId, keyCount, keyTimes, keyValues, keyInValue, keyOutValue, type);
     // Release the animation because a newly created animation has a ref count of 1 and the channels hold the ref to animation.
@@ -35,7 +35,7 @@ Animation::Animation(const char* id, AnimationTarget* target, int propertyId, un
 }
 
 Animation::Animation(const char* id)
-    : _controller(Game::getInstance()->getAnimationController()), _id(id), _duration(0L), _defaultClip(NULL), _clips(NULL)
+    : _controller(Game::getInstance()->getAnimationController()), _id(id), _duration(0L), _defaultClip(NULL), _clips(NULL), _channelBatchesDirty(true)
 {
 }
 
@@ -43,6 +43,12 @@ Animation::~Animation()
 {
     _channels.clear();
 
+    for (size_t i = 0, count = _channelBatches.size(); i < count; i++)
+    {
+        SAFE_DELETE(_channelBatches[i]);
+    }
+    _channelBatches.clear();
+
     if (_defaultClip)
     {
         if (_defaultClip->isClipStateBitSet(AnimationClip::CLIP_IS_PLAYING_BIT))
@@ -403,6 +409,7 @@ void Animation::addChannel(Channel* channel)
 {
     GP_ASSERT(channel);
     _channels.push_back(channel);
+    _channelBatchesDirty = true;
 
     if (channel->_duration > _duration)
         _duration = channel->_duration;
@@ -417,6 +424,7 @@ void Animation::removeChannel(Channel* channel)
         if (channel == chan)
         {
             _channels.erase(itr);
+            _channelBatchesDirty = true;
             return;
         }
         else
@@ -426,6 +434,178 @@ void Animation::removeChannel(Channel* channel)
     }
 }
 
+void Animation::createChannelBatches()
+{
+    for (size_t i = 0, count = _channelBatches.size(); i < count; i++)
+    {
+        SAFE_DELETE(_channelBatches[i]);
+    }
+    _channelBatches.clear();
+    _unbatchedChannels.clear();
+
+    for (unsigned int i = 0, channelCount = (unsigned int)_channels.size(); i < channelCount; i++)
+    {
+        const Curve* curve = _channels[i]->getCurve();
+        GP_ASSERT(curve);
+
+        bool linear = curve->_pointCount > 1;
+        for (unsigned int j = 0; linear && j < curve->_pointCount; j++)
+        {
+            linear = curve->_points[j].type == Curve::LINEAR;
+        }
+        if (!linear)
+        {
+            _unbatchedChannels.push_back(i);
+            continue;
+        }
+
+        // Find a batch with the same key times.
+        ChannelBatch* batch = NULL;
+        for (size_t j = 0, batchCount = _channelBatches.size(); j < batchCount && !batch; j++)
+        {
+            ChannelBatch* b = _channelBatches[j];
+            if (b->keyTimes.size() != curve->_pointCount)
+                continue;
+            unsigned int k = 0;
+            while (k < curve->_pointCount && b->keyTimes[k] == curve->_points[k].time)
+                k++;
+            if (k == curve->_pointCount)
+                batch = b;
+        }
+        if (!batch)
+        {
+            batch = new ChannelBatch();
+            batch->stride = 0;
+            for (unsigned int k = 0; k < curve->_pointCount; k++)
+                batch->keyTimes.push_back(curve->_points[k].time);
+            _channelBatches.push_back(batch);
+        }
+        batch->channels.push_back(i);
+        batch->offsets.push_back(batch->stride);
+        batch->stride += curve->_componentCount;
+    }
+
+    // Interleave the key values of the channels of each batch.
+    for (size_t i = 0, batchCount = _channelBatches.size(); i < batchCount; i++)
+    {
+        ChannelBatch* batch = _channelBatches[i];
+        const unsigned int keyCount = (unsigned int)batch->keyTimes.size();
+        batch->keyValues.resize(keyCount * batch->stride);
+        for (size_t j = 0, count = batch->channels.size(); j < count; j++)
+        {
+            const Curve* curve = _channels[batch->channels[j]]->getCurve();
+            for (unsigned int k = 0; k < keyCount; k++)
+            {
+                memcpy(&batch->keyValues[k * batch->stride + batch->offsets[j]], curve->_points[k].value, curve->_componentSize);
+            }
+        }
+    }
+
+    _channelBatchesDirty = false;
+}
+
+void Animation::evaluate(float time, float startTime, float endTime, float loopBlendTime, Curve::Cursor* cursors, AnimationValue* const* values)
+{
+    GP_ASSERT(cursors);
+    GP_ASSERT(values);
+
+    if (_channelBatchesDirty)
+        createChannelBatches();
+
+    for (size_t i = 0, count = _unbatchedChannels.size(); i < count; i++)
+    {
+        const unsigned int channel = _unbatchedChannels[i];
+        GP_ASSERT(values[channel]);
+        _channels[channel]->getCurve()->evaluate(time, startTime, endTime, loopBlendTime, values[channel]->_value, &cursors[channel]);
+    }
+
+    // Same time mapping as Curve::evaluate() for linear curves. The cursor of the first
+    // channel of a batch holds the keyframe search state of the whole batch.
+    for (size_t i = 0, batchCount = _channelBatches.size(); i < batchCount; i++)
+    {
+        ChannelBatch* batch = _channelBatches[i];
+        const unsigned int channelCount = (unsigned int)batch->channels.size();
+        const float* keyTimes = &batch->keyTimes[0];
+        Curve::Cursor* cursor = &cursors[batch->channels[0]];
+        const Curve* firstCurve = _channels[batch->channels[0]]->getCurve();
+
+        unsigned int min = 0;
+        unsigned int max = (unsigned int)batch->keyTimes.size() - 1;
+        float localTime = time;
+        if (startTime > 0.0f || endTime < 1.0f)
+        {
+            firstCurve->determineRange(startTime, endTime, &min, &max, cursor);
+            localTime = keyTimes[min] + (keyTimes[max] - keyTimes[min]) * time;
+        }
+
+        if (loopBlendTime == 0.0f)
+        {
+            if (localTime < keyTimes[min])
+                localTime = keyTimes[min];
+            else if (localTime > keyTimes[max])
+                localTime = keyTimes[max];
+        }
+
+        unsigned int from;
+        unsigned int to;
+        float t;
+        if (localTime == keyTimes[min] || localTime == keyTimes[max])
+        {
+            from = to = localTime == keyTimes[min] ? min : max;
+            t = 0.0f;
+        }
+        else if (localTime > keyTimes[max])
+        {
+            // Looping forward
+            from = max;
+            to = min;
+            t = (localTime - keyTimes[max]) / loopBlendTime;
+        }
+        else if (localTime < keyTimes[min])
+        {
+            // Looping in reverse
+            from = min;
+            to = max;
+            t = (keyTimes[min] - localTime) / loopBlendTime;
+        }
+        else
+        {
+            from = firstCurve->determineIndex(localTime, min, max, cursor->_index);
+            cursor->_index = from;
+            to = from == max ? from : from + 1;
+            t = (localTime - keyTimes[from]) / (keyTimes[to] - keyTimes[from]);
+        }
+
+        float* fromValues = &batch->keyValues[from * batch->stride];
+        float* toValues = &batch->keyValues[to * batch->stride];
+        for (unsigned int j = 0; j < channelCount; j++)
+        {
+            const unsigned int channel = batch->channels[j];
+            const Curve* curve = _channels[channel]->getCurve();
+            float* a = fromValues + batch->offsets[j];
+            float* b = toValues + batch->offsets[j];
+            GP_ASSERT(values[channel]);
+            float* dst = values[channel]->_value;
+
+            if (from == to)
+            {
+                memcpy(dst, a, curve->_componentSize);
+                continue;
+            }
+
+            for (unsigned int k = 0; k < curve->_componentCount; k++)
+            {
+                dst[k] = a[k] + (b[k] - a[k]) * t;
+            }
+            if (curve->_quaternionOffset)
+            {
+                const unsigned int q = *curve->_quaternionOffset;
+                curve->interpolateQuaternion(t, a + q, b + q, dst + q);
+            }
+        }
+    }
+}
+
 void Animation::setTransformRotationOffset(Curve* curve, unsigned int propertyId)
 {
     GP_ASSERT(curve);
@@ -11,6 +11,7 @@ namespace gameplay
 class AnimationTarget;
 class AnimationController;
 class AnimationClip;
+class AnimationValue;
 
 /**
  * Defines a generic property animation.
@@ -142,6 +143,20 @@ private:
         unsigned long _duration;              // The length of the animation (in milliseconds).
     };
 
+    /**
+     * Keyframes of linear channels that share the same key times. The values of all the
+     * channels of a batch are interleaved per key, so a single keyframe search serves
+     * all of them and they are interpolated in one pass.
+     */
+    struct ChannelBatch
+    {
+        std::vector<float> keyTimes;                // Key times shared by the channels.
+        std::vector<float> keyValues;               // For each key, the values of all the channels.
+        unsigned int stride;                        // Number of floats per key.
+        std::vector<unsigned int> channels;         // Indices of the channels in the batch.
+        std::vector<unsigned int> offsets;          // Offset of the values of each channel in a key.
+    };
+
     /**
      * Hidden copy constructor.
      */
@@ -212,6 +227,25 @@ private:
      */
     void removeChannel(Channel* channel);
 
+    /**
+     * Groups the linear channels with identical key times into batches.
+     */
+    void createChannelBatches();
+
+    /**
+     * Evaluates all the channels of this animation at the given position.
+     *
+     * Batched channels are evaluated together, the other channels through their curves.
+     *
+     * @param time The position within the subregion of the curves to evaluate.
+     * @param startTime Start time of the subregion (between 0.0 - 1.0).
+     * @param endTime End time of the subregion (between 0.0 - 1.0).
+     * @param loopBlendTime Time to blend between the end points of the subregion, relative to the curve length.
+     * @param cursors The keyframe search state of the caller, one per channel.
+     * @param values The evaluated values, one per channel.
+     */
+    void evaluate(float time, float startTime, float endTime, float loopBlendTime, Curve::Cursor* cursors, AnimationValue* const* values);
+
     /**
      * Sets the rotation offset in a Curve representing a Transform's animation data.
      */
@@ -233,6 +267,9 @@ private:
     std::vector<Channel*> _channels;        // The channels within this Animation.
     AnimationClip* _defaultClip;            // The Animation's default clip.
     std::vector<AnimationClip*>* _clips;    // All the clips created from this Animation.
+    std::vector<ChannelBatch*> _channelBatches;     // Batches of the linear channels.
+    std::vector<unsigned int> _unbatchedChannels;   // Channels evaluated through their curves.
+    bool _channelBatchesDirty;              // Whether the batches must be rebuilt.
 
 };
 
@@ -15,6 +15,10 @@
 #include "Game.h"
 #include "Quaternion.h"
 #include "ScriptController.h"
+#include "BlockPool.h"
+
+// Number of clips or listener events allocated at once by the pools.
+#define ANIMATION_CLIP_POOL_CHUNK_SIZE 64
 
 namespace gameplay
 {
@@ -24,7 +28,7 @@ extern void splitURL(const std::string& url, std::string* file, std::string* id)
 AnimationClip::AnimationClip(const char* id, Animation* animation, unsigned long startTime, unsigned long endTime)
     : _id(id), _animation(animation), _startTime(startTime), _endTime(endTime), _duration(_endTime - _startTime), 
       _stateBits(0x00), _repeatCount(1.0f), _loopBlendTime(0), _activeDuration(_duration * _repeatCount), _speed(1.0f), _timeStarted(0), 
-      _elapsedTime(0), _crossFadeToClip(NULL), _crossFadeOutElapsed(0), _crossFadeOutDuration(0), _blendWeight(1.0f),
+      _elapsedTime(0), _percentComplete(0), _crossFadeToClip(NULL), _crossFadeOutElapsed(0), _crossFadeOutDuration(0), _blendWeight(1.0f),
       _beginListeners(NULL), _endListeners(NULL), _listeners(NULL), _listenerItr(NULL)
 {
     GP_REGISTER_SCRIPT_EVENTS();
@@ -38,6 +42,7 @@ AnimationClip::AnimationClip(const char* id, Animation* animation, unsigned long
         GP_ASSERT(_animation->_channels[i]->getCurve());
         _values.push_back(new AnimationValue(_animation->_channels[i]->getCurve()->getComponentCount()));
     }
+    _cursors.resize(_values.size());
 }
 
 AnimationClip::~AnimationClip()
@@ -78,6 +83,41 @@ AnimationClip::ListenerEvent::~ListenerEvent()
 {
 }
 
+#ifndef GP_USE_MEM_LEAK_DETECTION
+// Clips and listener events are created and destroyed in large numbers by cutscenes, so they come from pools.
+static BlockPool& getListenerEventPool(size_t size)
+{
+    static BlockPool pool(size, ANIMATION_CLIP_POOL_CHUNK_SIZE);
+    return pool;
+}
+
+static BlockPool& getClipPool(size_t size)
+{
+    static BlockPool pool(size, ANIMATION_CLIP_POOL_CHUNK_SIZE);
+    return pool;
+}
+
+void* AnimationClip::ListenerEvent::operator new(size_t size)
+{
+    return getListenerEventPool(sizeof(ListenerEvent)).allocate(size);
+}
+
+void AnimationClip::ListenerEvent::operator delete(void* p, size_t size)
+{
+    getListenerEventPool(sizeof(ListenerEvent)).deallocate(p, size);
+}
+
+void* AnimationClip::operator new(size_t size)
+{
+    return getClipPool(sizeof(AnimationClip)).allocate(size);
+}
+
+void AnimationClip::operator delete(void* p, size_t size)
+{
+    getClipPool(sizeof(AnimationClip)).deallocate(p, size);
+}
+#endif
+
 const char* AnimationClip::getTypeName() const
 {
     return "AnimationClip";
@@ -414,8 +454,11 @@ void AnimationClip::removeEndListener(AnimationClip::Listener* listener)
     }
 }
 
-bool AnimationClip::update(float elapsedTime)
+bool AnimationClip::advance(float elapsedTime, bool* finished)
 {
+    GP_ASSERT(finished);
+    *finished = false;
+
     if (isClipStateBitSet(CLIP_IS_PAUSED_BIT))
     {
         return false;
@@ -424,10 +467,11 @@ bool AnimationClip::update(float elapsedTime)
     if (isClipStateBitSet(CLIP_IS_MARKED_FOR_REMOVAL_BIT))
     {
         // If the marked for removal bit is set, it means stop() was called on the AnimationClip at some point
-        // after the last update call. Reset the flag, and return true so the AnimationClip is removed from the 
-        // running clips on the AnimationController.
+        // after the last update call. Reset the flag, and report the AnimationClip as finished so it is removed
+        // from the running clips on the AnimationController.
         onEnd();
-        return true;
+        *finished = true;
+        return false;
     }
 
     if (!isClipStateBitSet(CLIP_IS_STARTED_BIT))
@@ -568,31 +612,47 @@ bool AnimationClip::update(float elapsedTime)
         }
     }
     
-    // Evaluate this clip.
-    Animation::Channel* channel = NULL;
-    AnimationValue* value = NULL;
-    AnimationTarget* target = NULL;
-    size_t channelCount = _animation->_channels.size();
+    _percentComplete = percentComplete;
+
+    // The channel batches are shared by all the clips of the animation, so they are built
+    // here rather than while clips are evaluated on several threads.
+    if (_animation->_channelBatchesDirty)
+        _animation->createChannelBatches();
+
+    return true;
+}
+
+void AnimationClip::evaluate()
+{
+    GP_ASSERT(_animation);
+
     float percentageStart = (float)_startTime / (float)_animation->_duration;
     float percentageEnd = (float)_endTime / (float)_animation->_duration;
     float percentageBlend = (float)_loopBlendTime / (float)_animation->_duration;
-    for (size_t i = 0; i < channelCount; i++)
+    if (!_values.empty())
+        _animation->evaluate(_percentComplete, percentageStart, percentageEnd, percentageBlend, &_cursors[0], &_values[0]);
+}
+
+void AnimationClip::apply()
+{
+    GP_ASSERT(_animation);
+
+    // Set the animation values on the target properties.
+    Animation::Channel* channel = NULL;
+    AnimationTarget* target = NULL;
+    for (size_t i = 0, channelCount = _animation->_channels.size(); i < channelCount; i++)
     {
         channel = _animation->_channels[i];
         GP_ASSERT(channel);
         target = channel->_target;
         GP_ASSERT(target);
-        value = _values[i];
-        GP_ASSERT(value);
-
-        // Evaluate the point on Curve
-        GP_ASSERT(channel->getCurve());
-        channel->getCurve()->evaluate(percentComplete, percentageStart, percentageEnd, percentageBlend, value->_value);
-
-        // Set the animation value on the target property.
-        target->setAnimationPropertyValue(channel->_propertyId, value, _blendWeight);
+        GP_ASSERT(_values[i]);
+        target->setAnimationPropertyValue(channel->_propertyId, _values[i], _blendWeight);
     }
+}
 
+bool AnimationClip::finish()
+{
     // When ended. Probably should move to it's own method so we can call it when the clip is ended early.
     if (isClipStateBitSet(CLIP_IS_MARKED_FOR_REMOVAL_BIT) || !isClipStateBitSet(CLIP_IS_STARTED_BIT))
     {
@@ -703,6 +763,7 @@ AnimationClip* AnimationClip::clone(Animation* animation) const
             *newClip->_values[i] = *_values[i];
         }
     }
+    newClip->_cursors.resize(size);
     return newClip;
 }
 
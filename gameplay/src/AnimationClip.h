@@ -336,6 +336,18 @@ private:
          */
         ListenerEvent& operator=(const ListenerEvent&);
 
+#ifndef GP_USE_MEM_LEAK_DETECTION
+        /**
+         * Allocates listener events from a pool.
+         */
+        static void* operator new(size_t size);
+
+        /**
+         * Returns listener events to the pool.
+         */
+        static void operator delete(void* p, size_t size);
+#endif
+
         Listener* _listener;        // This listener to call back when this event is triggered.
         unsigned long _eventTime;   // The time at which the listener will be called back at during the playback of the AnimationClip.
     };
@@ -365,10 +377,49 @@ private:
      */
     AnimationClip& operator=(const AnimationClip&);
 
+#ifndef GP_USE_MEM_LEAK_DETECTION
+    /**
+     * Allocates clips from a pool.
+     */
+    static void* operator new(size_t size);
+
+    /**
+     * Returns clips to the pool.
+     */
+    static void operator delete(void* p, size_t size);
+#endif
+
     /**
-     * Updates the animation with the elapsed time.
+     * Advances the clip time, notifies the listeners and computes the cross fade blend weights.
+     *
+     * This is the first step of the update of a clip by the AnimationController, followed by
+     * evaluate(), apply() and finish().
+     *
+     * @param elapsedTime The elapsed time.
+     * @param finished Set to true if the clip must be removed from the running clips.
+     *
+     * @return true if the clip must be evaluated, false if it is paused or was removed.
+     */
+    bool advance(float elapsedTime, bool* finished);
+
+    /**
+     * Evaluates the channels of the animation at the position computed by advance().
+     *
+     * Only the values owned by the clip are written, so clips can be evaluated on several threads.
+     */
+    void evaluate();
+
+    /**
+     * Sets the evaluated values on the animation targets, weighted by the blend weight.
+     */
+    void apply();
+
+    /**
+     * Ends the clip if it stopped during the last advance().
+     *
+     * @return true if the clip must be removed from the running clips.
      */
-    bool update(float elapsedTime);
+    bool finish();
 
     /**
      * Handles when the AnimationClip begins.
@@ -416,11 +467,13 @@ private:
     float _speed;                                       // The speed that the clip is playing. Default is 1.0. Negative goes in reverse.
     double _timeStarted;                                // The game time when this clip was actually started.
     float _elapsedTime;                                 // Time elapsed while the clip is running.
+    float _percentComplete;                             // Position within the animation computed by the last advance().
     AnimationClip* _crossFadeToClip;                    // The clip to cross fade to.
     float _crossFadeOutElapsed;                         // The amount of time that has elapsed for the crossfade.
     unsigned long _crossFadeOutDuration;                // The duration of the cross fade.
     float _blendWeight;                                 // The clip's blendweight.
     std::vector<AnimationValue*> _values;               // AnimationValue holder.
+    std::vector<Curve::Cursor> _cursors;                // Keyframe search state of each channel.
     std::vector<Listener*>* _beginListeners;            // Collection of begin listeners on the clip.
     std::vector<Listener*>* _endListeners;              // Collection of end listeners on the clip.
     std::list<ListenerEvent*>* _listeners;              // Ordered collection of listeners on the clip.
@@ -3,11 +3,14 @@
 #include "Game.h"
 #include "Curve.h"
 
+// Number of clips evaluated by a single job.
+#define ANIMATION_CLIPS_PER_JOB 8
+
 namespace gameplay
 {
 
 AnimationController::AnimationController()
-    : _state(STOPPED)
+    : _state(STOPPED), _updating(false)
 {
 }
 
@@ -17,13 +20,11 @@ AnimationController::~AnimationController()
 
 void AnimationController::stopAllAnimations() 
 {
-    std::list<AnimationClip*>::iterator clipIter = _runningClips.begin();
-    while (clipIter != _runningClips.end())
+    for (size_t i = 0, count = _runningClips.size(); i < count; i++)
     {
-        AnimationClip* clip = *clipIter;
-        GP_ASSERT(clip);
-        clip->stop();
-        clipIter++;
+        AnimationClip* clip = _runningClips[i];
+        if (clip)
+            clip->stop();
     }
 }
 
@@ -39,10 +40,9 @@ void AnimationController::initialize()
 
 void AnimationController::finalize()
 {
-    std::list<AnimationClip*>::iterator itr = _runningClips.begin();
-    for ( ; itr != _runningClips.end(); itr++)
+    for (size_t i = 0, count = _runningClips.size(); i < count; i++)
     {
-        AnimationClip* clip = *itr;
+        AnimationClip* clip = _runningClips[i];
         SAFE_RELEASE(clip);
     }
     _runningClips.clear();
@@ -76,56 +76,118 @@ void AnimationController::schedule(AnimationClip* clip)
 
 void AnimationController::unschedule(AnimationClip* clip)
 {
-    std::list<AnimationClip*>::iterator clipItr = _runningClips.begin();
-    while (clipItr != _runningClips.end())
+    for (size_t i = 0, count = _runningClips.size(); i < count; i++)
     {
-        AnimationClip* rClip = (*clipItr);
-        if (rClip == clip)
+        if (_runningClips[i] == clip)
         {
-            _runningClips.erase(clipItr);
-            SAFE_RELEASE(clip);
+            removeRunningClip(i);
             break;
         }
-        clipItr++;
     }
 
     if (_runningClips.empty())
         _state = IDLE;
 }
 
+void AnimationController::removeRunningClip(size_t index)
+{
+    GP_ASSERT(index < _runningClips.size());
+
+    AnimationClip* clip = _runningClips[index];
+    if (_updating)
+    {
+        _runningClips[index] = NULL;
+    }
+    else
+    {
+        _runningClips[index] = _runningClips.back();
+        _runningClips.pop_back();
+    }
+    SAFE_RELEASE(clip);
+}
+
 void AnimationController::update(float elapsedTime)
 {
     if (_state != RUNNING)
         return;
-    
+
     Transform::suspendTransformChanged();
+    _updating = true;
 
-    // Loop through running clips and call update() on them.
-    std::list<AnimationClip*>::iterator clipIter = _runningClips.begin();
-    while (clipIter != _runningClips.end())
+    // Advance the clips. This notifies listeners and scripts and cross fades update other
+    // clips, so it is done in order on this thread. Clips scheduled by the listeners are
+    // appended to the array and advanced in the same pass.
+    _evaluatedClips.clear();
+    for (size_t i = 0; i < _runningClips.size(); i++)
     {
-        AnimationClip* clip = (*clipIter);
-        GP_ASSERT(clip);
-        clip->addRef();
+        AnimationClip* clip = _runningClips[i];
+        if (!clip)
+            continue;
+
         if (clip->isClipStateBitSet(AnimationClip::CLIP_IS_RESTARTED_BIT))
-        {   // If the CLIP_IS_RESTARTED_BIT is set, we should end the clip and 
-            // move it from where it is in the running clips list to the back.
+        {
+            // If the CLIP_IS_RESTARTED_BIT is set, we should end the clip and start it again.
             clip->onEnd();
             clip->setClipStateBit(AnimationClip::CLIP_IS_PLAYING_BIT);
-            _runningClips.push_back(clip);
-            clipIter = _runningClips.erase(clipIter);
         }
-        else if (clip->update(elapsedTime))
+
+        bool finished = false;
+        if (clip->advance(elapsedTime, &finished))
         {
-            clip->release();
-            clipIter = _runningClips.erase(clipIter);
+            // Keep the clip alive until it is applied, even if a listener unschedules it.
+            clip->addRef();
+            _evaluatedClips.push_back(std::make_pair(clip, i));
         }
-        else
+        else if (finished && _runningClips[i] == clip)
         {
-            clipIter++;
+            removeRunningClip(i);
         }
+    }
+
+    // Evaluate the curves of the clips in parallel, each clip only writes its own values.
+    JobScheduler* scheduler = Game::getInstance()->getJobScheduler();
+    const unsigned int evaluatedCount = (unsigned int)_evaluatedClips.size();
+    if (scheduler)
+    {
+        scheduler->parallelFor(evaluatedCount, [this](unsigned int begin, unsigned int end)
+        {
+            for (unsigned int i = begin; i < end; i++)
+                _evaluatedClips[i].first->evaluate();
+        }, ANIMATION_CLIPS_PER_JOB);
+    }
+    else
+    {
+        for (unsigned int i = 0; i < evaluatedCount; i++)
+            _evaluatedClips[i].first->evaluate();
+    }
+
+    // Apply the values in the order of the running clips, so clips blending into the same
+    // target property always combine the same way.
+    for (unsigned int i = 0; i < evaluatedCount; i++)
+    {
+        _evaluatedClips[i].first->apply();
+    }
+
+    for (unsigned int i = 0; i < evaluatedCount; i++)
+    {
+        AnimationClip* clip = _evaluatedClips[i].first;
+        const size_t index = _evaluatedClips[i].second;
+        if (clip->finish() && _runningClips[index] == clip)
+            removeRunningClip(index);
         clip->release();
     }
+    _evaluatedClips.clear();
+
+    // Compact the slots of the removed clips.
+    _updating = false;
+    for (size_t i = _runningClips.size(); i-- > 0; )
+    {
+        if (_runningClips[i] == NULL)
+        {
+            _runningClips[i] = _runningClips.back();
+            _runningClips.pop_back();
+        }
+    }
 
     Transform::resumeTransformChanged();
 
@@ -95,9 +95,19 @@ private:
      * Callback for when the controller receives a frame update event.
      */
     void update(float elapsedTime);
-    
+
+    /**
+     * Removes the running clip at the given index.
+     *
+     * The last clip is moved into its slot, unless an update is in progress, in which case
+     * the slot is cleared and the array is compacted at the end of the update.
+     */
+    void removeRunningClip(size_t index);
+
     State _state;                                 // The current state of the AnimationController.
-    std::list<AnimationClip*> _runningClips;      // A list of running AnimationClips.
+    std::vector<AnimationClip*> _runningClips;    // The running AnimationClips. Slots are NULL while an update removes clips.
+    std::vector<std::pair<AnimationClip*, size_t> > _evaluatedClips;  // Clips evaluated by the current update, with their slot.
+    bool _updating;                               // Whether update() is in progress.
 };
 
 }
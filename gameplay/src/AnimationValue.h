@@ -12,6 +12,7 @@ namespace gameplay
 class AnimationValue
 {
     friend class AnimationClip;
+    friend class Animation;
 
 public:
 
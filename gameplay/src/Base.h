@@ -42,6 +42,7 @@
 #include <typeinfo>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <chrono>
 #include "Logger.h"
 
@@ -195,6 +196,19 @@ extern int strcmpnocase(const char* s1, const char* s2);
 #define M_1_PI                      0.31830988618379067154
 #endif
 
+// SIMD
+// GP_SIMD_SSE is defined on x86 targets with SSE2 and GP_SIMD_NEON on ARM targets with NEON.
+// Define GP_NO_SIMD to build the scalar code paths only.
+#ifndef GP_NO_SIMD
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define GP_SIMD_SSE
+        #include <emmintrin.h>
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define GP_SIMD_NEON
+        #include <arm_neon.h>
+    #endif
+#endif
+
 // NOMINMAX makes sure that windef.h doesn't add macros min and max
 #ifdef WIN32
     #define NOMINMAX
@@ -234,6 +248,8 @@ using std::va_list;
 #define WINDOW_VSYNC        1
 
 // Graphics (OpenGL)
+// GP_LOAD_GL_EXTENSIONS is defined where the extension entry points are pointers loaded at runtime,
+// which are NULL when the driver does not have the extension.
 #ifdef __ANDROID__
     #include <EGL/egl.h>
     #include <GLES2/gl2.h>
@@ -244,19 +260,38 @@ using std::va_list;
     extern PFNGLISVERTEXARRAYOESPROC glIsVertexArray;
     extern PFNGLMAPBUFFEROESPROC glMapBuffer;
     extern PFNGLUNMAPBUFFEROESPROC glUnmapBuffer;
+    extern PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinary;
+    extern PFNGLPROGRAMBINARYOESPROC glProgramBinary;
     #define GL_WRITE_ONLY GL_WRITE_ONLY_OES
     #define GL_DEPTH24_STENCIL8 GL_DEPTH24_STENCIL8_OES
+    #define GL_PROGRAM_BINARY_LENGTH GL_PROGRAM_BINARY_LENGTH_OES
+    #define GL_NUM_PROGRAM_BINARY_FORMATS GL_NUM_PROGRAM_BINARY_FORMATS_OES
     #define glClearDepth glClearDepthf
     #define OPENGL_ES
+    #define GP_USE_MAP_BUFFER
+    #define GP_USE_PROGRAM_BINARY
+    #define GP_LOAD_GL_EXTENSIONS
 #elif WIN32
         #define WIN32_LEAN_AND_MEAN
         #define GLEW_STATIC
         #include <GL/glew.h>
         #define GP_USE_VAO
+        #define GP_USE_INSTANCING
+        #define GP_USE_MAP_BUFFER
+        #define GP_USE_PROGRAM_BINARY
+        #define GP_LOAD_GL_EXTENSIONS
 #elif __linux__
         #define GLEW_STATIC
         #include <GL/glew.h>
         #define GP_USE_VAO
+        #define GP_USE_INSTANCING
+        #define GP_USE_MAP_BUFFER
+        #ifdef GP_NULL_GL
+            #include "NullGL.h"
+        #else
+            #define GP_USE_PROGRAM_BINARY
+            #define GP_LOAD_GL_EXTENSIONS
+        #endif
 #elif __APPLE__
     #include "TargetConditionals.h"
     #if TARGET_OS_IPHONE || TARGET_IPHONE_SIMULATOR
@@ -273,6 +308,7 @@ using std::va_list;
         #define glClearDepth glClearDepthf
         #define OPENGL_ES
         #define GP_USE_VAO
+        #define GP_USE_MAP_BUFFER
     #elif TARGET_OS_MAC
         #include <OpenGL/gl.h>
         #include <OpenGL/glext.h>
@@ -281,6 +317,7 @@ using std::va_list;
         #define glGenVertexArrays glGenVertexArraysAPPLE
         #define glIsVertexArray glIsVertexArrayAPPLE
         #define GP_USE_VAO
+        #define GP_USE_MAP_BUFFER
     #else
         #error "Unsupported Apple Device"
     #endif
@@ -307,6 +344,8 @@ using std::va_list;
 #define VERTEX_ATTRIBUTE_BLENDWEIGHTS_NAME          "a_blendWeights"
 #define VERTEX_ATTRIBUTE_BLENDINDICES_NAME          "a_blendIndices"
 #define VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME       "a_texCoord"
+#define VERTEX_ATTRIBUTE_INSTANCE_MATRIX_PREFIX_NAME "a_instanceMatrix"
+#define VERTEX_ATTRIBUTE_INSTANCE_DATA_NAME         "a_instanceData"
 
 // Hardware buffer
 namespace gameplay
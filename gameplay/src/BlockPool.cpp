@@ -0,0 +1,64 @@
+#include "Base.h"
+#include "BlockPool.h"
+
+namespace gameplay
+{
+
+BlockPool::BlockPool(size_t blockSize, size_t blocksPerChunk)
+    : _blockSize(blockSize), _blocksPerChunk(blocksPerChunk), _freeList(NULL)
+{
+    // Blocks hold the free list link and keep the alignment of any object.
+    const size_t alignment = sizeof(double) > sizeof(void*) ? sizeof(double) : sizeof(void*);
+    _blockSize = (std::max(_blockSize, sizeof(void*)) + alignment - 1) & ~(alignment - 1);
+    GP_ASSERT(_blocksPerChunk > 0);
+}
+
+BlockPool::~BlockPool()
+{
+    for (size_t i = 0, count = _chunks.size(); i < count; ++i)
+    {
+        SAFE_DELETE_ARRAY(_chunks[i]);
+    }
+    _chunks.clear();
+}
+
+void* BlockPool::allocate(size_t size)
+{
+    if (size > _blockSize)
+        return ::operator new(size);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_freeList == NULL)
+    {
+        char* chunk = new char[_blockSize * _blocksPerChunk];
+        _chunks.push_back(chunk);
+        for (size_t i = 0; i < _blocksPerChunk; ++i)
+        {
+            void* block = chunk + i * _blockSize;
+            *(void**)block = _freeList;
+            _freeList = block;
+        }
+    }
+
+    void* block = _freeList;
+    _freeList = *(void**)block;
+    return block;
+}
+
+void BlockPool::deallocate(void* p, size_t size)
+{
+    if (p == NULL)
+        return;
+
+    if (size > _blockSize)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    *(void**)p = _freeList;
+    _freeList = p;
+}
+
+}
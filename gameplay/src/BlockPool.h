@@ -0,0 +1,76 @@
+#ifndef BLOCKPOOL_H_
+#define BLOCKPOOL_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines an allocator of fixed size memory blocks.
+ *
+ * Blocks are carved out of larger chunks and recycled through a free list, so objects that
+ * are created and destroyed often do not go through the system allocator each time. Chunks
+ * are only returned to the system when the pool is destroyed.
+ *
+ * The pool is used as the class allocator of small engine objects. It is thread safe.
+ *
+ * @script{ignore}
+ */
+class BlockPool
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param blockSize The size of the blocks in bytes.
+     * @param blocksPerChunk The number of blocks allocated at once when the pool is empty.
+     */
+    BlockPool(size_t blockSize, size_t blocksPerChunk);
+
+    /**
+     * Destructor. Frees all the chunks, the blocks must have been deallocated.
+     */
+    ~BlockPool();
+
+    /**
+     * Allocates a block.
+     *
+     * Requests larger than the block size, such as objects of derived classes, are forwarded
+     * to the global allocator.
+     *
+     * @param size The size requested.
+     *
+     * @return The allocated memory.
+     */
+    void* allocate(size_t size);
+
+    /**
+     * Returns a block to the pool.
+     *
+     * @param p The memory to free, allocated with the same size.
+     * @param size The size it was allocated with.
+     */
+    void deallocate(void* p, size_t size);
+
+private:
+
+    /**
+     * Hidden copy constructor.
+     */
+    BlockPool(const BlockPool& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    BlockPool& operator=(const BlockPool&);
+
+    size_t _blockSize;
+    size_t _blocksPerChunk;
+    void* _freeList;                    // Free blocks, each one stores the next one in its first bytes.
+    std::vector<char*> _chunks;
+    std::mutex _mutex;
+};
+
+}
+
+#endif
@@ -0,0 +1,593 @@
+#include "Base.h"
+#include "BoundingVolumeHierarchy.h"
+
+// Margin the boxes of the leaves are grown by, relative to the radius of their sphere, and at least.
+#define BVH_LEAF_MARGIN 0.2f
+#define BVH_MIN_LEAF_MARGIN 0.05f
+
+#define BVH_NULL_NODE -1
+
+namespace gameplay
+{
+
+enum FrustumIntersection
+{
+    FRUSTUM_OUTSIDE,
+    FRUSTUM_INTERSECTING,
+    FRUSTUM_INSIDE
+};
+
+/**
+ * The six planes of a frustum, as structure of arrays padded to eight planes that contain everything.
+ */
+struct FrustumPlanes
+{
+    float x[8];
+    float y[8];
+    float z[8];
+    float d[8];
+    float absX[8];
+    float absY[8];
+    float absZ[8];
+
+    FrustumPlanes(const Frustum& frustum)
+    {
+        const Plane* planes[6] = { &frustum.getNear(), &frustum.getFar(), &frustum.getLeft(), &frustum.getRight(), &frustum.getBottom(), &frustum.getTop() };
+        for (unsigned int i = 0; i < 8; ++i)
+        {
+            if (i < 6)
+            {
+                const Vector3& normal = planes[i]->getNormal();
+                x[i] = normal.x;
+                y[i] = normal.y;
+                z[i] = normal.z;
+                d[i] = planes[i]->getDistance();
+            }
+            else
+            {
+                x[i] = y[i] = z[i] = 0.0f;
+                d[i] = FLT_MAX;
+            }
+            absX[i] = fabsf(x[i]);
+            absY[i] = fabsf(y[i]);
+            absZ[i] = fabsf(z[i]);
+        }
+    }
+};
+
+#if defined(GP_SIMD_SSE)
+
+static FrustumIntersection intersectBox(const FrustumPlanes& planes, const BoundingBox& box)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 cx = _mm_set1_ps((box.min.x + box.max.x) * 0.5f);
+    const __m128 cy = _mm_set1_ps((box.min.y + box.max.y) * 0.5f);
+    const __m128 cz = _mm_set1_ps((box.min.z + box.max.z) * 0.5f);
+    const __m128 ex = _mm_mul_ps(_mm_set1_ps(box.max.x - box.min.x), half);
+    const __m128 ey = _mm_mul_ps(_mm_set1_ps(box.max.y - box.min.y), half);
+    const __m128 ez = _mm_mul_ps(_mm_set1_ps(box.max.z - box.min.z), half);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 outside = zero;
+    __m128 intersecting = zero;
+    for (unsigned int i = 0; i < 8; i += 4)
+    {
+        // Signed distance of the center of the box and projected radius of the box, per plane.
+        __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(planes.x + i), cx), _mm_loadu_ps(planes.d + i));
+        distance = _mm_add_ps(distance, _mm_mul_ps(_mm_loadu_ps(planes.y + i), cy));
+        distance = _mm_add_ps(distance, _mm_mul_ps(_mm_loadu_ps(planes.z + i), cz));
+        __m128 radius = _mm_mul_ps(_mm_loadu_ps(planes.absX + i), ex);
+        radius = _mm_add_ps(radius, _mm_mul_ps(_mm_loadu_ps(planes.absY + i), ey));
+        radius = _mm_add_ps(radius, _mm_mul_ps(_mm_loadu_ps(planes.absZ + i), ez));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+        intersecting = _mm_or_ps(intersecting, _mm_cmplt_ps(_mm_sub_ps(distance, radius), zero));
+    }
+    if (_mm_movemask_ps(outside))
+        return FRUSTUM_OUTSIDE;
+    return _mm_movemask_ps(intersecting) ? FRUSTUM_INTERSECTING : FRUSTUM_INSIDE;
+}
+
+static bool intersectSphere(const FrustumPlanes& planes, const BoundingSphere& sphere)
+{
+    const __m128 cx = _mm_set1_ps(sphere.center.x);
+    const __m128 cy = _mm_set1_ps(sphere.center.y);
+    const __m128 cz = _mm_set1_ps(sphere.center.z);
+    const __m128 radius = _mm_set1_ps(sphere.radius);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 outside = zero;
+    for (unsigned int i = 0; i < 8; i += 4)
+    {
+        __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(planes.x + i), cx), _mm_loadu_ps(planes.d + i));
+        distance = _mm_add_ps(distance, _mm_mul_ps(_mm_loadu_ps(planes.y + i), cy));
+        distance = _mm_add_ps(distance, _mm_mul_ps(_mm_loadu_ps(planes.z + i), cz));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+    }
+    return _mm_movemask_ps(outside) == 0;
+}
+
+#elif defined(GP_SIMD_NEON)
+
+static inline bool anyLane(uint32x4_t mask)
+{
+    uint32x2_t lanes = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+    lanes = vpmax_u32(lanes, lanes);
+    return vget_lane_u32(lanes, 0) != 0;
+}
+
+static FrustumIntersection intersectBox(const FrustumPlanes& planes, const BoundingBox& box)
+{
+    const float32x4_t cx = vdupq_n_f32((box.min.x + box.max.x) * 0.5f);
+    const float32x4_t cy = vdupq_n_f32((box.min.y + box.max.y) * 0.5f);
+    const float32x4_t cz = vdupq_n_f32((box.min.z + box.max.z) * 0.5f);
+    const float32x4_t ex = vdupq_n_f32((box.max.x - box.min.x) * 0.5f);
+    const float32x4_t ey = vdupq_n_f32((box.max.y - box.min.y) * 0.5f);
+    const float32x4_t ez = vdupq_n_f32((box.max.z - box.min.z) * 0.5f);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    uint32x4_t outside = vdupq_n_u32(0);
+    uint32x4_t intersecting = vdupq_n_u32(0);
+    for (unsigned int i = 0; i < 8; i += 4)
+    {
+        // Signed distance of the center of the box and projected radius of the box, per plane.
+        float32x4_t distance = vmlaq_f32(vld1q_f32(planes.d + i), vld1q_f32(planes.x + i), cx);
+        distance = vmlaq_f32(distance, vld1q_f32(planes.y + i), cy);
+        distance = vmlaq_f32(distance, vld1q_f32(planes.z + i), cz);
+        float32x4_t radius = vmulq_f32(vld1q_f32(planes.absX + i), ex);
+        radius = vmlaq_f32(radius, vld1q_f32(planes.absY + i), ey);
+        radius = vmlaq_f32(radius, vld1q_f32(planes.absZ + i), ez);
+        outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, radius), zero));
+        intersecting = vorrq_u32(intersecting, vcltq_f32(vsubq_f32(distance, radius), zero));
+    }
+    if (anyLane(outside))
+        return FRUSTUM_OUTSIDE;
+    return anyLane(intersecting) ? FRUSTUM_INTERSECTING : FRUSTUM_INSIDE;
+}
+
+static bool intersectSphere(const FrustumPlanes& planes, const BoundingSphere& sphere)
+{
+    const float32x4_t cx = vdupq_n_f32(sphere.center.x);
+    const float32x4_t cy = vdupq_n_f32(sphere.center.y);
+    const float32x4_t cz = vdupq_n_f32(sphere.center.z);
+    const float32x4_t radius = vdupq_n_f32(sphere.radius);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    uint32x4_t outside = vdupq_n_u32(0);
+    for (unsigned int i = 0; i < 8; i += 4)
+    {
+        float32x4_t distance = vmlaq_f32(vld1q_f32(planes.d + i), vld1q_f32(planes.x + i), cx);
+        distance = vmlaq_f32(distance, vld1q_f32(planes.y + i), cy);
+        distance = vmlaq_f32(distance, vld1q_f32(planes.z + i), cz);
+        outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, radius), zero));
+    }
+    return !anyLane(outside);
+}
+
+#else
+
+static FrustumIntersection intersectBox(const FrustumPlanes& planes, const BoundingBox& box)
+{
+    const float cx = (box.min.x + box.max.x) * 0.5f;
+    const float cy = (box.min.y + box.max.y) * 0.5f;
+    const float cz = (box.min.z + box.max.z) * 0.5f;
+    const float ex = (box.max.x - box.min.x) * 0.5f;
+    const float ey = (box.max.y - box.min.y) * 0.5f;
+    const float ez = (box.max.z - box.min.z) * 0.5f;
+    FrustumIntersection result = FRUSTUM_INSIDE;
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        const float distance = planes.x[i] * cx + planes.y[i] * cy + planes.z[i] * cz + planes.d[i];
+        const float radius = planes.absX[i] * ex + planes.absY[i] * ey + planes.absZ[i] * ez;
+        if (distance + radius < 0.0f)
+            return FRUSTUM_OUTSIDE;
+        if (distance - radius < 0.0f)
+            result = FRUSTUM_INTERSECTING;
+    }
+    return result;
+}
+
+static bool intersectSphere(const FrustumPlanes& planes, const BoundingSphere& sphere)
+{
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        const float distance = planes.x[i] * sphere.center.x + planes.y[i] * sphere.center.y + planes.z[i] * sphere.center.z + planes.d[i];
+        if (distance + sphere.radius < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+#endif
+
+static void mergeBoxes(const BoundingBox& a, const BoundingBox& b, BoundingBox* dst)
+{
+    dst->min.set(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z));
+    dst->max.set(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z));
+}
+
+static float getSurfaceArea(const BoundingBox& box)
+{
+    const float dx = box.max.x - box.min.x;
+    const float dy = box.max.y - box.min.y;
+    const float dz = box.max.z - box.min.z;
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+static bool containsBox(const BoundingBox& outer, const BoundingBox& inner)
+{
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+           outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+static void getSphereBox(const BoundingSphere& sphere, float margin, BoundingBox* dst)
+{
+    const float extent = sphere.radius + margin;
+    dst->min.set(sphere.center.x - extent, sphere.center.y - extent, sphere.center.z - extent);
+    dst->max.set(sphere.center.x + extent, sphere.center.y + extent, sphere.center.z + extent);
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+    : _root(BVH_NULL_NODE), _freeList(BVH_NULL_NODE), _objectCount(0)
+{
+}
+
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+{
+}
+
+int BoundingVolumeHierarchy::insert(const BoundingSphere& sphere, void* userData)
+{
+    int leaf = allocateNode();
+    TreeNode& node = _nodes[leaf];
+    node.sphere = sphere;
+    node.userData = userData;
+    getSphereBox(sphere, std::max(sphere.radius * BVH_LEAF_MARGIN, BVH_MIN_LEAF_MARGIN), &node.box);
+    insertLeaf(leaf);
+    ++_objectCount;
+    return leaf;
+}
+
+void BoundingVolumeHierarchy::remove(int proxy)
+{
+    GP_ASSERT(proxy >= 0 && proxy < (int)_nodes.size() && _nodes[proxy].height == 0);
+
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --_objectCount;
+}
+
+bool BoundingVolumeHierarchy::update(int proxy, const BoundingSphere& sphere)
+{
+    GP_ASSERT(proxy >= 0 && proxy < (int)_nodes.size() && _nodes[proxy].height == 0);
+
+    _nodes[proxy].sphere = sphere;
+    BoundingBox box;
+    getSphereBox(sphere, 0.0f, &box);
+    if (containsBox(_nodes[proxy].box, box))
+        return false;
+
+    removeLeaf(proxy);
+    getSphereBox(sphere, std::max(sphere.radius * BVH_LEAF_MARGIN, BVH_MIN_LEAF_MARGIN), &_nodes[proxy].box);
+    insertLeaf(proxy);
+    return true;
+}
+
+void BoundingVolumeHierarchy::clear()
+{
+    _nodes.clear();
+    _root = BVH_NULL_NODE;
+    _freeList = BVH_NULL_NODE;
+    _objectCount = 0;
+}
+
+unsigned int BoundingVolumeHierarchy::getObjectCount() const
+{
+    return _objectCount;
+}
+
+unsigned int BoundingVolumeHierarchy::getHeight() const
+{
+    return _root == BVH_NULL_NODE ? 0 : (unsigned int)_nodes[_root].height + 1;
+}
+
+unsigned int BoundingVolumeHierarchy::query(const Frustum& frustum, std::vector<void*>& objects) const
+{
+    if (_root == BVH_NULL_NODE)
+        return 0;
+
+    const size_t count = objects.size();
+    const FrustumPlanes planes(frustum);
+    _stack.clear();
+    _stack.push_back(_root);
+    while (!_stack.empty())
+    {
+        const int index = _stack.back();
+        _stack.pop_back();
+        const TreeNode& node = _nodes[index];
+        switch (intersectBox(planes, node.box))
+        {
+        case FRUSTUM_OUTSIDE:
+            break;
+        case FRUSTUM_INSIDE:
+            collectLeaves(index, objects);
+            break;
+        case FRUSTUM_INTERSECTING:
+            if (node.height == 0)
+            {
+                if (intersectSphere(planes, node.sphere))
+                    objects.push_back(node.userData);
+            }
+            else
+            {
+                _stack.push_back(node.child1);
+                _stack.push_back(node.child2);
+            }
+            break;
+        }
+    }
+    return (unsigned int)(objects.size() - count);
+}
+
+void BoundingVolumeHierarchy::collectLeaves(int index, std::vector<void*>& objects) const
+{
+    const size_t base = _stack.size();
+    _stack.push_back(index);
+    while (_stack.size() > base)
+    {
+        const TreeNode& node = _nodes[_stack.back()];
+        _stack.pop_back();
+        if (node.height == 0)
+        {
+            objects.push_back(node.userData);
+        }
+        else
+        {
+            _stack.push_back(node.child1);
+            _stack.push_back(node.child2);
+        }
+    }
+}
+
+int BoundingVolumeHierarchy::allocateNode()
+{
+    int index;
+    if (_freeList == BVH_NULL_NODE)
+    {
+        index = (int)_nodes.size();
+        _nodes.push_back(TreeNode());
+    }
+    else
+    {
+        index = _freeList;
+        _freeList = _nodes[index].parent;
+    }
+
+    TreeNode& node = _nodes[index];
+    node.userData = NULL;
+    node.parent = BVH_NULL_NODE;
+    node.child1 = BVH_NULL_NODE;
+    node.child2 = BVH_NULL_NODE;
+    node.height = 0;
+    return index;
+}
+
+void BoundingVolumeHierarchy::freeNode(int index)
+{
+    TreeNode& node = _nodes[index];
+    node.userData = NULL;
+    node.parent = _freeList;
+    node.height = -1;
+    _freeList = index;
+}
+
+void BoundingVolumeHierarchy::insertLeaf(int leaf)
+{
+    if (_root == BVH_NULL_NODE)
+    {
+        _root = leaf;
+        _nodes[leaf].parent = BVH_NULL_NODE;
+        return;
+    }
+
+    // Find the sibling that grows the surface area of the tree the least.
+    const BoundingBox leafBox = _nodes[leaf].box;
+    BoundingBox combined;
+    int index = _root;
+    while (_nodes[index].height > 0)
+    {
+        const TreeNode& node = _nodes[index];
+        mergeBoxes(node.box, leafBox, &combined);
+        const float combinedArea = getSurfaceArea(combined);
+
+        // Cost of making the leaf and this node siblings, and the cost inherited by the children
+        // of this node if the leaf goes further down.
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - getSurfaceArea(node.box));
+
+        float childCosts[2];
+        const int children[2] = { node.child1, node.child2 };
+        for (unsigned int i = 0; i < 2; ++i)
+        {
+            const TreeNode& child = _nodes[children[i]];
+            mergeBoxes(child.box, leafBox, &combined);
+            childCosts[i] = getSurfaceArea(combined) + inheritanceCost;
+            if (child.height > 0)
+            {
+                childCosts[i] -= getSurfaceArea(child.box);
+            }
+        }
+
+        if (cost < childCosts[0] && cost < childCosts[1])
+            break;
+        index = childCosts[0] < childCosts[1] ? children[0] : children[1];
+    }
+
+    // Replace the sibling by a new parent of the sibling and the leaf.
+    const int sibling = index;
+    const int oldParent = _nodes[sibling].parent;
+    const int newParent = allocateNode();
+    TreeNode& parent = _nodes[newParent];
+    parent.parent = oldParent;
+    mergeBoxes(leafBox, _nodes[sibling].box, &parent.box);
+    parent.height = _nodes[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent = newParent;
+    if (oldParent == BVH_NULL_NODE)
+    {
+        _root = newParent;
+    }
+    else if (_nodes[oldParent].child1 == sibling)
+    {
+        _nodes[oldParent].child1 = newParent;
+    }
+    else
+    {
+        _nodes[oldParent].child2 = newParent;
+    }
+
+    refit(oldParent);
+}
+
+void BoundingVolumeHierarchy::removeLeaf(int leaf)
+{
+    if (leaf == _root)
+    {
+        _root = BVH_NULL_NODE;
+        return;
+    }
+
+    // Replace the parent of the leaf by the sibling of the leaf.
+    const int parent = _nodes[leaf].parent;
+    const int grandParent = _nodes[parent].parent;
+    const int sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+    _nodes[sibling].parent = grandParent;
+    if (grandParent == BVH_NULL_NODE)
+    {
+        _root = sibling;
+    }
+    else if (_nodes[grandParent].child1 == parent)
+    {
+        _nodes[grandParent].child1 = sibling;
+    }
+    else
+    {
+        _nodes[grandParent].child2 = sibling;
+    }
+    freeNode(parent);
+    _nodes[leaf].parent = BVH_NULL_NODE;
+
+    refit(grandParent);
+}
+
+void BoundingVolumeHierarchy::refit(int index)
+{
+    while (index != BVH_NULL_NODE)
+    {
+        index = balance(index);
+
+        TreeNode& node = _nodes[index];
+        const TreeNode& child1 = _nodes[node.child1];
+        const TreeNode& child2 = _nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        mergeBoxes(child1.box, child2.box, &node.box);
+
+        index = node.parent;
+    }
+}
+
+int BoundingVolumeHierarchy::balance(int indexA)
+{
+    TreeNode& a = _nodes[indexA];
+    if (a.height < 2)
+        return indexA;
+
+    const int indexB = a.child1;
+    const int indexC = a.child2;
+    TreeNode& b = _nodes[indexB];
+    TreeNode& c = _nodes[indexC];
+    const int difference = c.height - b.height;
+
+    if (difference > 1)
+    {
+        // Rotate C up: A takes the place of C's shorter child, C takes the place of A.
+        const int indexF = c.child1;
+        const int indexG = c.child2;
+        TreeNode& f = _nodes[indexF];
+        TreeNode& g = _nodes[indexG];
+
+        c.child1 = indexA;
+        c.parent = a.parent;
+        a.parent = indexC;
+        if (c.parent == BVH_NULL_NODE)
+            _root = indexC;
+        else if (_nodes[c.parent].child1 == indexA)
+            _nodes[c.parent].child1 = indexC;
+        else
+            _nodes[c.parent].child2 = indexC;
+
+        if (f.height > g.height)
+        {
+            c.child2 = indexF;
+            a.child2 = indexG;
+            g.parent = indexA;
+            mergeBoxes(b.box, g.box, &a.box);
+            mergeBoxes(a.box, f.box, &c.box);
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        }
+        else
+        {
+            c.child2 = indexG;
+            a.child2 = indexF;
+            f.parent = indexA;
+            mergeBoxes(b.box, f.box, &a.box);
+            mergeBoxes(a.box, g.box, &c.box);
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+        return indexC;
+    }
+
+    if (difference < -1)
+    {
+        // Rotate B up: A takes the place of B's shorter child, B takes the place of A.
+        const int indexD = b.child1;
+        const int indexE = b.child2;
+        TreeNode& d = _nodes[indexD];
+        TreeNode& e = _nodes[indexE];
+
+        b.child1 = indexA;
+        b.parent = a.parent;
+        a.parent = indexB;
+        if (b.parent == BVH_NULL_NODE)
+            _root = indexB;
+        else if (_nodes[b.parent].child1 == indexA)
+            _nodes[b.parent].child1 = indexB;
+        else
+            _nodes[b.parent].child2 = indexB;
+
+        if (d.height > e.height)
+        {
+            b.child2 = indexD;
+            a.child1 = indexE;
+            e.parent = indexA;
+            mergeBoxes(c.box, e.box, &a.box);
+            mergeBoxes(a.box, d.box, &b.box);
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        }
+        else
+        {
+            b.child2 = indexE;
+            a.child1 = indexD;
+            d.parent = indexA;
+            mergeBoxes(c.box, d.box, &a.box);
+            mergeBoxes(a.box, e.box, &b.box);
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+        return indexB;
+    }
+
+    return indexA;
+}
+
+}
@@ -0,0 +1,156 @@
+#ifndef BOUNDINGVOLUMEHIERARCHY_H_
+#define BOUNDINGVOLUMEHIERARCHY_H_
+
+#include "BoundingBox.h"
+#include "BoundingSphere.h"
+#include "Frustum.h"
+
+namespace gameplay
+{
+
+/**
+ * Defines a dynamic bounding volume hierarchy of bounding spheres, used to find the
+ * objects that intersect a frustum without testing each of them.
+ *
+ * Each object is a leaf of a balanced binary tree of axis-aligned boxes. The box of a
+ * leaf is the box of the sphere of the object grown by a margin, so an object that
+ * moves by less than the margin does not need to be moved in the tree. Objects are
+ * inserted next to the leaf that grows the tree the least, and the tree is rebalanced
+ * by rotations as leaves are inserted and removed.
+ *
+ * A query skips the subtrees whose box is outside the frustum and takes the subtrees
+ * whose box is inside it without testing them further. The leaves of the subtrees that
+ * intersect the frustum are tested with their sphere, so the result is the same as
+ * testing each sphere against the frustum.
+ *
+ * @script{ignore}
+ */
+class BoundingVolumeHierarchy
+{
+public:
+
+    /**
+     * Constructor.
+     */
+    BoundingVolumeHierarchy();
+
+    /**
+     * Destructor.
+     */
+    ~BoundingVolumeHierarchy();
+
+    /**
+     * Inserts an object.
+     *
+     * @param sphere The bounding sphere of the object.
+     * @param userData The object, returned by queries.
+     *
+     * @return The proxy of the object in the hierarchy.
+     */
+    int insert(const BoundingSphere& sphere, void* userData);
+
+    /**
+     * Removes an object.
+     *
+     * @param proxy The proxy returned when the object was inserted.
+     */
+    void remove(int proxy);
+
+    /**
+     * Updates the bounding sphere of an object.
+     *
+     * @param proxy The proxy returned when the object was inserted.
+     * @param sphere The new bounding sphere of the object.
+     *
+     * @return true if the object was moved in the tree, false if it still fit in its leaf.
+     */
+    bool update(int proxy, const BoundingSphere& sphere);
+
+    /**
+     * Removes all the objects.
+     */
+    void clear();
+
+    /**
+     * Gets the number of objects.
+     *
+     * @return The number of objects.
+     */
+    unsigned int getObjectCount() const;
+
+    /**
+     * Gets the height of the tree, 0 when it is empty.
+     *
+     * @return The height of the tree.
+     */
+    unsigned int getHeight() const;
+
+    /**
+     * Finds the objects whose bounding sphere intersects a frustum.
+     *
+     * @param frustum The frustum.
+     * @param objects The vector the user data of the objects found is appended to.
+     *
+     * @return The number of objects found.
+     */
+    unsigned int query(const Frustum& frustum, std::vector<void*>& objects) const;
+
+private:
+
+    /**
+     * A node of the tree. Leaves are objects.
+     */
+    struct TreeNode
+    {
+        BoundingBox box;
+        BoundingSphere sphere;          // Leaves only.
+        void* userData;                 // Leaves only.
+        int parent;                     // Next free node when the node is free.
+        int child1;
+        int child2;
+        int height;                     // 0 for leaves, -1 for free nodes.
+    };
+
+    /**
+     * Hidden copy constructor.
+     */
+    BoundingVolumeHierarchy(const BoundingVolumeHierarchy& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    BoundingVolumeHierarchy& operator=(const BoundingVolumeHierarchy&);
+
+    int allocateNode();
+
+    void freeNode(int index);
+
+    void insertLeaf(int leaf);
+
+    void removeLeaf(int leaf);
+
+    /**
+     * Recomputes the boxes and heights of a node and its ancestors, rebalancing them.
+     */
+    void refit(int index);
+
+    /**
+     * Rotates the taller child of an unbalanced node up, and returns the node now at its place.
+     */
+    int balance(int index);
+
+    /**
+     * Appends the user data of all the leaves of a subtree.
+     */
+    void collectLeaves(int index, std::vector<void*>& objects) const;
+
+    std::vector<TreeNode> _nodes;
+    int _root;
+    int _freeList;
+    unsigned int _objectCount;
+    mutable std::vector<int> _stack;
+};
+
+}
+
+#endif
@@ -14,6 +14,7 @@
 #include "MeshPart.h"
 #include "Scene.h"
 #include "Joint.h"
+#include "ResourceCache.h"
 
 // Minimum version numbers supported
 #define BUNDLE_VERSION_MAJOR_REQUIRED   1 
@@ -43,10 +44,8 @@
 namespace gameplay
 {
 
-static std::vector<Bundle*> __bundleCache;
-
 Bundle::Bundle(const char* path) :
-    _path(path), _referenceCount(0), _references(NULL), _stream(NULL), _trackedNodes(NULL)
+    _path(path), _referenceCount(0), _references(NULL), _stream(NULL), _data(NULL), _trackedNodes(NULL)
 {
 }
 
@@ -54,13 +53,6 @@ Bundle::~Bundle()
 {
     clearLoadSession();
 
-    // Remove this Bundle from the cache.
-    std::vector<Bundle*>::iterator itr = std::find(__bundleCache.begin(), __bundleCache.end(), this);
-    if (itr != __bundleCache.end())
-    {
-        __bundleCache.erase(itr);
-    }
-
     SAFE_DELETE_ARRAY(_references);
 
     if (_stream)
@@ -151,6 +143,76 @@ bool Bundle::readArray(unsigned int* length, std::vector<T>* values, unsigned in
     return true;
 }
 
+template <class T>
+bool Bundle::readArrayInPlace(unsigned int* length, const T** ptr, std::vector<T>* values)
+{
+    GP_ASSERT(length);
+    GP_ASSERT(ptr);
+    GP_ASSERT(values);
+    GP_ASSERT(_stream);
+
+    if (!read(length))
+    {
+        GP_ERROR("Failed to read the length of an array of data (to be read in place).");
+        return false;
+    }
+    *ptr = NULL;
+    if (*length > 0)
+    {
+        *ptr = (const T*)readInPlace(*length * sizeof(T), sizeof(T));
+        if (*ptr == NULL)
+        {
+            values->resize(*length);
+            if (_stream->read(&(*values)[0], sizeof(T), *length) != *length)
+            {
+                GP_ERROR("Failed to read an array of data from bundle (to be read in place).");
+                return false;
+            }
+            *ptr = &(*values)[0];
+        }
+    }
+    return true;
+}
+
+const unsigned char* Bundle::readBytes(unsigned int size, size_t alignment)
+{
+    GP_ASSERT(_stream);
+
+    const unsigned char* data = readInPlace(size, alignment);
+    if (data)
+        return data;
+
+    unsigned char* bytes = new unsigned char[size];
+    if (_stream->read(bytes, 1, size) != size)
+    {
+        SAFE_DELETE_ARRAY(bytes);
+    }
+    return bytes;
+}
+
+const unsigned char* Bundle::readInPlace(size_t size, size_t alignment)
+{
+    GP_ASSERT(_stream);
+    GP_ASSERT(alignment > 0);
+
+    if (_data == NULL)
+        return NULL;
+
+    long int position = _stream->position();
+    if (position < 0 || (size_t)position > _stream->length() || size > _stream->length() - (size_t)position)
+        return NULL;
+
+    const unsigned char* bytes = _data + position;
+    if ((size_t)bytes % alignment != 0 || !_stream->seek((long int)size, SEEK_CUR))
+        return NULL;
+    return bytes;
+}
+
+bool Bundle::isInPlace(const void* data) const
+{
+    return _data && data >= _data && data < _data + _stream->length();
+}
+
 static std::string readString(Stream* stream)
 {
     GP_ASSERT(stream);
@@ -183,20 +245,15 @@ Bundle* Bundle::create(const char* path)
     GP_ASSERT(path);
 
     // Search the cache for this bundle.
-    for (size_t i = 0, count = __bundleCache.size(); i < count; ++i)
+    Bundle* p = static_cast<Bundle*>(ResourceCache::find(ResourceCache::BUNDLE, path));
+    if (p)
     {
-        Bundle* p = __bundleCache[i];
-        GP_ASSERT(p);
-        if (p->_path == path)
-        {
-            // Found a match
-            p->addRef();
-            return p;
-        }
+        // Found a match
+        return p;
     }
 
-    // Open the bundle.
-    Stream* stream = FileSystem::open(path);
+    // Open the bundle, mapping it in memory to read vertex, index and key frame data in place.
+    Stream* stream = FileSystem::open(path, FileSystem::READ | FileSystem::MAP);
     if (!stream)
     {
         GP_WARN("Failed to open file '%s'.", path);
@@ -259,6 +316,13 @@ Bundle* Bundle::create(const char* path)
     bundle->_referenceCount = refCount;
     bundle->_references = refs;
     bundle->_stream = stream;
+    bundle->_data = (const unsigned char*)stream->map();
+    bundle->indexReferences();
+
+    // Share the open bundle with later loads of the same path. The pages of a mapped file
+    // count as CPU memory, though the system can reclaim them.
+    size_t cpuBytes = refCount * sizeof(Reference) + (bundle->_data ? stream->length() : 0);
+    ResourceCache::add(ResourceCache::BUNDLE, path, bundle, cpuBytes, 0);
 
     return bundle;
 }
@@ -269,16 +333,24 @@ Bundle::Reference* Bundle::find(const char* id) const
     GP_ASSERT(_references);
 
     // Search the ref table for the given id (case-sensitive).
+    std::unordered_map<std::string, Reference*>::const_iterator itr = _referencesById.find(id);
+    return itr != _referencesById.end() ? itr->second : NULL;
+}
+
+void Bundle::indexReferences()
+{
+    _referencesById.reserve(_referenceCount);
+    _referencesByOffset.reserve(_referenceCount);
     for (unsigned int i = 0; i < _referenceCount; ++i)
     {
-        if (_references[i].id == id)
-        {
-            // Found a match
-            return &_references[i];
-        }
+        // Keep the first reference of duplicate ids and offsets, as the linear search of the table did.
+        Reference* ref = &_references[i];
+        _referencesById.insert(std::make_pair(ref->id, ref));
+        if (ref->id.length() > 0)
+            _referencesByOffset.insert(std::make_pair(ref->offset, ref));
+        if (ref->type == BUNDLE_TYPE_ANIMATIONS)
+            _animationReferences.push_back(ref);
     }
-
-    return NULL;
 }
 
 void Bundle::clearLoadSession()
@@ -301,13 +373,10 @@ const char* Bundle::getIdFromOffset(unsigned int offset) const
     // Search the ref table for the given offset.
     if (offset > 0)
     {
-        GP_ASSERT(_references);
-        for (unsigned int i = 0; i < _referenceCount; ++i)
+        std::unordered_map<unsigned int, Reference*>::const_iterator itr = _referencesByOffset.find(offset);
+        if (itr != _referencesByOffset.end())
         {
-            if (_references[i].offset == offset && _references[i].id.length() > 0)
-            {
-                return _references[i].id.c_str();
-            }
+            return itr->second->id.c_str();
         }
     }
     return NULL;
@@ -482,19 +551,15 @@ Scene* Bundle::loadScene(const char* id)
     // Parse animations.
     GP_ASSERT(_references);
     GP_ASSERT(_stream);
-    for (unsigned int i = 0; i < _referenceCount; ++i)
+    for (size_t i = 0, count = _animationReferences.size(); i < count; ++i)
     {
-        Reference* ref = &_references[i];
-        if (ref->type == BUNDLE_TYPE_ANIMATIONS)
+        Reference* ref = _animationReferences[i];
+        if (_stream->seek(ref->offset, SEEK_SET) == false)
         {
-            // Found a match.
-            if (_stream->seek(ref->offset, SEEK_SET) == false)
-            {
-                GP_ERROR("Failed to seek to object '%s' in bundle '%s'.", ref->id.c_str(), _path.c_str());
-                return NULL;
-            }
-            readAnimations(scene);
+            GP_ERROR("Failed to seek to object '%s' in bundle '%s'.", ref->id.c_str(), _path.c_str());
+            return NULL;
         }
+        readAnimations(scene);
     }
 
     resolveJointReferences(scene, NULL);
@@ -522,90 +587,87 @@ Node* Bundle::loadNode(const char* id, Scene* sceneContext)
         resolveJointReferences(sceneContext, node);
 
     // Load all animations targeting any nodes or mesh skins under this node's hierarchy.
-    for (unsigned int i = 0; i < _referenceCount; i++)
+    for (size_t i = 0, count = _animationReferences.size(); i < count; i++)
     {
-        Reference* ref = &_references[i];
-        if (ref->type == BUNDLE_TYPE_ANIMATIONS)
+        Reference* ref = _animationReferences[i];
+        if (_stream->seek(ref->offset, SEEK_SET) == false)
         {
-            if (_stream->seek(ref->offset, SEEK_SET) == false)
-            {
-                GP_ERROR("Failed to seek to object '%s' in bundle '%s'.", ref->id.c_str(), _path.c_str());
-                SAFE_DELETE(_trackedNodes);
-                return NULL;
-            }
+            GP_ERROR("Failed to seek to object '%s' in bundle '%s'.", ref->id.c_str(), _path.c_str());
+            SAFE_DELETE(_trackedNodes);
+            return NULL;
+        }
 
-            // Read the number of animations in this object.
-            unsigned int animationCount;
-            if (!read(&animationCount))
+        // Read the number of animations in this object.
+        unsigned int animationCount;
+        if (!read(&animationCount))
+        {
+            GP_ERROR("Failed to read the number of animations for object '%s'.", ref->id.c_str());
+            SAFE_DELETE(_trackedNodes);
+            return NULL;
+        }
+
+        for (unsigned int j = 0; j < animationCount; j++)
+        {
+            const std::string id = readString(_stream);
+
+            // Read the number of animation channels in this animation.
+            unsigned int animationChannelCount;
+            if (!read(&animationChannelCount))
             {
-                GP_ERROR("Failed to read the number of animations for object '%s'.", ref->id.c_str());
+                GP_ERROR("Failed to read the number of animation channels for animation '%s'.", "animationChannelCount", id.c_str());
                 SAFE_DELETE(_trackedNodes);
                 return NULL;
             }
 
-            for (unsigned int j = 0; j < animationCount; j++)
+            Animation* animation = NULL;
+            for (unsigned int k = 0; k < animationChannelCount; k++)
             {
-                const std::string id = readString(_stream);
-
-                // Read the number of animation channels in this animation.
-                unsigned int animationChannelCount;
-                if (!read(&animationChannelCount))
+                // Read target id.
+                std::string targetId = readString(_stream);
+                if (targetId.empty())
                 {
-                    GP_ERROR("Failed to read the number of animation channels for animation '%s'.", "animationChannelCount", id.c_str());
+                    GP_ERROR("Failed to read target id for animation '%s'.", id.c_str());
                     SAFE_DELETE(_trackedNodes);
                     return NULL;
                 }
 
-                Animation* animation = NULL;
-                for (unsigned int k = 0; k < animationChannelCount; k++)
+                // If the target is one of the loaded nodes/joints, then load the animation.
+                std::map<std::string, Node*>::iterator iter = _trackedNodes->find(targetId);
+                if (iter != _trackedNodes->end())
                 {
-                    // Read target id.
-                    std::string targetId = readString(_stream);
-                    if (targetId.empty())
+                    // Read target attribute.
+                    unsigned int targetAttribute;
+                    if (!read(&targetAttribute))
                     {
-                        GP_ERROR("Failed to read target id for animation '%s'.", id.c_str());
+                        GP_ERROR("Failed to read target attribute for animation '%s'.", id.c_str());
                         SAFE_DELETE(_trackedNodes);
                         return NULL;
                     }
 
-                    // If the target is one of the loaded nodes/joints, then load the animation.
-                    std::map<std::string, Node*>::iterator iter = _trackedNodes->find(targetId);
-                    if (iter != _trackedNodes->end())
+                    AnimationTarget* target = iter->second;
+                    if (!target)
                     {
-                        // Read target attribute.
-                        unsigned int targetAttribute;
-                        if (!read(&targetAttribute))
-                        {
-                            GP_ERROR("Failed to read target attribute for animation '%s'.", id.c_str());
-                            SAFE_DELETE(_trackedNodes);
-                            return NULL;
-                        }
-
-                        AnimationTarget* target = iter->second;
-                        if (!target)
-                        {
-                            GP_ERROR("Failed to read %s for %s: %s", "animation target", targetId.c_str(), id.c_str());
-                            SAFE_DELETE(_trackedNodes);
-                            return NULL;
-                        }
-
-                        animation = readAnimationChannelData(animation, id.c_str(), target, targetAttribute);
+                        GP_ERROR("Failed to read %s for %s: %s", "animation target", targetId.c_str(), id.c_str());
+                        SAFE_DELETE(_trackedNodes);
+                        return NULL;
                     }
-                    else
-                    {
-                        // Skip over the target attribute.
-                        unsigned int data;
-                        if (!read(&data))
-                        {
-                            GP_ERROR("Failed to skip over target attribute for animation '%s'.", id.c_str());
-                            SAFE_DELETE(_trackedNodes);
-                            return NULL;
-                        }
 
-                        // Skip the animation channel (passing a target attribute of
-                        // 0 causes the animation to not be created).
-                        readAnimationChannelData(NULL, id.c_str(), NULL, 0);
+                    animation = readAnimationChannelData(animation, id.c_str(), target, targetAttribute);
+                }
+                else
+                {
+                    // Skip over the target attribute.
+                    unsigned int data;
+                    if (!read(&data))
+                    {
+                        GP_ERROR("Failed to skip over target attribute for animation '%s'.", id.c_str());
+                        SAFE_DELETE(_trackedNodes);
+                        return NULL;
                     }
+
+                    // Skip the animation channel (passing a target attribute of
+                    // 0 causes the animation to not be created).
+                    readAnimationChannelData(NULL, id.c_str(), NULL, 0);
                 }
             }
         }
@@ -1301,11 +1363,17 @@ Animation* Bundle::readAnimationChannelData(Animation* animation, const char* id
 {
     GP_ASSERT(id);
 
-    std::vector<unsigned int> keyTimes;
-    std::vector<float> values;
-    std::vector<float> tangentsIn;
-    std::vector<float> tangentsOut;
-    std::vector<unsigned int> interpolation;
+    // The arrays are read in place when the bundle is mapped, the vectors hold them otherwise.
+    const unsigned int* keyTimes;
+    const float* values;
+    const float* tangentsIn;
+    const float* tangentsOut;
+    const unsigned int* interpolation;
+    std::vector<unsigned int> keyTimesBuffer;
+    std::vector<float> valuesBuffer;
+    std::vector<float> tangentsInBuffer;
+    std::vector<float> tangentsOutBuffer;
+    std::vector<unsigned int> interpolationBuffer;
 
     // Length of the arrays.
     unsigned int keyTimesCount;
@@ -1315,35 +1383,35 @@ Animation* Bundle::readAnimationChannelData(Animation* animation, const char* id
     unsigned int interpolationCount;
 
     // Read key times.
-    if (!readArray(&keyTimesCount, &keyTimes, sizeof(unsigned int)))
+    if (!readArrayInPlace(&keyTimesCount, &keyTimes, &keyTimesBuffer))
     {
         GP_ERROR("Failed to read key times for animation '%s'.", id);
         return NULL;
     }
 
     // Read key values.
-    if (!readArray(&valuesCount, &values))
+    if (!readArrayInPlace(&valuesCount, &values, &valuesBuffer))
     {
         GP_ERROR("Failed to read key values for animation '%s'.", id);
         return NULL;
     }
 
     // Read in-tangents.
-    if (!readArray(&tangentsInCount, &tangentsIn))
+    if (!readArrayInPlace(&tangentsInCount, &tangentsIn, &tangentsInBuffer))
     {
         GP_ERROR("Failed to read in tangents for animation '%s'.", id);
         return NULL;
     }
 
     // Read out-tangents.
-    if (!readArray(&tangentsOutCount, &tangentsOut))
+    if (!readArrayInPlace(&tangentsOutCount, &tangentsOut, &tangentsOutBuffer))
     {
         GP_ERROR("Failed to read out tangents for animation '%s'.", id);
         return NULL;
     }
 
     // Read interpolations.
-    if (!readArray(&interpolationCount, &interpolation, sizeof(unsigned int)))
+    if (!readArrayInPlace(&interpolationCount, &interpolation, &interpolationBuffer))
     {
         GP_ERROR("Failed to read the interpolation values for animation '%s'.", id);
         return NULL;
@@ -1352,15 +1420,15 @@ Animation* Bundle::readAnimationChannelData(Animation* animation, const char* id
     if (targetAttribute > 0)
     {
         GP_ASSERT(target);
-        GP_ASSERT(keyTimes.size() > 0 && values.size() > 0);
+        GP_ASSERT(keyTimesCount > 0 && valuesCount > 0);
         if (animation == NULL)
         {
             // TODO: This code currently assumes LINEAR only.
-            animation = target->createAnimation(id, targetAttribute, keyTimesCount, &keyTimes[0], &values[0], Curve::LINEAR);
+            animation = target->createAnimation(id, targetAttribute, keyTimesCount, const_cast<unsigned int*>(keyTimes), const_cast<float*>(values), Curve::LINEAR);
         }
         else
         {
-            animation->createChannel(target, targetAttribute, keyTimesCount, &keyTimes[0], &values[0], Curve::LINEAR);
+            animation->createChannel(target, targetAttribute, keyTimesCount, const_cast<unsigned int*>(keyTimes), const_cast<float*>(values), Curve::LINEAR);
         }
     }
 
@@ -1406,7 +1474,7 @@ Mesh* Bundle::loadMesh(const char* id, const char* nodeId)
     if (mesh == NULL)
     {
         GP_ERROR("Failed to create mesh '%s'.", id);
-        SAFE_DELETE_ARRAY(meshData);
+        SAFE_DELETE(meshData);
         return NULL;
     }
 
@@ -1486,6 +1554,13 @@ Bundle::MeshData* Bundle::readMeshData()
     MeshData* meshData = new MeshData(VertexFormat(vertexElements, vertexElementCount));
     SAFE_DELETE_ARRAY(vertexElements);
 
+    // Data read in place is used while the mesh data keeps the bundle mapped.
+    if (_data)
+    {
+        meshData->bundle = this;
+        addRef();
+    }
+
     // Read vertex data.
     unsigned int vertexByteCount;
     if (_stream->read(&vertexByteCount, 4, 1) != 1)
@@ -1503,8 +1578,10 @@ Bundle::MeshData* Bundle::readMeshData()
 
     GP_ASSERT(meshData->vertexFormat.getVertexSize());
     meshData->vertexCount = vertexByteCount / meshData->vertexFormat.getVertexSize();
-    meshData->vertexData = new unsigned char[vertexByteCount];
-    if (_stream->read(meshData->vertexData, 1, vertexByteCount) != vertexByteCount)
+    // Vertices are read as floats, indices as integers of the index size, so the data is only
+    // used in place when it is aligned for them.
+    meshData->vertexData = readBytes(vertexByteCount, sizeof(float));
+    if (meshData->vertexData == NULL)
     {
         GP_ERROR("Failed to load vertex data.");
         SAFE_DELETE(meshData);
@@ -1576,14 +1653,15 @@ Bundle::MeshData* Bundle::readMeshData()
             break;
         default:
             GP_ERROR("Unsupported index format for mesh part with index %d.", i);
+            SAFE_DELETE(meshData);
             return NULL;
         }
 
         GP_ASSERT(indexSize);
         partData->indexCount = iByteCount / indexSize;
 
-        partData->indexData = new unsigned char[iByteCount];
-        if (_stream->read(partData->indexData, 1, iByteCount) != iByteCount)
+        partData->indexData = readBytes(iByteCount, indexSize);
+        if (partData->indexData == NULL)
         {
             GP_ERROR("Failed to read index data for mesh part with index %d.", i);
             SAFE_DELETE(meshData);
@@ -1781,13 +1859,12 @@ Font* Bundle::loadFont(const char* id)
             return NULL;
         }
 
-        // Read texture data.
-        unsigned char* textureData = new unsigned char[textureByteCount];
-        if (_stream->read(textureData, 1, textureByteCount) != textureByteCount)
+        // Read texture data, in place when the bundle is mapped.
+        const unsigned char* textureData = readBytes(textureByteCount, 1);
+        if (textureData == NULL)
         {
             GP_ERROR("Failed to read texture data for font '%s'.", id);
             SAFE_DELETE_ARRAY(glyphs);
-            SAFE_DELETE_ARRAY(textureData);
             return NULL;
         }
 
@@ -1800,7 +1877,8 @@ Font* Bundle::loadFont(const char* id)
             {
                 GP_ERROR("Failed to font format'%u'.", format);
                 SAFE_DELETE_ARRAY(glyphs);
-                SAFE_DELETE_ARRAY(textureData);
+                if (!isInPlace(textureData))
+                    SAFE_DELETE_ARRAY(textureData);
                 return NULL;
             }
         }
@@ -1809,7 +1887,8 @@ Font* Bundle::loadFont(const char* id)
         Texture* texture = Texture::create(style == Font::TEXTURED ? Texture::RGBA : Texture::ALPHA, width, height, textureData, false);
 
         // Free the texture data (no longer needed).
-        SAFE_DELETE_ARRAY(textureData);
+        if (!isInPlace(textureData))
+            SAFE_DELETE_ARRAY(textureData);
 
         if (texture == NULL)
         {
@@ -1892,18 +1971,32 @@ Bundle::MeshPartData::~MeshPartData()
 }
 
 Bundle::MeshData::MeshData(const VertexFormat& vertexFormat)
-    : vertexFormat(vertexFormat), vertexCount(0), vertexData(NULL), primitiveType(Mesh::TRIANGLES)
+    : vertexFormat(vertexFormat), vertexCount(0), vertexData(NULL), primitiveType(Mesh::TRIANGLES), bundle(NULL)
 {
 }
 
 Bundle::MeshData::~MeshData()
 {
+    // Data read in place belongs to the mapped bundle file, unaligned data was copied.
+    if (bundle)
+    {
+        if (bundle->isInPlace(vertexData))
+            vertexData = NULL;
+        for (unsigned int i = 0; i < parts.size(); ++i)
+        {
+            if (bundle->isInPlace(parts[i]->indexData))
+                parts[i]->indexData = NULL;
+        }
+    }
+
     SAFE_DELETE_ARRAY(vertexData);
 
     for (unsigned int i = 0; i < parts.size(); ++i)
     {
         SAFE_DELETE(parts[i]);
     }
+
+    SAFE_RELEASE(bundle);
 }
 
 }
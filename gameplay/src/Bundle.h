@@ -18,6 +18,9 @@ class Bundle : public Ref
 {
     friend class PhysicsController;
     friend class SceneLoader;
+    friend class SoftwareSkin;
+    friend class InstancedModel;
+    friend class OcclusionCuller;
 
 public:
 
@@ -149,7 +152,7 @@ private:
         Mesh::PrimitiveType primitiveType;
         Mesh::IndexFormat indexFormat;
         unsigned int indexCount;
-        unsigned char* indexData;
+        const unsigned char* indexData;
     };
 
     struct MeshData
@@ -159,11 +162,12 @@ private:
 
         VertexFormat vertexFormat;
         unsigned int vertexCount;
-        unsigned char* vertexData;
+        const unsigned char* vertexData;
         BoundingBox boundingBox;
         BoundingSphere boundingSphere;
         Mesh::PrimitiveType primitiveType;
         std::vector<MeshPartData*> parts;
+        Bundle* bundle;     // Keeps the bundle file mapped when the data may be read in place, NULL when the data is owned.
     };
 
     Bundle(const char* path);
@@ -183,6 +187,11 @@ private:
      */
     Reference* find(const char* id) const;
 
+    /**
+     * Indexes the references by ID and offset, so that they are found without searching the ref table.
+     */
+    void indexReferences();
+
     /**
      * Resets any load session specific state for the bundle.
      */
@@ -315,6 +324,50 @@ private:
      */
     template <class T>
     bool readArray(unsigned int* length, std::vector<T>* values, unsigned int readSize);
+
+    /**
+     * Reads an array of values and the array length from the current file position, in place
+     * when the file is mapped in memory and the values are aligned.
+     *
+     * @param length A pointer to where the length of the array will be copied to.
+     * @param ptr A pointer to where the address of the values will be copied to, in the mapped file or in values.
+     * @param values A pointer to the vector to copy the values to when they cannot be read in place.
+     *
+     * @return True if successful, false if an error occurred.
+     */
+    template <class T>
+    bool readArrayInPlace(unsigned int* length, const T** ptr, std::vector<T>* values);
+
+    /**
+     * Reads bytes from the current file position, in place when the file is mapped in memory
+     * and the bytes are aligned.
+     *
+     * @param size The number of bytes to read.
+     * @param alignment The alignment the bytes must have to be read in place, in bytes.
+     *
+     * @return The bytes in the mapped file, or a new array that the caller must delete when they
+     *      cannot be read in place (see isInPlace). NULL if an error occurred.
+     */
+    const unsigned char* readBytes(unsigned int size, size_t alignment);
+
+    /**
+     * Checks whether data was read in place, in the mapped file.
+     *
+     * @param data The data.
+     *
+     * @return true if the data is in the mapped file, false if it was copied.
+     */
+    bool isInPlace(const void* data) const;
+
+    /**
+     * Gets the bytes at the current file position in the mapped file and skips them.
+     *
+     * @param size The number of bytes.
+     * @param alignment The alignment the bytes must have, in bytes.
+     *
+     * @return The bytes, or NULL if the file is not mapped, is too short or the bytes are not aligned.
+     */
+    const unsigned char* readInPlace(size_t size, size_t alignment);
     
     /**
      * Reads 16 floats from the current file position.
@@ -455,7 +508,11 @@ private:
     std::string _materialPath;
     unsigned int _referenceCount;
     Reference* _references;
+    std::unordered_map<std::string, Reference*> _referencesById;            // The first reference with each ID.
+    std::unordered_map<unsigned int, Reference*> _referencesByOffset;       // The first reference with an ID at each offset.
+    std::vector<Reference*> _animationReferences;                           // The references of animation objects, in table order.
     Stream* _stream;
+    const unsigned char* _data;     // The bytes of the file when it is mapped in memory, NULL otherwise.
 
     std::vector<MeshSkinData*> _meshSkins;
     std::map<std::string, Node*>* _trackedNodes;
@@ -121,6 +121,20 @@ Curve::Point::~Point()
     SAFE_DELETE_ARRAY(outValue);
 }
 
+Curve::Cursor::Cursor()
+    : _startTime(-1.0f), _endTime(-1.0f), _min(0), _max(0), _index(0)
+{
+}
+
+void Curve::Cursor::reset()
+{
+    _startTime = -1.0f;
+    _endTime = -1.0f;
+    _min = 0;
+    _max = 0;
+    _index = 0;
+}
+
 unsigned int Curve::getPointCount() const
 {
     return _pointCount;
@@ -211,6 +225,11 @@ void Curve::evaluate(float time, float* dst) const
 }
 
 void Curve::evaluate(float time, float startTime, float endTime, float loopBlendTime, float* dst) const
+{
+    evaluate(time, startTime, endTime, loopBlendTime, dst, NULL);
+}
+
+void Curve::evaluate(float time, float startTime, float endTime, float loopBlendTime, float* dst, Cursor* cursor) const
 {
     assert(dst && startTime >= 0.0f && startTime <= endTime && endTime <= 1.0f && loopBlendTime >= 0.0f);
 
@@ -227,8 +246,7 @@ void Curve::evaluate(float time, float startTime, float endTime, float loopBlend
     if (startTime > 0.0f || endTime < 1.0f)
     {
         // Evaluating a sub section of the curve
-        min = determineIndex(startTime, 0, max);
-        max = determineIndex(endTime, min, max);
+        determineRange(startTime, endTime, &min, &max, cursor);
 
         // Convert time to fall within the subregion
         localTime = _points[min].time + (_points[max].time - _points[min].time) * time;
@@ -283,8 +301,16 @@ void Curve::evaluate(float time, float startTime, float endTime, float loopBlend
     }
     else
     {
-        // Locate the points we are interpolating between using a binary search.
-        index = determineIndex(localTime, min, max);
+        // Locate the points we are interpolating between, starting from the last interval if there is a cursor.
+        if (cursor)
+        {
+            index = determineIndex(localTime, min, max, cursor->_index);
+            cursor->_index = index;
+        }
+        else
+        {
+            index = determineIndex(localTime, min, max);
+        }
         from = &_points[index];
         to = &_points[index == max ? index : index+1];
 
@@ -1267,6 +1293,40 @@ int Curve::determineIndex(float time, unsigned int min, unsigned int max) const
     return max;
 }
 
+unsigned int Curve::determineIndex(float time, unsigned int min, unsigned int max, unsigned int hint) const
+{
+    if (hint >= min && hint < max && time >= _points[hint].time)
+    {
+        if (time < _points[hint + 1].time)
+            return hint;
+        if (hint + 1 < max && time < _points[hint + 2].time)
+            return hint + 1;
+    }
+
+    return determineIndex(time, min, max);
+}
+
+void Curve::determineRange(float startTime, float endTime, unsigned int* min, unsigned int* max, Cursor* cursor) const
+{
+    if (cursor && cursor->_startTime == startTime && cursor->_endTime == endTime)
+    {
+        *min = cursor->_min;
+        *max = cursor->_max;
+        return;
+    }
+
+    *min = determineIndex(startTime, 0, _pointCount - 1);
+    *max = determineIndex(endTime, *min, _pointCount - 1);
+
+    if (cursor)
+    {
+        cursor->_startTime = startTime;
+        cursor->_endTime = endTime;
+        cursor->_min = *min;
+        cursor->_max = *max;
+    }
+}
+
 int Curve::getInterpolationType(const char* curveId)
 {
     if (strcmp(curveId, "BEZIER") == 0)
@@ -275,6 +275,40 @@ public:
         BOUNCE_OUT_IN
     };
 
+    /**
+     * Keeps the keyframe search state of a curve between evaluations.
+     *
+     * Playback moves forward by small steps, so the keyframe interval found by the last
+     * evaluation is checked first and the binary search only runs when the time jumped.
+     *
+     * @script{ignore}
+     */
+    class Cursor
+    {
+        friend class Curve;
+        friend class Animation;
+
+    public:
+
+        /**
+         * Constructor.
+         */
+        Cursor();
+
+        /**
+         * Forgets the cached search state.
+         */
+        void reset();
+
+    private:
+
+        float _startTime;               // Subregion the cached point range was computed for.
+        float _endTime;
+        unsigned int _min;              // First point of the subregion.
+        unsigned int _max;              // Last point of the subregion.
+        unsigned int _index;            // Point the last evaluation interpolated from.
+    };
+
     /**
      * Creates a new curve.
      *
@@ -414,6 +448,23 @@ public:
      */
     void evaluate(float time, float startTime, float endTime, float loopBlendTime, float* dst) const;
 
+    /**
+     * Evaluates the curve at the given position value within the specified subregion of
+     * the curve, starting the keyframe search from the state of a cursor.
+     *
+     * @param time The position within the subregion of the curve to evaluate the curve at.
+     * @param startTime Start time for the subregion (between 0.0 - 1.0).
+     * @param endTime End time for the subregion (between 0.0 - 1.0).
+     * @param loopBlendTime Time (in milliseconds) to blend between the end points of the curve
+     *      for looping purposes when time is outside the range 0-1.
+     * @param dst The evaluated value of the curve at the given time.
+     * @param cursor The cursor of the caller, updated with the keyframe found. Must only be used with this curve.
+     *
+     * @see evaluate(float, float, float, float, float*)
+     * @script{ignore}
+     */
+    void evaluate(float time, float startTime, float endTime, float loopBlendTime, float* dst, Cursor* cursor) const;
+
     /**
      * Linear interpolation function.
      */
@@ -531,6 +582,17 @@ private:
      */
     int determineIndex(float time, unsigned int min, unsigned int max) const;
 
+    /**
+     * Determines the keyframe to interpolate from, checking the interval of the last evaluation
+     * and the next one before falling back to a binary search.
+     */
+    unsigned int determineIndex(float time, unsigned int min, unsigned int max, unsigned int hint) const;
+
+    /**
+     * Determines the range of points of a subregion of the curve, reusing the range cached in the cursor.
+     */
+    void determineRange(float startTime, float endTime, unsigned int* min, unsigned int* max, Cursor* cursor) const;
+
     /**
      * Sets the offset for the beginning of a Quaternion piece of data within the curve's value span at the specified
      * index. The next four components of data starting at the given index will be interpolated as a Quaternion.
@@ -2,14 +2,13 @@
 #include "Effect.h"
 #include "FileSystem.h"
 #include "Game.h"
+#include "ResourceCache.h"
 
 #define OPENGL_ES_DEFINE  "OPENGL_ES"
 
 namespace gameplay
 {
 
-// Cache of unique effects.
-static std::map<std::string, Effect*> __effectCache;
 static Effect* __currentEffect = NULL;
 
 Effect::Effect() : _program(0)
@@ -18,9 +17,6 @@ Effect::Effect() : _program(0)
 
 Effect::~Effect()
 {
-    // Remove this effect from the cache.
-    __effectCache.erase(_id);
-
     // Free uniforms.
     for (std::map<std::string, Uniform*>::iterator itr = _uniforms.begin(); itr != _uniforms.end(); ++itr)
     {
@@ -42,6 +38,11 @@ Effect::~Effect()
 }
 
 Effect* Effect::createFromFile(const char* vshPath, const char* fshPath, const char* defines)
+{
+    return createFromFile(vshPath, fshPath, defines, NULL);
+}
+
+Effect* Effect::createFromFile(const char* vshPath, const char* fshPath, const char* defines, const Source* source)
 {
     GP_ASSERT(vshPath);
     GP_ASSERT(fshPath);
@@ -55,34 +56,28 @@ Effect* Effect::createFromFile(const char* vshPath, const char* fshPath, const c
     {
         uniqueId += defines;
     }
-    std::map<std::string, Effect*>::const_iterator itr = __effectCache.find(uniqueId);
-    if (itr != __effectCache.end())
+    Effect* cached = static_cast<Effect*>(ResourceCache::find(ResourceCache::EFFECT, uniqueId.c_str()));
+    if (cached)
     {
-        // Found an exiting effect with this id, so increase its ref count and return it.
-        GP_ASSERT(itr->second);
-        itr->second->addRef();
-        return itr->second;
+        // Found an exiting effect with this id, its ref count is increased.
+        return cached;
     }
 
-    // Read source from file.
-    char* vshSource = FileSystem::readAll(vshPath);
-    if (vshSource == NULL)
+    // Read source from file, unless a loader thread already did.
+    Source fileSource;
+    if (source == NULL)
     {
-        GP_ERROR("Failed to read vertex shader from file '%s'.", vshPath);
-        return NULL;
+        replaceDefines(defines, fileSource.defines);
+        if (!readSource(vshPath, fshPath, &fileSource))
+            return NULL;
+        source = &fileSource;
     }
-    char* fshSource = FileSystem::readAll(fshPath);
-    if (fshSource == NULL)
+    else if (!source->valid)
     {
-        GP_ERROR("Failed to read fragment shader from file '%s'.", fshPath);
-        SAFE_DELETE_ARRAY(vshSource);
         return NULL;
     }
 
-    Effect* effect = createFromSource(vshPath, vshSource, fshPath, fshSource, defines);
-    
-    SAFE_DELETE_ARRAY(vshSource);
-    SAFE_DELETE_ARRAY(fshSource);
+    Effect* effect = createFromSource(vshPath, fshPath, *source);
 
     if (effect == NULL)
     {
@@ -90,9 +85,10 @@ Effect* Effect::createFromFile(const char* vshPath, const char* fshPath, const c
     }
     else
     {
-        // Store this effect in the cache.
+        // Store this effect in the cache. The memory of linked programs is not known.
         effect->_id = uniqueId;
-        __effectCache[uniqueId] = effect;
+        ResourceCache::add(ResourceCache::EFFECT, uniqueId.c_str(), effect, 0, 0);
+        ProgramCache::addEffect(uniqueId);
     }
 
     return effect;
@@ -100,10 +96,18 @@ Effect* Effect::createFromFile(const char* vshPath, const char* fshPath, const c
 
 Effect* Effect::createFromSource(const char* vshSource, const char* fshSource, const char* defines)
 {
-    return createFromSource(NULL, vshSource, NULL, fshSource, defines);
+    GP_ASSERT(vshSource);
+    GP_ASSERT(fshSource);
+
+    Source source;
+    replaceDefines(defines, source.defines);
+    source.vsh = vshSource;
+    source.fsh = fshSource;
+    source.valid = true;
+    return createFromSource(NULL, NULL, source);
 }
 
-static void replaceDefines(const char* defines, std::string& out)
+void Effect::replaceDefines(const char* defines, std::string& out)
 {
     Properties* graphicsConfig = Game::getInstance()->getConfig()->getNamespace("graphics", true);
     const char* globalDefines = graphicsConfig ? graphicsConfig->getString("shaderDefines") : NULL;
@@ -226,140 +230,68 @@ static void writeShaderToErrorFile(const char* filePath, const char* source)
     }
 }
 
-Effect* Effect::createFromSource(const char* vshPath, const char* vshSource, const char* fshPath, const char* fshSource, const char* defines)
+bool Effect::readSource(const char* vshPath, const char* fshPath, Source* source)
 {
-    GP_ASSERT(vshSource);
-    GP_ASSERT(fshSource);
-
-    const unsigned int SHADER_SOURCE_LENGTH = 3;
-    const GLchar* shaderSource[SHADER_SOURCE_LENGTH];
-    char* infoLog = NULL;
-    GLuint vertexShader;
-    GLuint fragmentShader;
-    GLuint program;
-    GLint length;
-    GLint success;
+    GP_ASSERT(vshPath);
+    GP_ASSERT(fshPath);
+    GP_ASSERT(source);
 
-    // Replace all comma separated definitions with #define prefix and \n suffix
-    std::string definesStr = "";
-    replaceDefines(defines, definesStr);
-    
-    shaderSource[0] = definesStr.c_str();
-    shaderSource[1] = "\n";
-    std::string vshSourceStr = "";
-    if (vshPath)
-    {
-        // Replace the #include "xxxxx.xxx" with the sources that come from file paths
-        replaceIncludes(vshPath, vshSource, vshSourceStr);
-        if (vshSource && strlen(vshSource) != 0)
-            vshSourceStr += "\n";
-    }
-    shaderSource[2] = vshPath ? vshSourceStr.c_str() :  vshSource;
-    GL_ASSERT( vertexShader = glCreateShader(GL_VERTEX_SHADER) );
-    GL_ASSERT( glShaderSource(vertexShader, SHADER_SOURCE_LENGTH, shaderSource, NULL) );
-    GL_ASSERT( glCompileShader(vertexShader) );
-    GL_ASSERT( glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success) );
-    if (success != GL_TRUE)
+    // Read source from file.
+    char* vshSource = FileSystem::readAll(vshPath);
+    if (vshSource == NULL)
     {
-        GL_ASSERT( glGetShaderiv(vertexShader, GL_INFO_LOG_LENGTH, &length) );
-        if (length == 0)
-        {
-            length = 4096;
-        }
-        if (length > 0)
-        {
-            infoLog = new char[length];
-            GL_ASSERT( glGetShaderInfoLog(vertexShader, length, NULL, infoLog) );
-            infoLog[length-1] = '\0';
-        }
-
-        // Write out the expanded shader file.
-        if (vshPath)
-            writeShaderToErrorFile(vshPath, shaderSource[2]);
-
-        GP_ERROR("Compile failed (%s): %s.", vshPath == NULL ? vshSource : vshPath, infoLog == NULL ? "" : infoLog);
-        SAFE_DELETE_ARRAY(infoLog);
-
-        // Clean up.
-        GL_ASSERT( glDeleteShader(vertexShader) );
-
-        return NULL;
+        GP_ERROR("Failed to read vertex shader from file '%s'.", vshPath);
+        return false;
     }
-
-    // Compile the fragment shader.
-    std::string fshSourceStr;
-    if (fshPath)
+    char* fshSource = FileSystem::readAll(fshPath);
+    if (fshSource == NULL)
     {
-        // Replace the #include "xxxxx.xxx" with the sources that come from file paths
-        replaceIncludes(fshPath, fshSource, fshSourceStr);
-        if (fshSource && strlen(fshSource) != 0)
-            fshSourceStr += "\n";
+        GP_ERROR("Failed to read fragment shader from file '%s'.", fshPath);
+        SAFE_DELETE_ARRAY(vshSource);
+        return false;
     }
-    shaderSource[2] = fshPath ? fshSourceStr.c_str() : fshSource;
-    GL_ASSERT( fragmentShader = glCreateShader(GL_FRAGMENT_SHADER) );
-    GL_ASSERT( glShaderSource(fragmentShader, SHADER_SOURCE_LENGTH, shaderSource, NULL) );
-    GL_ASSERT( glCompileShader(fragmentShader) );
-    GL_ASSERT( glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success) );
-    if (success != GL_TRUE)
-    {
-        GL_ASSERT( glGetShaderiv(fragmentShader, GL_INFO_LOG_LENGTH, &length) );
-        if (length == 0)
-        {
-            length = 4096;
-        }
-        if (length > 0)
-        {
-            infoLog = new char[length];
-            GL_ASSERT( glGetShaderInfoLog(fragmentShader, length, NULL, infoLog) );
-            infoLog[length-1] = '\0';
-        }
-        
-        // Write out the expanded shader file.
-        if (fshPath)
-            writeShaderToErrorFile(fshPath, shaderSource[2]);
 
-        GP_ERROR("Compile failed (%s): %s", fshPath == NULL ? fshSource : fshPath, infoLog == NULL ? "" : infoLog);
-        SAFE_DELETE_ARRAY(infoLog);
+    // Replace the #include "xxxxx.xxx" with the sources that come from file paths
+    source->vsh.clear();
+    replaceIncludes(vshPath, vshSource, source->vsh);
+    if (strlen(vshSource) != 0)
+        source->vsh += "\n";
+    source->fsh.clear();
+    replaceIncludes(fshPath, fshSource, source->fsh);
+    if (strlen(fshSource) != 0)
+        source->fsh += "\n";
 
-        // Clean up.
-        GL_ASSERT( glDeleteShader(vertexShader) );
-        GL_ASSERT( glDeleteShader(fragmentShader) );
+    SAFE_DELETE_ARRAY(vshSource);
+    SAFE_DELETE_ARRAY(fshSource);
 
-        return NULL;
-    }
+    source->valid = true;
+    return true;
+}
 
-    // Link program.
-    GL_ASSERT( program = glCreateProgram() );
-    GL_ASSERT( glAttachShader(program, vertexShader) );
-    GL_ASSERT( glAttachShader(program, fragmentShader) );
-    GL_ASSERT( glLinkProgram(program) );
-    GL_ASSERT( glGetProgramiv(program, GL_LINK_STATUS, &success) );
+Effect* Effect::createFromSource(const char* vshPath, const char* fshPath, const Source& source)
+{
+    GP_ASSERT(source.valid);
 
-    // Delete shaders after linking.
-    GL_ASSERT( glDeleteShader(vertexShader) );
-    GL_ASSERT( glDeleteShader(fragmentShader) );
+    GLuint program = 0;
+    GLint length;
 
-    // Check link status.
-    if (success != GL_TRUE)
+    // Load the program from the program cache, which holds the binaries linked by the previous runs.
+    unsigned long long key = 0;
+    bool cacheEnabled = ProgramCache::isEnabled();
+    if (cacheEnabled)
     {
-        GL_ASSERT( glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length) );
-        if (length == 0)
-        {
-            length = 4096;
-        }
-        if (length > 0)
-        {
-            infoLog = new char[length];
-            GL_ASSERT( glGetProgramInfoLog(program, length, NULL, infoLog) );
-            infoLog[length-1] = '\0';
-        }
-        GP_ERROR("Linking program failed (%s,%s): %s", vshPath == NULL ? "NULL" : vshPath, fshPath == NULL ? "NULL" : fshPath, infoLog == NULL ? "" : infoLog);
-        SAFE_DELETE_ARRAY(infoLog);
+        key = ProgramCache::getKey(source.defines, source.vsh, source.fsh);
+        program = source.binary.data.empty() ? ProgramCache::load(key) : ProgramCache::load(source.binary);
+    }
 
-        // Clean up.
-        GL_ASSERT( glDeleteProgram(program) );
+    if (program == 0)
+    {
+        program = compileProgram(vshPath, fshPath, source);
+        if (program == 0)
+            return NULL;
 
-        return NULL;
+        if (cacheEnabled)
+            ProgramCache::save(key, program);
     }
 
     // Create and return the new Effect.
@@ -458,6 +390,127 @@ Effect* Effect::createFromSource(const char* vshPath, const char* vshSource, con
     return effect;
 }
 
+GLuint Effect::compileProgram(const char* vshPath, const char* fshPath, const Source& source)
+{
+    const unsigned int SHADER_SOURCE_LENGTH = 3;
+    const GLchar* shaderSource[SHADER_SOURCE_LENGTH];
+    char* infoLog = NULL;
+    GLuint vertexShader;
+    GLuint fragmentShader;
+    GLuint program;
+    GLint length;
+    GLint success;
+
+    shaderSource[0] = source.defines.c_str();
+    shaderSource[1] = "\n";
+    shaderSource[2] = source.vsh.c_str();
+    GL_ASSERT( vertexShader = glCreateShader(GL_VERTEX_SHADER) );
+    GL_ASSERT( glShaderSource(vertexShader, SHADER_SOURCE_LENGTH, shaderSource, NULL) );
+    GL_ASSERT( glCompileShader(vertexShader) );
+    GL_ASSERT( glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success) );
+    if (success != GL_TRUE)
+    {
+        GL_ASSERT( glGetShaderiv(vertexShader, GL_INFO_LOG_LENGTH, &length) );
+        if (length == 0)
+        {
+            length = 4096;
+        }
+        if (length > 0)
+        {
+            infoLog = new char[length];
+            GL_ASSERT( glGetShaderInfoLog(vertexShader, length, NULL, infoLog) );
+            infoLog[length-1] = '\0';
+        }
+
+        // Write out the expanded shader file.
+        if (vshPath)
+            writeShaderToErrorFile(vshPath, shaderSource[2]);
+
+        GP_ERROR("Compile failed (%s): %s.", vshPath == NULL ? source.vsh.c_str() : vshPath, infoLog == NULL ? "" : infoLog);
+        SAFE_DELETE_ARRAY(infoLog);
+
+        // Clean up.
+        GL_ASSERT( glDeleteShader(vertexShader) );
+
+        return 0;
+    }
+
+    // Compile the fragment shader.
+    shaderSource[2] = source.fsh.c_str();
+    GL_ASSERT( fragmentShader = glCreateShader(GL_FRAGMENT_SHADER) );
+    GL_ASSERT( glShaderSource(fragmentShader, SHADER_SOURCE_LENGTH, shaderSource, NULL) );
+    GL_ASSERT( glCompileShader(fragmentShader) );
+    GL_ASSERT( glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success) );
+    if (success != GL_TRUE)
+    {
+        GL_ASSERT( glGetShaderiv(fragmentShader, GL_INFO_LOG_LENGTH, &length) );
+        if (length == 0)
+        {
+            length = 4096;
+        }
+        if (length > 0)
+        {
+            infoLog = new char[length];
+            GL_ASSERT( glGetShaderInfoLog(fragmentShader, length, NULL, infoLog) );
+            infoLog[length-1] = '\0';
+        }
+        
+        // Write out the expanded shader file.
+        if (fshPath)
+            writeShaderToErrorFile(fshPath, shaderSource[2]);
+
+        GP_ERROR("Compile failed (%s): %s", fshPath == NULL ? source.fsh.c_str() : fshPath, infoLog == NULL ? "" : infoLog);
+        SAFE_DELETE_ARRAY(infoLog);
+
+        // Clean up.
+        GL_ASSERT( glDeleteShader(vertexShader) );
+        GL_ASSERT( glDeleteShader(fragmentShader) );
+
+        return 0;
+    }
+
+    // Link program.
+    GL_ASSERT( program = glCreateProgram() );
+#if defined(GP_USE_PROGRAM_BINARY) && !defined(OPENGL_ES)
+    // Some drivers only keep the binary of the programs flagged before linking.
+    if (ProgramCache::isEnabled() && glProgramParameteri)
+        GL_ASSERT( glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE) );
+#endif
+    GL_ASSERT( glAttachShader(program, vertexShader) );
+    GL_ASSERT( glAttachShader(program, fragmentShader) );
+    GL_ASSERT( glLinkProgram(program) );
+    GL_ASSERT( glGetProgramiv(program, GL_LINK_STATUS, &success) );
+
+    // Delete shaders after linking.
+    GL_ASSERT( glDeleteShader(vertexShader) );
+    GL_ASSERT( glDeleteShader(fragmentShader) );
+
+    // Check link status.
+    if (success != GL_TRUE)
+    {
+        GL_ASSERT( glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length) );
+        if (length == 0)
+        {
+            length = 4096;
+        }
+        if (length > 0)
+        {
+            infoLog = new char[length];
+            GL_ASSERT( glGetProgramInfoLog(program, length, NULL, infoLog) );
+            infoLog[length-1] = '\0';
+        }
+        GP_ERROR("Linking program failed (%s,%s): %s", vshPath == NULL ? "NULL" : vshPath, fshPath == NULL ? "NULL" : fshPath, infoLog == NULL ? "" : infoLog);
+        SAFE_DELETE_ARRAY(infoLog);
+
+        // Clean up.
+        GL_ASSERT( glDeleteProgram(program) );
+
+        return 0;
+    }
+
+    return program;
+}
+
 const char* Effect::getId() const
 {
     return _id.c_str();
@@ -530,79 +583,115 @@ unsigned int Effect::getUniformCount() const
 void Effect::setValue(Uniform* uniform, float value)
 {
     GP_ASSERT(uniform);
-    GL_ASSERT( glUniform1f(uniform->_location, value) );
+    if (uniform->updateValue(&value, sizeof(value)))
+    {
+        GL_ASSERT( glUniform1f(uniform->_location, value) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const float* values, unsigned int count)
 {
     GP_ASSERT(uniform);
     GP_ASSERT(values);
-    GL_ASSERT( glUniform1fv(uniform->_location, count, values) );
+    if (uniform->updateValue(values, sizeof(float) * count))
+    {
+        GL_ASSERT( glUniform1fv(uniform->_location, count, values) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, int value)
 {
     GP_ASSERT(uniform);
-    GL_ASSERT( glUniform1i(uniform->_location, value) );
+    if (uniform->updateValue(&value, sizeof(value)))
+    {
+        GL_ASSERT( glUniform1i(uniform->_location, value) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const int* values, unsigned int count)
 {
     GP_ASSERT(uniform);
     GP_ASSERT(values);
-    GL_ASSERT( glUniform1iv(uniform->_location, count, values) );
+    if (uniform->updateValue(values, sizeof(int) * count))
+    {
+        GL_ASSERT( glUniform1iv(uniform->_location, count, values) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const Matrix& value)
 {
     GP_ASSERT(uniform);
-    GL_ASSERT( glUniformMatrix4fv(uniform->_location, 1, GL_FALSE, value.m) );
+    if (uniform->updateValue(value.m, sizeof(float) * 16))
+    {
+        GL_ASSERT( glUniformMatrix4fv(uniform->_location, 1, GL_FALSE, value.m) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const Matrix* values, unsigned int count)
 {
     GP_ASSERT(uniform);
     GP_ASSERT(values);
-    GL_ASSERT( glUniformMatrix4fv(uniform->_location, count, GL_FALSE, (GLfloat*)values) );
+    if (uniform->updateValue(values, sizeof(Matrix) * count))
+    {
+        GL_ASSERT( glUniformMatrix4fv(uniform->_location, count, GL_FALSE, (GLfloat*)values) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const Vector2& value)
 {
     GP_ASSERT(uniform);
-    GL_ASSERT( glUniform2f(uniform->_location, value.x, value.y) );
+    if (uniform->updateValue(&value.x, sizeof(float) * 2))
+    {
+        GL_ASSERT( glUniform2f(uniform->_location, value.x, value.y) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const Vector2* values, unsigned int count)
 {
     GP_ASSERT(uniform);
     GP_ASSERT(values);
-    GL_ASSERT( glUniform2fv(uniform->_location, count, (GLfloat*)values) );
+    if (uniform->updateValue(values, sizeof(Vector2) * count))
+    {
+        GL_ASSERT( glUniform2fv(uniform->_location, count, (GLfloat*)values) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const Vector3& value)
 {
     GP_ASSERT(uniform);
-    GL_ASSERT( glUniform3f(uniform->_location, value.x, value.y, value.z) );
+    if (uniform->updateValue(&value.x, sizeof(float) * 3))
+    {
+        GL_ASSERT( glUniform3f(uniform->_location, value.x, value.y, value.z) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const Vector3* values, unsigned int count)
 {
     GP_ASSERT(uniform);
     GP_ASSERT(values);
-    GL_ASSERT( glUniform3fv(uniform->_location, count, (GLfloat*)values) );
+    if (uniform->updateValue(values, sizeof(Vector3) * count))
+    {
+        GL_ASSERT( glUniform3fv(uniform->_location, count, (GLfloat*)values) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const Vector4& value)
 {
     GP_ASSERT(uniform);
-    GL_ASSERT( glUniform4f(uniform->_location, value.x, value.y, value.z, value.w) );
+    if (uniform->updateValue(&value.x, sizeof(float) * 4))
+    {
+        GL_ASSERT( glUniform4f(uniform->_location, value.x, value.y, value.z, value.w) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const Vector4* values, unsigned int count)
 {
     GP_ASSERT(uniform);
     GP_ASSERT(values);
-    GL_ASSERT( glUniform4fv(uniform->_location, count, (GLfloat*)values) );
+    if (uniform->updateValue(values, sizeof(Vector4) * count))
+    {
+        GL_ASSERT( glUniform4fv(uniform->_location, count, (GLfloat*)values) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const Texture::Sampler* sampler)
@@ -618,7 +707,11 @@ void Effect::setValue(Uniform* uniform, const Texture::Sampler* sampler)
     // Bind the sampler - this binds the texture and applies sampler state
     const_cast<Texture::Sampler*>(sampler)->bind();
 
-    GL_ASSERT( glUniform1i(uniform->_location, uniform->_index) );
+    GLint unit = uniform->_index;
+    if (uniform->updateValue(&unit, sizeof(unit)))
+    {
+        GL_ASSERT( glUniform1i(uniform->_location, unit) );
+    }
 }
 
 void Effect::setValue(Uniform* uniform, const Texture::Sampler** values, unsigned int count)
@@ -642,7 +735,10 @@ void Effect::setValue(Uniform* uniform, const Texture::Sampler** values, unsigne
     }
 
     // Pass texture unit array to GL
-    GL_ASSERT( glUniform1iv(uniform->_location, count, units) );
+    if (uniform->updateValue(units, sizeof(GLint) * count))
+    {
+        GL_ASSERT( glUniform1iv(uniform->_location, count, units) );
+    }
 }
 
 void Effect::bind()
@@ -658,7 +754,7 @@ Effect* Effect::getCurrentEffect()
 }
 
 Uniform::Uniform() :
-    _location(-1), _type(0), _index(0), _effect(NULL)
+    _location(-1), _type(0), _index(0), _effect(NULL), _parameterVersion(0)
 {
 }
 
@@ -667,6 +763,17 @@ Uniform::~Uniform()
     // hidden
 }
 
+bool Uniform::updateValue(const void* value, size_t size)
+{
+    // Uniform values are kept by the program, so a value equal to the last one sent is skipped.
+    _parameterVersion = 0;
+    if (_value.size() == size && (size == 0 || memcmp(&_value[0], value, size) == 0))
+        return false;
+
+    _value.assign((const unsigned char*)value, (const unsigned char*)value + size);
+    return true;
+}
+
 Effect* Uniform::getEffect() const
 {
     return _effect;
@@ -7,6 +7,7 @@
 #include "Vector4.h"
 #include "Matrix.h"
 #include "Texture.h"
+#include "ProgramCache.h"
 
 namespace gameplay
 {
@@ -25,6 +26,8 @@ class Uniform;
  */
 class Effect: public Ref
 {
+    friend class ResourceLoader;
+
 public:
 
     /**
@@ -239,7 +242,56 @@ private:
      */
     Effect& operator=(const Effect&);
 
-    static Effect* createFromSource(const char* vshPath, const char* vshSource, const char* fshPath, const char* fshSource, const char* defines = NULL);
+    /**
+     * The shader sources of an effect, preprocessed with its defines and included files.
+     */
+    struct Source
+    {
+        Source() : valid(false) {}
+
+        std::string defines;
+        std::string vsh;
+        std::string fsh;
+        ProgramCache::Binary binary;    // Binary read from the program cache, empty if none.
+        bool valid;                     // Whether the shaders were read.
+    };
+
+    /**
+     * Creates an effect from files, from their preprocessed sources when a loader thread read them.
+     *
+     * @param source The preprocessed sources, or NULL to read them.
+     */
+    static Effect* createFromFile(const char* vshPath, const char* fshPath, const char* defines, const Source* source);
+
+    /**
+     * Creates an effect from preprocessed sources, loading its program from the program cache
+     * instead of compiling it when the cache holds it.
+     *
+     * @param vshPath The path of the vertex shader, NULL if the sources are not from files.
+     * @param fshPath The path of the fragment shader, NULL if the sources are not from files.
+     * @param source The preprocessed sources.
+     */
+    static Effect* createFromSource(const char* vshPath, const char* fshPath, const Source& source);
+
+    /**
+     * Compiles the shaders of preprocessed sources and links them.
+     *
+     * @return The linked program, or 0 if the shaders failed to compile or link.
+     */
+    static GLuint compileProgram(const char* vshPath, const char* fshPath, const Source& source);
+
+    /**
+     * Builds the #define lines of the given defines and of the game config, which reads the
+     * config and must be called on the main thread.
+     */
+    static void replaceDefines(const char* defines, std::string& out);
+
+    /**
+     * Reads the shaders of an effect and the files they include, which is safe on a loader thread.
+     *
+     * @return true if the shaders were read, false otherwise.
+     */
+    static bool readSource(const char* vshPath, const char* fshPath, Source* source);
 
     GLuint _program;
     std::string _id;
@@ -254,6 +306,7 @@ private:
 class Uniform
 {
     friend class Effect;
+    friend class MaterialParameter;
 
 public:
 
@@ -300,11 +353,23 @@ private:
      */
     Uniform& operator=(const Uniform&);
 
+    /**
+     * Stores the value about to be sent to the uniform.
+     *
+     * @param value The value.
+     * @param size The size of the value in bytes.
+     *
+     * @return true if the value differs from the one the program already holds.
+     */
+    bool updateValue(const void* value, size_t size);
+
     std::string _name;
     GLint _location;
     GLenum _type;
     unsigned int _index;
     Effect* _effect;
+    std::vector<unsigned char> _value;          // Last value sent to the program, empty if unknown.
+    unsigned long long _parameterVersion;       // Version of the material parameter the value comes from, 0 if unknown.
 };
 
 }
@@ -29,6 +29,9 @@
     #define __EXT_POSIX2
     #include <libgen.h>
     #include <dirent.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
     #define gp_stat stat
     #define gp_stat_struct struct stat
 #endif
@@ -157,6 +160,50 @@ private:
     bool _canWrite;
 };
 
+/**
+ * A read-only stream over a file mapped in memory.
+ *
+ * Reads copy the mapped bytes without system calls, and map() exposes them for use in place.
+ *
+ * @script{ignore}
+ */
+class MappedFileStream : public Stream
+{
+public:
+    friend class FileSystem;
+
+    ~MappedFileStream();
+    virtual bool canRead();
+    virtual bool canWrite();
+    virtual bool canSeek();
+    virtual void close();
+    virtual size_t read(void* ptr, size_t size, size_t count);
+    virtual char* readLine(char* str, int num);
+    virtual size_t write(const void* ptr, size_t size, size_t count);
+    virtual bool eof();
+    virtual size_t length();
+    virtual long int position();
+    virtual bool seek(long int offset, int origin);
+    virtual bool rewind();
+    virtual const void* map();
+
+    static MappedFileStream* create(const char* filePath);
+
+#ifndef WIN32
+    static MappedFileStream* create(int fd, off_t offset, size_t length);
+#endif
+
+private:
+    MappedFileStream(void* mapping, size_t mappingLength, const unsigned char* data, size_t length);
+
+private:
+    void* _mapping;                 // The mapped view, which starts at a page boundary before the data.
+    size_t _mappingLength;
+    const unsigned char* _data;
+    size_t _length;
+    size_t _position;
+};
+
 #ifdef __ANDROID__
 
 /**
@@ -399,7 +446,10 @@ Stream* FileSystem::open(const char* path, size_t streamMode)
     else
     {
         // First try the SD card
-        stream = FileStream::create(fullPath.c_str(), modeStr);
+        if ((streamMode & MAP) != 0)
+            stream = MappedFileStream::create(fullPath.c_str());
+        if (!stream)
+            stream = FileStream::create(fullPath.c_str(), modeStr);
 
         if (!stream)
         {
@@ -407,11 +457,31 @@ Stream* FileSystem::open(const char* path, size_t streamMode)
             fullPath = __assetPath;
             fullPath += resolvePath(path);
 
-            stream = FileStreamAndroid::create(fullPath.c_str(), modeStr);
+            // Uncompressed assets can be mapped from the descriptor of the package.
+            if ((streamMode & MAP) != 0)
+            {
+                AAsset* asset = AAssetManager_open(__assetManager, fullPath.c_str(), AASSET_MODE_RANDOM);
+                if (asset)
+                {
+                    off_t offset, length;
+                    int fd = AAsset_openFileDescriptor(asset, &offset, &length);
+                    if (fd >= 0)
+                    {
+                        stream = MappedFileStream::create(fd, offset, (size_t)length);
+                        ::close(fd);
+                    }
+                    AAsset_close(asset);
+                }
+            }
+            if (!stream)
+                stream = FileStreamAndroid::create(fullPath.c_str(), modeStr);
         }
     }
 #else
-    stream = FileStream::create(fullPath.c_str(), modeStr);
+    if ((streamMode & MAP) != 0)
+        stream = MappedFileStream::create(fullPath.c_str());
+    if (!stream)
+        stream = FileStream::create(fullPath.c_str(), modeStr);
 #endif
     for (auto it = __packages.begin(), endIt = __packages.end(); stream == NULL && it != endIt; it++)
         stream = (*it)->open(path, streamMode);
@@ -737,6 +807,198 @@ bool FileStream::rewind()
 
 ////////////////////////////////
 
+MappedFileStream::MappedFileStream(void* mapping, size_t mappingLength, const unsigned char* data, size_t length)
+    : _mapping(mapping), _mappingLength(mappingLength), _data(data), _length(length), _position(0)
+{
+}
+
+MappedFileStream::~MappedFileStream()
+{
+    if (_mapping)
+    {
+        close();
+    }
+}
+
+MappedFileStream* MappedFileStream::create(const char* filePath)
+{
+#ifdef WIN32
+    HANDLE file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    // Empty files cannot be mapped, they are read through a FileStream.
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 || (unsigned long long)size.QuadPart > (size_t)-1)
+    {
+        CloseHandle(file);
+        return NULL;
+    }
+
+    // The view keeps the file mapped after the handles are closed.
+    void* view = NULL;
+    HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping)
+    {
+        view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    if (view == NULL)
+        return NULL;
+
+    return new MappedFileStream(view, (size_t)size.QuadPart, (const unsigned char*)view, (size_t)size.QuadPart);
+#else
+    int fd = ::open(filePath, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    MappedFileStream* stream = NULL;
+    gp_stat_struct s;
+    if (fstat(fd, &s) == 0 && S_ISREG(s.st_mode))
+        stream = create(fd, 0, (size_t)s.st_size);
+    ::close(fd);
+    return stream;
+#endif
+}
+
+#ifndef WIN32
+
+MappedFileStream* MappedFileStream::create(int fd, off_t offset, size_t length)
+{
+    // Empty files cannot be mapped, they are read through a FileStream.
+    if (length == 0)
+        return NULL;
+
+    // Map from the page boundary before the data, the mapping stays valid after the descriptor is closed.
+    off_t pageOffset = offset % (off_t)sysconf(_SC_PAGESIZE);
+    size_t mappingLength = length + (size_t)pageOffset;
+    void* mapping = mmap(NULL, mappingLength, PROT_READ, MAP_PRIVATE, fd, offset - pageOffset);
+    if (mapping == MAP_FAILED)
+        return NULL;
+
+    return new MappedFileStream(mapping, mappingLength, (const unsigned char*)mapping + pageOffset, length);
+}
+
+#endif
+
+bool MappedFileStream::canRead()
+{
+    return _mapping != NULL;
+}
+
+bool MappedFileStream::canWrite()
+{
+    return false;
+}
+
+bool MappedFileStream::canSeek()
+{
+    return _mapping != NULL;
+}
+
+void MappedFileStream::close()
+{
+    if (_mapping)
+    {
+#ifdef WIN32
+        UnmapViewOfFile(_mapping);
+#else
+        munmap(_mapping, _mappingLength);
+#endif
+    }
+    _mapping = NULL;
+    _data = NULL;
+}
+
+size_t MappedFileStream::read(void* ptr, size_t size, size_t count)
+{
+    if (!_mapping || size == 0)
+        return 0;
+    count = std::min(count, (_length - _position) / size);
+    memcpy(ptr, _data + _position, size * count);
+    _position += size * count;
+    return count;
+}
+
+char* MappedFileStream::readLine(char* str, int num)
+{
+    if (!_mapping || num <= 0 || _position >= _length)
+        return NULL;
+
+    // Copy up to and including the next newline, as fgets does.
+    int i = 0;
+    while (i < num - 1 && _position < _length)
+    {
+        char c = (char)_data[_position++];
+        str[i++] = c;
+        if (c == '\n')
+            break;
+    }
+    str[i] = '\0';
+    return str;
+}
+
+size_t MappedFileStream::write(const void* ptr, size_t size, size_t count)
+{
+    return 0;
+}
+
+bool MappedFileStream::eof()
+{
+    return !_mapping || _position >= _length;
+}
+
+size_t MappedFileStream::length()
+{
+    return _length;
+}
+
+long int MappedFileStream::position()
+{
+    if (!_mapping)
+        return -1;
+    return (long int)_position;
+}
+
+bool MappedFileStream::seek(long int offset, int origin)
+{
+    if (!_mapping)
+        return false;
+
+    long int position;
+    switch (origin)
+    {
+    case SEEK_SET:
+        position = offset;
+        break;
+    case SEEK_CUR:
+        position = (long int)_position + offset;
+        break;
+    case SEEK_END:
+        position = (long int)_length + offset;
+        break;
+    default:
+        return false;
+    }
+    if (position < 0 || (size_t)position > _length)
+        return false;
+    _position = (size_t)position;
+    return true;
+}
+
+bool MappedFileStream::rewind()
+{
+    return seek(0, SEEK_SET);
+}
+
+const void* MappedFileStream::map()
+{
+    return _data;
+}
+
+////////////////////////////////
+
 #ifdef __ANDROID__
 
 FileStreamAndroid::FileStreamAndroid(AAsset* asset)
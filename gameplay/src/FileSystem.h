@@ -34,7 +34,8 @@ public:
     enum StreamMode
     {
         READ = 1,
-        WRITE = 2
+        WRITE = 2,
+        MAP = 4     // Maps the file in memory when it is read, see Stream::map().
     };
 
     /**
@@ -162,6 +163,9 @@ public:
      * If <code>path</code> is a file path, the file at the specified location is opened relative to the currently set
      * resource path.
      *
+     * When <code>streamMode</code> includes MAP, a file opened for reading is mapped in memory when possible,
+     * so that its bytes are read without system calls and can be used in place, see Stream::map().
+     *
      * @param path The path to the resource to be opened, relative to the currently set resource path.
      * @param streamMode The stream mode used to open the file.
      * 
@@ -15,6 +15,7 @@
 #include "FileSystem.h"
 #include "Bundle.h"
 #include "Material.h"
+#include "ResourceCache.h"
 
 // Default font shaders
 #define FONT_VSH "res/shaders/font.vert"
@@ -24,7 +25,8 @@
 namespace gameplay
 {
 
-static std::vector<Font*> __fontCache;
+// ID of the first object of the font bundles, which is that of the fonts created without an ID.
+static std::unordered_map<std::string, std::string> __firstFontIds;
 
 static Effect* __fontEffect = NULL;
 static Effect* __fontEffectAlpha = NULL;
@@ -36,13 +38,6 @@ Font::Font() :
 
 Font::~Font()
 {
-    // Remove this Font from the font cache.
-    std::vector<Font*>::iterator itr = std::find(__fontCache.begin(), __fontCache.end(), this);
-    if (itr != __fontCache.end())
-    {
-        __fontCache.erase(itr);
-    }
-
     SAFE_DELETE(_batch);
     SAFE_DELETE_ARRAY(_glyphs);
     SAFE_RELEASE(_texture);
@@ -59,16 +54,23 @@ Font* Font::create(const char* path, const char* id)
     GP_ASSERT(path);
 
     // Search the font cache for a font with the given path and ID.
-    for (size_t i = 0, count = __fontCache.size(); i < count; ++i)
+    std::string key = path;
+    key += '#';
+    if (id)
     {
-        Font* f = __fontCache[i];
-        GP_ASSERT(f);
-        if (f->_path == path && (id == NULL || f->_id == id))
-        {
-            // Found a match.
-            f->addRef();
-            return f;
-        }
+        key += id;
+    }
+    else
+    {
+        std::unordered_map<std::string, std::string>::const_iterator itr = __firstFontIds.find(path);
+        if (itr != __firstFontIds.end())
+            key += itr->second;
+    }
+    Font* font = static_cast<Font*>(ResourceCache::find(ResourceCache::FONT, key.c_str()));
+    if (font)
+    {
+        // Found a match.
+        return font;
     }
 
     // Load the bundle.
@@ -79,30 +81,45 @@ Font* Font::create(const char* path, const char* id)
         return NULL;
     }
 
-    Font* font = NULL;
     if (id == NULL)
     {
         // Get the ID of the first object in the bundle (assume it's a Font).
-        const char* id;
         if ((id = bundle->getObjectId(0)) == NULL)
         {
             GP_WARN("Failed to load font without explicit id; the first object in the font bundle has a null id.");
+            SAFE_RELEASE(bundle);
             return NULL;
         }
 
-        // Load the font using the ID of the first object in the bundle.
-        font = bundle->loadFont(bundle->getObjectId(0));
-    }
-    else
-    {
-        // Load the font with the given ID.
-        font = bundle->loadFont(id);
+        // The font may have been loaded with its explicit ID.
+        if (__firstFontIds.find(path) == __firstFontIds.end())
+        {
+            __firstFontIds[path] = id;
+            key += id;
+            font = static_cast<Font*>(ResourceCache::find(ResourceCache::FONT, key.c_str()));
+            if (font)
+            {
+                SAFE_RELEASE(bundle);
+                return font;
+            }
+        }
     }
 
+    // Load the font with the given ID, or that of the first object in the bundle.
+    font = bundle->loadFont(id);
     if (font)
     {
-        // Add this font to the cache.
-        __fontCache.push_back(font);
+        // Add this font to the cache, with the glyphs and textures of all its sizes.
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+        for (size_t i = 0, count = font->_sizes.size(); i <= count; ++i)
+        {
+            Font* size = i < count ? font->_sizes[i] : font;
+            cpuBytes += size->_glyphCount * sizeof(Glyph);
+            if (size->_texture)
+                gpuBytes += size->_texture->getMemorySize();
+        }
+        ResourceCache::add(ResourceCache::FONT, key.c_str(), font, cpuBytes, gpuBytes);
     }
 
     SAFE_RELEASE(bundle);
@@ -16,6 +16,7 @@
 #include "HorizontalLayout.h"
 #include "Game.h"
 #include "Theme.h"
+#include "TextureAtlas.h"
 #include "Label.h"
 #include "Button.h"
 #include "CheckBox.h"
@@ -39,6 +40,8 @@ static std::vector<Form*> __forms;
 static Control* __focusControl = NULL;
 static Control* __activeControl[Touch::MAX_TOUCH_POINTS];
 static bool __shiftKeyDown = false;
+static TextureAtlas* __textureAtlas = NULL;
+static unsigned int __textureAtlasForms = 0;
 
 /**
  * Static initializer for forms.
@@ -53,7 +56,7 @@ struct FormInit
 };
 static FormInit __init;
 
-Form::Form() : Drawable(), _batched(true)
+Form::Form() : Drawable(), _batched(true), _textureAtlas(NULL)
 {
 }
 
@@ -65,6 +68,8 @@ Form::~Form()
     {
         __forms.erase(it);
     }
+
+    setTextureAtlas(NULL);
 }
 
 Form* Form::create(const char* url)
@@ -114,6 +119,14 @@ Form* Form::create(const char* url)
 
     form->_batched = formProperties->getBool("batchingEnabled", true);
 
+    // Share the default texture atlas between the forms that enable it.
+    if (formProperties->getBool("textureAtlas", false))
+    {
+        if (__textureAtlas == NULL)
+            __textureAtlas = TextureAtlas::create();
+        form->setTextureAtlas(__textureAtlas);
+    }
+
     // Initialize the form and all of its child controls
     form->initialize("Form", style, formProperties);
 
@@ -301,6 +314,35 @@ void Form::setBatchingEnabled(bool enabled)
     _batched = enabled;
 }
 
+TextureAtlas* Form::getTextureAtlas() const
+{
+    return _textureAtlas;
+}
+
+void Form::setTextureAtlas(TextureAtlas* atlas)
+{
+    if (atlas == _textureAtlas)
+        return;
+
+    if (atlas)
+    {
+        atlas->addRef();
+        if (atlas == __textureAtlas)
+            ++__textureAtlasForms;
+    }
+
+    if (_textureAtlas)
+    {
+        // Release the default atlas when the last form using it stops, the images
+        // packed in it keep it alive until they are destroyed.
+        if (_textureAtlas == __textureAtlas && --__textureAtlasForms == 0)
+            SAFE_RELEASE(__textureAtlas);
+        _textureAtlas->release();
+    }
+
+    _textureAtlas = atlas;
+}
+
 void Form::updateInternal(float elapsedTime)
 {
     pollGamepads();
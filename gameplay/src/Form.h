@@ -16,6 +16,7 @@ namespace gameplay
 {
 
 class Theme;
+class TextureAtlas;
 
 /**
  * Defines a form that is a root container that contains zero or more controls.
@@ -140,6 +141,27 @@ public:
      */
     void setBatchingEnabled(bool enabled);
 
+    /**
+     * Gets the texture atlas the images of this form are packed in.
+     *
+     * @return The texture atlas, or NULL if the images of this form are drawn from their own textures.
+     * @script{ignore}
+     */
+    TextureAtlas* getTextureAtlas() const;
+
+    /**
+     * Sets the texture atlas the images of this form are packed in.
+     *
+     * The images of image controls are packed in the atlas when they are first drawn, and drawn
+     * with the sprite batch of their atlas page. Images of the same page are then drawn in a
+     * single draw call, instead of one draw call for each image. Forms created with the
+     * 'textureAtlas' property set to true share a default atlas.
+     *
+     * @param atlas The texture atlas, or NULL to draw the images from their own textures.
+     * @script{ignore}
+     */
+    void setTextureAtlas(TextureAtlas* atlas);
+
 private:
     
     /**
@@ -279,6 +301,7 @@ private:
     mutable Matrix _projectionMatrix;           // Projection matrix to be set on SpriteBatch objects when rendering the form
     mutable std::vector<SpriteBatch*> _batches;
     bool _batched;
+    TextureAtlas* _textureAtlas;
 };
 
 }
@@ -18,6 +18,8 @@
 #include "ControlFactory.h"
 #include "Theme.h"
 #include "Form.h"
+#include "ResourceCache.h"
+#include "ProgramCache.h"
 
 /** @script{ignore} */
 GLenum __gl_error_code = GL_NO_ERROR;
@@ -77,7 +79,7 @@ Game::Game()
       _animationController(NULL), _audioController(NULL),
       _physicsController(NULL), _aiController(NULL), _audioListener(NULL),
       _timeEvents(NULL), _scriptController(NULL), _scriptTarget(NULL),
-      _clearColor(0.0f, 0.0f, 0.0f, 0.0f), _storeController(NULL)
+      _clearColor(0.0f, 0.0f, 0.0f, 0.0f), _storeController(NULL), _jobScheduler(NULL), _resourceLoader(NULL)
 {
     GP_ASSERT(__gameInstance == NULL);
 
@@ -183,6 +185,38 @@ bool Game::startup()
     RenderState::initialize();
     FrameBuffer::initialize();
 
+    int workerCount = -1;
+    if (_properties && _properties->exists("jobWorkerCount"))
+        workerCount = _properties->getInt("jobWorkerCount");
+    if (workerCount < 0)
+        workerCount = std::max((int)std::thread::hardware_concurrency() - 1, 0);
+    _jobScheduler = new JobScheduler((unsigned int)workerCount);
+
+    int loaderThreadCount = 1;
+    float loaderFrameBudget = 4.0f;
+    if (_properties)
+    {
+        if (_properties->exists("resourceLoaderThreadCount"))
+            loaderThreadCount = std::max(_properties->getInt("resourceLoaderThreadCount"), 1);
+        if (_properties->exists("resourceLoaderFrameBudget"))
+            loaderFrameBudget = _properties->getFloat("resourceLoaderFrameBudget");
+    }
+    _resourceLoader = new ResourceLoader((unsigned int)loaderThreadCount, loaderFrameBudget);
+
+    // Budget of the unused resources kept in the caches, in megabytes.
+    if (_properties && _properties->exists("resourceCacheBudget"))
+        ResourceCache::setBudget((size_t)(std::max(_properties->getFloat("resourceCacheBudget"), 0.0f) * 1024.0f * 1024.0f));
+
+    // Directory of the program binaries saved by effects, and manifest of the effects to load in the background.
+    Properties* graphicsConfig = _properties ? _properties->getNamespace("graphics", true) : NULL;
+    if (graphicsConfig)
+    {
+        ProgramCache::setDirectory(graphicsConfig->getString("programCachePath"));
+        const char* manifestPath = graphicsConfig->getString("programCacheManifest");
+        if (manifestPath && strlen(manifestPath) > 0)
+            ProgramCache::prewarm(manifestPath);
+    }
+
     _animationController = new AnimationController();
     _animationController->initialize();
 
@@ -316,10 +350,18 @@ void Game::shutdown()
         _storeController->finalize();
         SAFE_DELETE(_storeController);
 
+        SAFE_DELETE(_resourceLoader);
+        SAFE_DELETE(_jobScheduler);
+
         ControlFactory::finalize();
 
         Theme::finalize();
 
+        ProgramCache::releaseEffects();
+
+        // Destroy the cached resources that are not used anymore.
+        ResourceCache::clear();
+
         // Note: we do not clean up the script controller here
         // because users can call Game::exit() from a script.
 
@@ -425,6 +467,13 @@ void Game::frame()
     // Fire time events to scheduled TimeListeners
     fireTimeEvents(frameTime);
 
+    // Complete the resources loaded in the background.
+    if (_resourceLoader)
+        _resourceLoader->update();
+
+    // Evict the cached resources released since the last frame, if they exceed the budget.
+    ResourceCache::trim();
+
     if (_state == Game::RUNNING)
     {
         GP_ASSERT(_animationController);
@@ -434,6 +483,11 @@ void Game::frame()
         float elapsedTime = (frameTime - lastFrameTime);
         lastFrameTime = frameTime;
 
+        // Animations, physics, AI, gamepads, forms and scripts invoke listeners and scripts and
+        // change the scene, so they are updated in order on this thread. Animations evaluate
+        // their curves on the job scheduler, physics reads the animated transforms and AI
+        // reads the simulated ones.
+
         // Update the scheduled and running animations.
         _animationController->update(elapsedTime);
 
@@ -457,15 +511,8 @@ void Game::frame()
         if (_scriptTarget)
             _scriptTarget->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(GameScriptTarget, update), elapsedTime);
 
-        // Audio Rendering.
-        if (_audioController)
-            _audioController->update(elapsedTime);
-
-        // Social Update.
-        _socialController->update(elapsedTime);
-
-        // Storefront Update.
-        _storeController->update(elapsedTime);
+        // Audio Rendering, Social and Storefront Update.
+        updateServices(elapsedTime);
 
         // Graphics Rendering.
         render(elapsedTime);
@@ -507,6 +554,38 @@ void Game::frame()
     }
 }
 
+void Game::updateServices(float elapsedTime)
+{
+    GP_ASSERT(_jobScheduler);
+
+    // The audio listener is only written by the updates above and by rendering, so once
+    // the scripts are updated it is pushed to OpenAL on a worker while the social and store
+    // controllers, which may call listeners, update on this thread. All of them finish
+    // before rendering.
+    JobScheduler::Job* root = _jobScheduler->createJob(JobScheduler::Function());
+
+    if (_audioController)
+    {
+        _jobScheduler->submit(_jobScheduler->createJob([this, elapsedTime]() {
+            _audioController->update(elapsedTime);
+        }, root));
+    }
+
+    // The storefront keeps updating after the social controller, as it always did.
+    JobScheduler::Job* socialJob = _jobScheduler->createJob([this, elapsedTime]() {
+        _socialController->update(elapsedTime);
+    }, root, JobScheduler::MAIN_THREAD);
+    JobScheduler::Job* storeJob = _jobScheduler->createJob([this, elapsedTime]() {
+        _storeController->update(elapsedTime);
+    }, root, JobScheduler::MAIN_THREAD);
+    _jobScheduler->addDependency(storeJob, socialJob);
+
+    _jobScheduler->submit(socialJob);
+    _jobScheduler->submit(storeJob);
+    _jobScheduler->submit(root);
+    _jobScheduler->wait(root);
+}
+
 void Game::renderOnce(const char* function)
 {
     if (_scriptController)
@@ -22,6 +22,8 @@
 #include "SocialController.h"
 #include "storefront/StoreController.h"
 #include "AIController.h"
+#include "JobScheduler.h"
+#include "ResourceLoader.h"
 #include "AudioListener.h"
 #include "Rectangle.h"
 #include "Vector4.h"
@@ -310,6 +312,32 @@ public:
      */
     inline StoreController* getStoreController() const;
 
+    /**
+     * Gets the job scheduler used to run work on the worker threads.
+     *
+     * The number of worker threads is set by the "jobWorkerCount" game config property.
+     * Negative value (the default) starts one worker per hardware thread minus one.
+     *
+     * @return The job scheduler for this game.
+     *
+     * @script{ignore}
+     */
+    inline JobScheduler* getJobScheduler() const;
+
+    /**
+     * Gets the resource loader used to load resources in the background.
+     *
+     * The number of loader threads is set by the "resourceLoaderThreadCount" game config
+     * property (1 by default), and the time the main thread spends each frame completing
+     * the loaded resources by the "resourceLoaderFrameBudget" property, in milliseconds
+     * (4 by default).
+     *
+     * @return The resource loader for this game.
+     *
+     * @script{ignore}
+     */
+    inline ResourceLoader* getResourceLoader() const;
+
     /**
      * Gets the audio listener for 3D audio.
      * 
@@ -814,6 +842,13 @@ private:
      */
     void fireTimeEvents(double frameTime);
 
+    /**
+     * Updates the audio, social and store controllers on the job scheduler.
+     *
+     * @param elapsedTime The elapsed game time.
+     */
+    void updateServices(float elapsedTime);
+
     /**
      * Loads the game configuration.
      */
@@ -862,6 +897,8 @@ private:
     ScriptTarget* _scriptTarget;                // Script target for the game
     SocialController* _socialController;		// Controls social aspect of the game.
     StoreController* _storeController;          // Controls storefront and IAPs.
+    JobScheduler* _jobScheduler;                // Runs jobs on the worker threads.
+    ResourceLoader* _resourceLoader;            // Loads resources on the loader threads.
 
     // Note: Do not add STL object member variables on the stack; this will cause false memory leaks to be reported.
 
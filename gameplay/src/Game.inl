@@ -73,6 +73,16 @@ inline StoreController* Game::getStoreController() const
     return _storeController;
 }
 
+inline JobScheduler* Game::getJobScheduler() const
+{
+    return _jobScheduler;
+}
+
+inline ResourceLoader* Game::getResourceLoader() const
+{
+    return _resourceLoader;
+}
+
 template <class T>
 void Game::renderOnce(T* instance, void (T::*method)(void*), void* cookie)
 {
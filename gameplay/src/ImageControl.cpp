@@ -11,19 +11,21 @@
 #include "Base.h"
 #include "ImageControl.h"
 #include "Material.h"
+#include "Form.h"
 
 namespace gameplay
 {
 
 ImageControl::ImageControl() :
     _srcRegion(Rectangle::empty()), _dstRegion(Rectangle::empty()), _batch(NULL),
-    _tw(0.0f), _th(0.0f), _uvs(Theme::UVs::full()), _color(Vector4::one())
+    _tw(0.0f), _th(0.0f), _uvs(Theme::UVs::full()), _color(Vector4::one()), _atlas(NULL), _region(NULL)
 {
 }
 
 ImageControl::~ImageControl()
 {
     SAFE_DELETE(_batch);
+    SAFE_RELEASE(_atlas);
 }
 
 ImageControl* ImageControl::create(const char* id, Theme::Style* style)
@@ -84,6 +86,9 @@ const char* ImageControl::getTypeName() const
 void ImageControl::setImage(const char* path)
 {
     SAFE_DELETE(_batch);
+    SAFE_RELEASE(_atlas);
+    _region = NULL;
+    _path.clear();
 
     // check for '.material' extension
     std::string pathString(path);
@@ -102,6 +107,7 @@ void ImageControl::setImage(const char* path)
     {
         Texture* texture = Texture::create(path);
         _batch = SpriteBatch::create(texture);
+        _path = path;
         _tw = 1.0f / texture->getWidth();
         _th = 1.0f / texture->getHeight();
         texture->release();
@@ -153,24 +159,52 @@ unsigned int ImageControl::drawImages(Form* form) const
     if (!_batch)
         return 0;
 
-    startBatch(form, _batch);
+    SpriteBatch* batch = _batch;
+    Theme::UVs uvs = _uvs;
+
+    // Draw from the texture atlas of the form when the image is packed in it,
+    // sharing the sprite batch of its page with the other images of the form.
+    TextureAtlas* atlas = form->getTextureAtlas();
+    if (atlas && !_path.empty())
+    {
+        if (atlas != _atlas)
+        {
+            SAFE_RELEASE(_atlas);
+            _atlas = atlas;
+            _atlas->addRef();
+            _region = _atlas->add(_path.c_str());
+        }
+
+        if (_region)
+        {
+            batch = _atlas->getSpriteBatch(_region->page);
+            float du = _region->u2 - _region->u1;
+            float dv = _region->v2 - _region->v1;
+            uvs.u1 = _region->u1 + _uvs.u1 * du;
+            uvs.u2 = _region->u1 + _uvs.u2 * du;
+            uvs.v1 = _region->v1 + _uvs.v1 * dv;
+            uvs.v2 = _region->v1 + _uvs.v2 * dv;
+        }
+    }
+
+    startBatch(form, batch);
 
     Vector4 color = _color;
     color.w *= _opacity;
 
     if (_dstRegion.isEmpty())
     {
-        _batch->draw(_viewportBounds.x, _viewportBounds.y, _viewportBounds.width, _viewportBounds.height,
-            _uvs.u1, _uvs.v1, _uvs.u2, _uvs.v2, color, _viewportClipBounds);
+        batch->draw(_viewportBounds.x, _viewportBounds.y, _viewportBounds.width, _viewportBounds.height,
+            uvs.u1, uvs.v1, uvs.u2, uvs.v2, color, _viewportClipBounds);
     }
     else
     {
-        _batch->draw(_viewportBounds.x + _dstRegion.x, _viewportBounds.y + _dstRegion.y,
+        batch->draw(_viewportBounds.x + _dstRegion.x, _viewportBounds.y + _dstRegion.y,
             _dstRegion.width, _dstRegion.height,
-            _uvs.u1, _uvs.v1, _uvs.u2, _uvs.v2, color, _viewportClipBounds);
+            uvs.u1, uvs.v1, uvs.u2, uvs.v2, color, _viewportClipBounds);
     }
 
-    finishBatch(form, _batch);
+    finishBatch(form, batch);
 
     return 1;
 }
@@ -5,6 +5,7 @@
 #include "Theme.h"
 #include "Image.h"
 #include "SpriteBatch.h"
+#include "TextureAtlas.h"
 #include "Rectangle.h"
 
 namespace gameplay
@@ -15,6 +16,9 @@ namespace gameplay
  *
  * This allows forms to display seperate images from arbitrary files not specified in the theme.
  *
+ * When the form of the control has a texture atlas, PNG and JPEG images are packed in the atlas
+ * and drawn with the sprite batch of their atlas page, shared with the other images of the form.
+ *
  * @see http://gameplay3d.github.io/GamePlay/docs/file-formats.html#wiki-UI_Forms
  */
 class ImageControl : public Control
@@ -176,6 +180,12 @@ protected:
     
     // Calculated UVs.
     Theme::UVs _uvs;
+
+    // Path of the image, empty for images that cannot be packed in a texture atlas.
+    std::string _path;
+    // Texture atlas the image was last packed in, and its region in the atlas.
+    mutable TextureAtlas* _atlas;
+    mutable const TextureAtlas::Region* _region;
 };
 
 }
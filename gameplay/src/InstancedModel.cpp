@@ -0,0 +1,656 @@
+#include "Base.h"
+#include "InstancedModel.h"
+#include "MeshPart.h"
+#include "Material.h"
+#include "Technique.h"
+#include "Pass.h"
+#include "Effect.h"
+#include "VertexAttributeBinding.h"
+#include "Node.h"
+
+// Number of floats of the transform of an instance, the three rows of a 4x3 matrix.
+#define INSTANCE_TRANSFORM_SIZE 12
+
+// Maximum number of instances drawn by a draw call when the vertices are transformed on the CPU.
+#define INSTANCED_MODEL_MAX_BATCH_INSTANCES 1024
+
+namespace gameplay
+{
+
+static const char* __instanceAttributeNames[] =
+{
+    VERTEX_ATTRIBUTE_INSTANCE_MATRIX_PREFIX_NAME "0",
+    VERTEX_ATTRIBUTE_INSTANCE_MATRIX_PREFIX_NAME "1",
+    VERTEX_ATTRIBUTE_INSTANCE_MATRIX_PREFIX_NAME "2",
+    VERTEX_ATTRIBUTE_INSTANCE_DATA_NAME
+};
+
+InstancedModel::InstancedModel(Model* model, unsigned int customDataSize)
+    : _model(model), _customDataSize(customDataSize), _instanceBuffer(0), _instanceBufferDirty(true), _boundsDirty(true),
+      _meshData(NULL), _meshDataLoaded(false), _batchedVerticesDirty(true)
+{
+    GP_ASSERT(_model);
+    _model->addRef();
+}
+
+InstancedModel::~InstancedModel()
+{
+    for (std::map<std::pair<Effect*, unsigned int>, VertexAttributeBinding*>::iterator itr = _batchedBindings.begin(); itr != _batchedBindings.end(); ++itr)
+    {
+        SAFE_RELEASE(itr->second);
+    }
+    _batchedBindings.clear();
+    SAFE_DELETE(_meshData);
+
+    if (_instanceBuffer)
+    {
+        GL_ASSERT( glDeleteBuffers(1, &_instanceBuffer) );
+        _instanceBuffer = 0;
+    }
+
+    SAFE_RELEASE(_model);
+}
+
+InstancedModel* InstancedModel::create(Model* model, unsigned int customDataSize)
+{
+    GP_ASSERT(model);
+
+    if (model->getMesh() == NULL)
+    {
+        GP_ERROR("Failed to create instanced model; the model has no mesh.");
+        return NULL;
+    }
+    if (customDataSize > 4)
+    {
+        GP_ERROR("Invalid custom data size (%d); instances have at most 4 floats of custom data.", customDataSize);
+        return NULL;
+    }
+
+    return new InstancedModel(model, customDataSize);
+}
+
+Model* InstancedModel::getModel() const
+{
+    return _model;
+}
+
+unsigned int InstancedModel::getCustomDataSize() const
+{
+    return _customDataSize;
+}
+
+unsigned int InstancedModel::addInstance(const Matrix& transform, const float* customData)
+{
+    unsigned int index = (unsigned int)_transforms.size();
+    _transforms.push_back(transform);
+    _instanceData.resize(_instanceData.size() + INSTANCE_TRANSFORM_SIZE + _customDataSize, 0.0f);
+    setInstance(index, transform, customData);
+    return index;
+}
+
+void InstancedModel::setInstance(unsigned int index, const Matrix& transform, const float* customData)
+{
+    GP_ASSERT(index < _transforms.size());
+
+    _transforms[index] = transform;
+
+    // Matrices are stored in column major order, the instance data holds their first three rows.
+    float* data = &_instanceData[index * (INSTANCE_TRANSFORM_SIZE + _customDataSize)];
+    for (unsigned int row = 0; row < 3; ++row)
+    {
+        for (unsigned int column = 0; column < 4; ++column)
+        {
+            data[row * 4 + column] = transform.m[column * 4 + row];
+        }
+    }
+    if (customData && _customDataSize > 0)
+    {
+        memcpy(data + INSTANCE_TRANSFORM_SIZE, customData, _customDataSize * sizeof(float));
+    }
+
+    setDirty();
+}
+
+const Matrix& InstancedModel::getInstanceTransform(unsigned int index) const
+{
+    GP_ASSERT(index < _transforms.size());
+    return _transforms[index];
+}
+
+void InstancedModel::removeInstance(unsigned int index)
+{
+    GP_ASSERT(index < _transforms.size());
+
+    const unsigned int stride = INSTANCE_TRANSFORM_SIZE + _customDataSize;
+    const unsigned int last = (unsigned int)_transforms.size() - 1;
+    if (index != last)
+    {
+        _transforms[index] = _transforms[last];
+        memcpy(&_instanceData[index * stride], &_instanceData[last * stride], stride * sizeof(float));
+    }
+    _transforms.pop_back();
+    _instanceData.resize(last * stride);
+
+    setDirty();
+}
+
+void InstancedModel::removeAllInstances()
+{
+    _transforms.clear();
+    _instanceData.clear();
+
+    setDirty();
+}
+
+unsigned int InstancedModel::getInstanceCount() const
+{
+    return (unsigned int)_transforms.size();
+}
+
+const BoundingSphere& InstancedModel::getBoundingSphere() const
+{
+    if (_boundsDirty)
+    {
+        _boundsDirty = false;
+
+        const BoundingSphere& meshBounds = _model->getMesh()->getBoundingSphere();
+        _bounds.set(Vector3::zero(), 0.0f);
+        for (size_t i = 0, count = _transforms.size(); i < count; ++i)
+        {
+            BoundingSphere bounds(meshBounds);
+            bounds.transform(_transforms[i]);
+            if (i == 0)
+                _bounds.set(bounds);
+            else
+                _bounds.merge(bounds);
+        }
+    }
+    return _bounds;
+}
+
+bool InstancedModel::isHardwareInstancingSupported()
+{
+#if defined(GP_USE_INSTANCING) && defined(GP_LOAD_GL_EXTENSIONS)
+    // The entry points are loaded at runtime, and only when the driver has the extension.
+    return glDrawElementsInstanced != NULL && glDrawArraysInstanced != NULL && glVertexAttribDivisor != NULL;
+#elif defined(GP_USE_INSTANCING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+unsigned int InstancedModel::draw(bool wireframe) const
+{
+    GP_ASSERT(_model);
+    Mesh* mesh = _model->getMesh();
+    GP_ASSERT(mesh);
+
+    if (_transforms.empty())
+        return 0;
+
+    unsigned int drawCalls = 0;
+    unsigned int partCount = mesh->getPartCount();
+    if (partCount == 0)
+    {
+        Material* material = _model->getMaterial();
+        if (material)
+        {
+            Technique* technique = material->getTechnique();
+            GP_ASSERT(technique);
+            for (unsigned int i = 0, passCount = technique->getPassCount(); i < passCount; ++i)
+            {
+                drawCalls += drawPart(NULL, 0, technique->getPassByIndex(i));
+            }
+        }
+    }
+    else
+    {
+        for (unsigned int i = 0; i < partCount; ++i)
+        {
+            MeshPart* part = mesh->getPart(i);
+            GP_ASSERT(part);
+            Material* material = _model->getMaterial(i);
+            if (material)
+            {
+                Technique* technique = material->getTechnique();
+                GP_ASSERT(technique);
+                for (unsigned int j = 0, passCount = technique->getPassCount(); j < passCount; ++j)
+                {
+                    drawCalls += drawPart(part, i, technique->getPassByIndex(j));
+                }
+            }
+        }
+    }
+    return drawCalls;
+}
+
+void InstancedModel::setNode(Node* node)
+{
+    Drawable::setNode(node);
+
+    // The model binds the node related material parameters to the node.
+    _model->setNode(node);
+}
+
+Drawable* InstancedModel::clone(NodeCloneContext& context)
+{
+    Model* modelClone = static_cast<Model*>(_model->clone(context));
+    if (!modelClone)
+    {
+        GP_ERROR("Failed to clone the model of an instanced model.");
+        return NULL;
+    }
+
+    InstancedModel* instancedModel = new InstancedModel(modelClone, _customDataSize);
+    modelClone->release();
+    instancedModel->_transforms = _transforms;
+    instancedModel->_instanceData = _instanceData;
+    return instancedModel;
+}
+
+void InstancedModel::setDirty()
+{
+    _instanceBufferDirty = true;
+    _batchedVerticesDirty = true;
+    _boundsDirty = true;
+
+    if (_node)
+    {
+        _node->setBoundsDirty();
+    }
+}
+
+unsigned int InstancedModel::drawPart(MeshPart* part, unsigned int partIndex, Pass* pass) const
+{
+    GP_ASSERT(pass);
+    Effect* effect = pass->getEffect();
+    GP_ASSERT(effect);
+
+    if (isHardwareInstancingSupported() && effect->getVertexAttribute(__instanceAttributeNames[0]) != -1)
+    {
+        return drawHardware(part, pass);
+    }
+    if (loadMeshData())
+    {
+        return drawBatched(part, partIndex, pass);
+    }
+    return drawSingle(part, pass);
+}
+
+unsigned int InstancedModel::drawHardware(MeshPart* part, Pass* pass) const
+{
+#ifdef GP_USE_INSTANCING
+    const GLsizei stride = (INSTANCE_TRANSFORM_SIZE + _customDataSize) * sizeof(float);
+    const GLsizei instanceCount = (GLsizei)_transforms.size();
+
+    if (_instanceBuffer == 0)
+    {
+        GL_ASSERT( glGenBuffers(1, &_instanceBuffer) );
+        _instanceBufferDirty = true;
+    }
+    if (_instanceBufferDirty)
+    {
+        // Orphan the previous storage so the upload does not wait for the draw calls still reading it.
+        GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer) );
+        GL_ASSERT( glBufferData(GL_ARRAY_BUFFER, instanceCount * stride, NULL, GL_STREAM_DRAW) );
+        GL_ASSERT( glBufferSubData(GL_ARRAY_BUFFER, 0, instanceCount * stride, &_instanceData[0]) );
+        _instanceBufferDirty = false;
+    }
+
+    Effect* effect = pass->getEffect();
+    pass->bind();
+
+    // The instance attributes are added to the vertex attribute binding of the pass for the
+    // draw call and removed after it.
+    VertexAttribute attributes[4];
+    GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer) );
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        attributes[i] = (i < 3 || _customDataSize > 0) ? effect->getVertexAttribute(__instanceAttributeNames[i]) : -1;
+        if (attributes[i] != -1)
+        {
+            GLint size = i < 3 ? 4 : (GLint)_customDataSize;
+            GL_ASSERT( glVertexAttribPointer(attributes[i], size, GL_FLOAT, GL_FALSE, stride, (void*)(i * 4 * sizeof(float))) );
+            GL_ASSERT( glVertexAttribDivisor(attributes[i], 1) );
+            GL_ASSERT( glEnableVertexAttribArray(attributes[i]) );
+        }
+    }
+
+    if (part)
+    {
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, part->getIndexBuffer()) );
+        GL_ASSERT( glDrawElementsInstanced(part->getPrimitiveType(), part->getIndexCount(), part->getIndexFormat(), 0, instanceCount) );
+    }
+    else
+    {
+        Mesh* mesh = _model->getMesh();
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+        GL_ASSERT( glDrawArraysInstanced(mesh->getPrimitiveType(), 0, mesh->getVertexCount(), instanceCount) );
+    }
+
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        if (attributes[i] != -1)
+        {
+            GL_ASSERT( glVertexAttribDivisor(attributes[i], 0) );
+            GL_ASSERT( glDisableVertexAttribArray(attributes[i]) );
+        }
+    }
+
+    pass->unbind();
+    return 1;
+#else
+    return drawSingle(part, pass);
+#endif
+}
+
+unsigned int InstancedModel::drawBatched(MeshPart* part, unsigned int partIndex, Pass* pass) const
+{
+    GP_ASSERT(_meshData);
+    updateBatchedVertices();
+
+    Effect* effect = pass->getEffect();
+    const unsigned int instanceCount = (unsigned int)_transforms.size();
+    const unsigned int vertexCount = _meshData->vertexCount;
+
+    // The vertices are already transformed, effects that read the instance attributes get an identity transform.
+    effect->bind();
+    pass->RenderState::bind(pass);
+    setConstantAttributes(effect, instanceCount);
+    GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+
+    unsigned int drawCalls = 0;
+    if (part == NULL)
+    {
+        VertexAttributeBinding* binding = getBatchedBinding(effect, 0);
+        if (binding)
+        {
+            binding->bind();
+            Mesh::PrimitiveType primitiveType = _model->getMesh()->getPrimitiveType();
+            if (primitiveType == Mesh::TRIANGLE_STRIP || primitiveType == Mesh::LINE_STRIP)
+            {
+                for (unsigned int i = 0; i < instanceCount; ++i)
+                {
+                    GL_ASSERT( glDrawArrays(primitiveType, i * vertexCount, vertexCount) );
+                    ++drawCalls;
+                }
+            }
+            else
+            {
+                GL_ASSERT( glDrawArrays(primitiveType, 0, instanceCount * vertexCount) );
+                ++drawCalls;
+            }
+            binding->unbind();
+        }
+    }
+    else
+    {
+        GP_ASSERT(partIndex < _meshData->parts.size());
+        const Bundle::MeshPartData* partData = _meshData->parts[partIndex];
+        const unsigned int chunkSize = _batchedChunkSizes[partIndex];
+        const std::vector<unsigned char>& indices = _batchedIndices[partIndex];
+        const GLenum indexType = partData->indexFormat == Mesh::INDEX32 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+        if (!indices.empty())
+        {
+            for (unsigned int first = 0, chunk = 0; first < instanceCount; first += chunkSize, ++chunk)
+            {
+                VertexAttributeBinding* binding = getBatchedBinding(effect, chunk * chunkSize);
+                if (!binding)
+                    break;
+
+                unsigned int count = std::min(chunkSize, instanceCount - first);
+                binding->bind();
+                GL_ASSERT( glDrawElements(partData->primitiveType, count * partData->indexCount, indexType, &indices[0]) );
+                binding->unbind();
+                ++drawCalls;
+            }
+        }
+    }
+    return drawCalls;
+}
+
+unsigned int InstancedModel::drawSingle(MeshPart* part, Pass* pass) const
+{
+    Effect* effect = pass->getEffect();
+    pass->bind();
+    GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, part ? part->getIndexBuffer() : 0) );
+
+    const unsigned int instanceCount = (unsigned int)_transforms.size();
+    for (unsigned int i = 0; i < instanceCount; ++i)
+    {
+        setConstantAttributes(effect, i);
+        if (part)
+        {
+            GL_ASSERT( glDrawElements(part->getPrimitiveType(), part->getIndexCount(), part->getIndexFormat(), 0) );
+        }
+        else
+        {
+            Mesh* mesh = _model->getMesh();
+            GL_ASSERT( glDrawArrays(mesh->getPrimitiveType(), 0, mesh->getVertexCount()) );
+        }
+    }
+
+    pass->unbind();
+    return instanceCount;
+}
+
+void InstancedModel::setConstantAttributes(Effect* effect, unsigned int index) const
+{
+    GP_ASSERT(effect);
+
+    const unsigned int stride = INSTANCE_TRANSFORM_SIZE + _customDataSize;
+    const bool valid = index < _transforms.size();
+    for (unsigned int row = 0; row < 3; ++row)
+    {
+        VertexAttribute attribute = effect->getVertexAttribute(__instanceAttributeNames[row]);
+        if (attribute != -1)
+        {
+            float identity[4] = { row == 0 ? 1.0f : 0.0f, row == 1 ? 1.0f : 0.0f, row == 2 ? 1.0f : 0.0f, 0.0f };
+            GL_ASSERT( glVertexAttrib4fv(attribute, valid ? &_instanceData[index * stride + row * 4] : identity) );
+        }
+    }
+
+    if (_customDataSize > 0)
+    {
+        VertexAttribute attribute = effect->getVertexAttribute(__instanceAttributeNames[3]);
+        if (attribute != -1)
+        {
+            float data[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            if (valid)
+            {
+                memcpy(data, &_instanceData[index * stride + INSTANCE_TRANSFORM_SIZE], _customDataSize * sizeof(float));
+            }
+            GL_ASSERT( glVertexAttrib4fv(attribute, data) );
+        }
+    }
+}
+
+bool InstancedModel::loadMeshData() const
+{
+    if (_meshDataLoaded)
+        return _meshData != NULL;
+    _meshDataLoaded = true;
+
+    // Read the vertices back from the bundle, the vertex buffer of the mesh is write only.
+    Mesh* mesh = _model->getMesh();
+    const char* url = mesh->getUrl();
+    if (url && strlen(url) > 0)
+    {
+        _meshData = Bundle::readMeshData(url);
+    }
+    if (_meshData && (_meshData->vertexCount != mesh->getVertexCount() ||
+        _meshData->vertexFormat.getVertexSize() != mesh->getVertexFormat().getVertexSize() ||
+        _meshData->parts.size() != mesh->getPartCount()))
+    {
+        SAFE_DELETE(_meshData);
+    }
+    if (_meshData == NULL)
+    {
+        GP_WARN("Failed to read back the vertices of mesh '%s'; its instances are drawn one at a time.", url ? url : "");
+        return false;
+    }
+
+    // Build the indices of a chunk of instances for each mesh part. Indices are relative to the
+    // first vertex of the chunk, so the same indices are used for all the chunks.
+    const unsigned int vertexCount = _meshData->vertexCount;
+    _batchedIndices.resize(_meshData->parts.size());
+    _batchedChunkSizes.resize(_meshData->parts.size());
+    for (size_t i = 0, partCount = _meshData->parts.size(); i < partCount; ++i)
+    {
+        const Bundle::MeshPartData* partData = _meshData->parts[i];
+        GP_ASSERT(partData);
+
+        const bool index32 = partData->indexFormat == Mesh::INDEX32;
+        unsigned int chunkSize = 1;
+        if (partData->primitiveType != Mesh::TRIANGLE_STRIP && partData->primitiveType != Mesh::LINE_STRIP && vertexCount > 0)
+        {
+            chunkSize = index32 ? INSTANCED_MODEL_MAX_BATCH_INSTANCES : std::max(1u, 65536u / vertexCount);
+            chunkSize = std::min(chunkSize, (unsigned int)INSTANCED_MODEL_MAX_BATCH_INSTANCES);
+        }
+        _batchedChunkSizes[i] = chunkSize;
+
+        const unsigned int indexCount = partData->indexCount;
+        std::vector<unsigned char>& indices = _batchedIndices[i];
+        indices.resize(chunkSize * indexCount * (index32 ? sizeof(unsigned int) : sizeof(unsigned short)));
+        for (unsigned int instance = 0; instance < chunkSize; ++instance)
+        {
+            for (unsigned int j = 0; j < indexCount; ++j)
+            {
+                unsigned int index;
+                switch (partData->indexFormat)
+                {
+                case Mesh::INDEX8:
+                    index = ((const unsigned char*)partData->indexData)[j];
+                    break;
+                case Mesh::INDEX16:
+                    index = ((const unsigned short*)partData->indexData)[j];
+                    break;
+                default:
+                    index = ((const unsigned int*)partData->indexData)[j];
+                    break;
+                }
+                index += instance * vertexCount;
+
+                if (index32)
+                    ((unsigned int*)&indices[0])[instance * indexCount + j] = index;
+                else
+                    ((unsigned short*)&indices[0])[instance * indexCount + j] = (unsigned short)index;
+            }
+        }
+    }
+    return true;
+}
+
+void InstancedModel::updateBatchedVertices() const
+{
+    if (!_batchedVerticesDirty)
+        return;
+    _batchedVerticesDirty = false;
+
+    GP_ASSERT(_meshData);
+    const VertexFormat& vertexFormat = _meshData->vertexFormat;
+    const unsigned int vertexCount = _meshData->vertexCount;
+    const unsigned int vertexSize = vertexFormat.getVertexSize();
+    const unsigned int instanceCount = (unsigned int)_transforms.size();
+
+    // The vertex attribute bindings point into the vertices, they are recreated when they move.
+    const unsigned char* previous = _batchedVertices.empty() ? NULL : &_batchedVertices[0];
+    _batchedVertices.resize(instanceCount * vertexCount * vertexSize);
+    const unsigned char* current = _batchedVertices.empty() ? NULL : &_batchedVertices[0];
+    if (current != previous)
+    {
+        for (std::map<std::pair<Effect*, unsigned int>, VertexAttributeBinding*>::iterator itr = _batchedBindings.begin(); itr != _batchedBindings.end(); ++itr)
+        {
+            SAFE_RELEASE(itr->second);
+        }
+        _batchedBindings.clear();
+    }
+
+    // Offsets of the position, of the normal and of the tangent and binormal in a vertex, in floats.
+    int positionOffset = -1;
+    int normalOffset = -1;
+    std::vector<unsigned int> directionOffsets;
+    unsigned int offset = 0;
+    for (unsigned int i = 0, count = vertexFormat.getElementCount(); i < count; ++i)
+    {
+        const VertexFormat::Element& element = vertexFormat.getElement(i);
+        if (element.size >= 3)
+        {
+            if (element.usage == VertexFormat::POSITION)
+                positionOffset = offset;
+            else if (element.usage == VertexFormat::NORMAL)
+                normalOffset = offset;
+            else if (element.usage == VertexFormat::TANGENT || element.usage == VertexFormat::BINORMAL)
+                directionOffsets.push_back(offset);
+        }
+        offset += element.size;
+    }
+
+    for (unsigned int i = 0; i < instanceCount; ++i)
+    {
+        const Matrix& transform = _transforms[i];
+
+        // Normals are transformed by the inverse transpose, which keeps them perpendicular
+        // to the surface when the instance is scaled non-uniformly.
+        Matrix normalMatrix;
+        if (normalOffset >= 0)
+        {
+            if (!transform.invert(&normalMatrix))
+                normalMatrix = transform;
+            normalMatrix.transpose();
+        }
+
+        unsigned char* vertices = &_batchedVertices[i * vertexCount * vertexSize];
+        memcpy(vertices, _meshData->vertexData, vertexCount * vertexSize);
+
+        for (unsigned int j = 0; j < vertexCount; ++j)
+        {
+            float* vertex = (float*)(vertices + j * vertexSize);
+            if (positionOffset >= 0)
+            {
+                Vector3 position(vertex + positionOffset);
+                transform.transformPoint(&position);
+                vertex[positionOffset] = position.x;
+                vertex[positionOffset + 1] = position.y;
+                vertex[positionOffset + 2] = position.z;
+            }
+            if (normalOffset >= 0)
+            {
+                float* direction = vertex + normalOffset;
+                Vector3 normal(direction);
+                normalMatrix.transformVector(&normal);
+                normal.normalize();
+                direction[0] = normal.x;
+                direction[1] = normal.y;
+                direction[2] = normal.z;
+            }
+            for (size_t k = 0, count = directionOffsets.size(); k < count; ++k)
+            {
+                float* direction = vertex + directionOffsets[k];
+                Vector3 vector(direction);
+                transform.transformVector(&vector);
+                vector.normalize();
+                direction[0] = vector.x;
+                direction[1] = vector.y;
+                direction[2] = vector.z;
+            }
+        }
+    }
+}
+
+VertexAttributeBinding* InstancedModel::getBatchedBinding(Effect* effect, unsigned int firstInstance) const
+{
+    std::pair<Effect*, unsigned int> key(effect, firstInstance);
+    std::map<std::pair<Effect*, unsigned int>, VertexAttributeBinding*>::const_iterator itr = _batchedBindings.find(key);
+    if (itr != _batchedBindings.end())
+        return itr->second;
+
+    GP_ASSERT(_meshData);
+    void* vertices = &_batchedVertices[firstInstance * _meshData->vertexCount * _meshData->vertexFormat.getVertexSize()];
+    VertexAttributeBinding* binding = VertexAttributeBinding::create(_meshData->vertexFormat, vertices, effect);
+    _batchedBindings[key] = binding;
+    return binding;
+}
+
+}
@@ -0,0 +1,237 @@
+#ifndef INSTANCEDMODEL_H_
+#define INSTANCEDMODEL_H_
+
+#include "Ref.h"
+#include "Drawable.h"
+#include "Model.h"
+#include "BoundingSphere.h"
+#include "Bundle.h"
+
+namespace gameplay
+{
+
+class VertexAttributeBinding;
+
+/**
+ * Defines a drawable that draws the mesh and materials of a Model many times in a single
+ * draw call per mesh part and pass.
+ *
+ * Each instance has a transform, relative to the node the instanced model is attached to,
+ * and optionally up to four floats of custom data. The instance data is packed into a
+ * buffer that is streamed to the GPU when it changes.
+ *
+ * Where the device supports instanced arrays, the mesh is drawn with glDrawElementsInstanced
+ * and the vertex shader reads the rows of the instance transform from the a_instanceMatrix0,
+ * a_instanceMatrix1 and a_instanceMatrix2 attributes and the custom data from the
+ * a_instanceData attribute. The built-in shaders do so when the INSTANCING define is set.
+ *
+ * Elsewhere, or when the effect of a pass does not read the instance attributes, the
+ * vertices of the instances are transformed on the CPU into a vertex array, like MeshBatch
+ * does, and drawn with as few draw calls as the index format allows. This requires the
+ * vertices of the mesh, which are read back from the bundle the mesh was loaded from.
+ * Meshes that cannot be read back are drawn once per instance with the instance data set
+ * as constant vertex attributes.
+ *
+ * With instanced arrays, instance transforms are expected to have a uniform scale, normals
+ * are transformed by their rotation. Vertices transformed on the CPU have their normals
+ * transformed by the inverse transpose of the instance transform and renormalized. Skinned
+ * models and wireframe drawing are not supported.
+ *
+ * @script{ignore}
+ */
+class InstancedModel : public Ref, public Drawable
+{
+    friend class Node;
+
+public:
+
+    /**
+     * Creates an instanced model that draws the mesh of a model with its materials.
+     *
+     * @param model The model to instance.
+     * @param customDataSize The number of floats of custom data per instance, from 0 to 4.
+     *
+     * @return The new instanced model.
+     */
+    static InstancedModel* create(Model* model, unsigned int customDataSize = 0);
+
+    /**
+     * Gets the model that is instanced.
+     *
+     * @return The model.
+     */
+    Model* getModel() const;
+
+    /**
+     * Gets the number of floats of custom data per instance.
+     *
+     * @return The custom data size.
+     */
+    unsigned int getCustomDataSize() const;
+
+    /**
+     * Adds an instance.
+     *
+     * @param transform The transform of the instance, relative to the node.
+     * @param customData The custom data of the instance, or NULL to set it to zero.
+     *
+     * @return The index of the instance.
+     */
+    unsigned int addInstance(const Matrix& transform, const float* customData = NULL);
+
+    /**
+     * Changes an instance.
+     *
+     * @param index The index of the instance.
+     * @param transform The transform of the instance, relative to the node.
+     * @param customData The custom data of the instance, or NULL to leave it unchanged.
+     */
+    void setInstance(unsigned int index, const Matrix& transform, const float* customData = NULL);
+
+    /**
+     * Gets the transform of an instance.
+     *
+     * @param index The index of the instance.
+     *
+     * @return The transform of the instance.
+     */
+    const Matrix& getInstanceTransform(unsigned int index) const;
+
+    /**
+     * Removes an instance. The last instance takes its index.
+     *
+     * @param index The index of the instance.
+     */
+    void removeInstance(unsigned int index);
+
+    /**
+     * Removes all the instances.
+     */
+    void removeAllInstances();
+
+    /**
+     * Gets the number of instances.
+     *
+     * @return The number of instances.
+     */
+    unsigned int getInstanceCount() const;
+
+    /**
+     * Gets the bounding sphere of all the instances, relative to the node.
+     *
+     * @return The bounding sphere.
+     */
+    const BoundingSphere& getBoundingSphere() const;
+
+    /**
+     * Gets whether the device supports drawing instanced arrays.
+     *
+     * @return true if hardware instancing is supported.
+     */
+    static bool isHardwareInstancingSupported();
+
+    /**
+     * @see Drawable::draw
+     */
+    unsigned int draw(bool wireframe = false) const;
+
+private:
+
+    /**
+     * Constructor.
+     */
+    InstancedModel(Model* model, unsigned int customDataSize);
+
+    /**
+     * Destructor.
+     */
+    ~InstancedModel();
+
+    /**
+     * Hidden copy constructor.
+     */
+    InstancedModel(const InstancedModel& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    InstancedModel& operator=(const InstancedModel&);
+
+    /**
+     * @see Drawable::setNode
+     */
+    void setNode(Node* node);
+
+    /**
+     * @see Drawable::clone
+     */
+    Drawable* clone(NodeCloneContext& context);
+
+    /**
+     * Marks the instance data as changed.
+     */
+    void setDirty();
+
+    /**
+     * Draws the instances of a mesh part, or of the whole mesh if part is NULL, with a pass.
+     */
+    unsigned int drawPart(MeshPart* part, unsigned int partIndex, Pass* pass) const;
+
+    /**
+     * Draws the instances with glDrawElementsInstanced.
+     */
+    unsigned int drawHardware(MeshPart* part, Pass* pass) const;
+
+    /**
+     * Draws the instances from vertices transformed on the CPU.
+     */
+    unsigned int drawBatched(MeshPart* part, unsigned int partIndex, Pass* pass) const;
+
+    /**
+     * Draws the instances one at a time with constant instance attributes.
+     */
+    unsigned int drawSingle(MeshPart* part, Pass* pass) const;
+
+    /**
+     * Sets the instance attributes of an effect to the values of an instance, or to
+     * an identity transform if index is out of range.
+     */
+    void setConstantAttributes(Effect* effect, unsigned int index) const;
+
+    /**
+     * Loads the vertices and indices of the mesh to transform them on the CPU.
+     */
+    bool loadMeshData() const;
+
+    /**
+     * Transforms the vertices of all the instances if the instances changed.
+     */
+    void updateBatchedVertices() const;
+
+    /**
+     * Gets the vertex attribute binding of an effect to the transformed vertices, starting at an instance.
+     */
+    VertexAttributeBinding* getBatchedBinding(Effect* effect, unsigned int firstInstance) const;
+
+    Model* _model;
+    unsigned int _customDataSize;
+    std::vector<Matrix> _transforms;
+    std::vector<float> _instanceData;               // Three transform rows and the custom data per instance.
+    mutable GLuint _instanceBuffer;
+    mutable bool _instanceBufferDirty;
+    mutable BoundingSphere _bounds;
+    mutable bool _boundsDirty;
+
+    // CPU fallback.
+    mutable Bundle::MeshData* _meshData;
+    mutable bool _meshDataLoaded;
+    mutable std::vector<unsigned char> _batchedVertices;
+    mutable bool _batchedVerticesDirty;
+    mutable std::vector<std::vector<unsigned char> > _batchedIndices;   // Per mesh part, for one chunk of instances.
+    mutable std::vector<unsigned int> _batchedChunkSizes;               // Per mesh part, instances per draw call.
+    mutable std::map<std::pair<Effect*, unsigned int>, VertexAttributeBinding*> _batchedBindings; // Per effect and first instance.
+};
+
+}
+
+#endif
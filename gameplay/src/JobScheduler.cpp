@@ -0,0 +1,277 @@
+#include "Base.h"
+#include "JobScheduler.h"
+
+namespace gameplay
+{
+
+// Index of the queue owned by the calling thread. The main thread and any thread
+// that is not a worker push their jobs to the queue 0.
+static thread_local unsigned int __queueIndex = 0;
+
+class JobScheduler::Job
+{
+public:
+
+    Job(const Function& function, Job* parent, Affinity affinity)
+        : function(function), parent(parent), affinity(affinity), unfinished(1), pending(1), finished(false), done(false)
+    {
+    }
+
+    Function function;
+    Job* parent;
+    Affinity affinity;
+    std::atomic<int> unfinished;        // The job itself plus the number of unfinished children.
+    std::atomic<int> pending;           // The number of unfinished dependencies plus one until submitted.
+    std::vector<Job*> dependents;       // Jobs waiting for this job. Guarded by _dependencyMutex.
+    bool finished;                      // Guarded by _dependencyMutex.
+    std::atomic<bool> done;             // Set when the root job is finished and can be released.
+};
+
+JobScheduler::JobScheduler(unsigned int workerCount)
+    : _mainThreadQueue(NULL), _queuedCount(0), _running(true), _mainThreadId(std::this_thread::get_id())
+{
+    _mainThreadQueue = new Queue();
+    for (unsigned int i = 0; i <= workerCount; i++)
+        _queues.push_back(new Queue());
+
+    for (unsigned int i = 1; i <= workerCount; i++)
+        _workers.push_back(new std::thread(&JobScheduler::workerThreadProc, this, i));
+}
+
+JobScheduler::~JobScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _running = false;
+    }
+    _wakeCondition.notify_all();
+
+    for (size_t i = 0, count = _workers.size(); i < count; i++)
+    {
+        _workers[i]->join();
+        SAFE_DELETE(_workers[i]);
+    }
+    _workers.clear();
+
+    GP_ASSERT(_queuedCount == 0);
+    GP_ASSERT(_mainThreadQueue->jobs.empty());
+    for (size_t i = 0, count = _queues.size(); i < count; i++)
+    {
+        SAFE_DELETE(_queues[i]);
+    }
+    _queues.clear();
+    SAFE_DELETE(_mainThreadQueue);
+}
+
+JobScheduler::Job* JobScheduler::createJob(const Function& function, Job* parent, Affinity affinity)
+{
+    if (parent)
+    {
+        GP_ASSERT(parent->unfinished > 0);
+        parent->unfinished++;
+    }
+
+    return new Job(function, parent, affinity);
+}
+
+void JobScheduler::addDependency(Job* job, Job* dependency)
+{
+    GP_ASSERT(job);
+    GP_ASSERT(dependency);
+    GP_ASSERT(job != dependency);
+
+    std::lock_guard<std::mutex> lock(_dependencyMutex);
+    if (!dependency->finished)
+    {
+        job->pending++;
+        dependency->dependents.push_back(job);
+    }
+}
+
+void JobScheduler::submit(Job* job)
+{
+    GP_ASSERT(job);
+
+    if (job->pending.fetch_sub(1) == 1)
+        enqueue(job);
+}
+
+void JobScheduler::wait(Job* job)
+{
+    GP_ASSERT(job);
+    GP_ASSERT(job->parent == NULL);
+
+    const unsigned int queueIndex = __queueIndex;
+    while (!job->done.load(std::memory_order_acquire))
+    {
+        Job* next = acquire(queueIndex);
+        if (next)
+            execute(next);
+        else
+            std::this_thread::yield();
+    }
+
+    delete job;
+}
+
+void JobScheduler::parallelFor(unsigned int count, const RangeFunction& function, unsigned int grainSize)
+{
+    if (count == 0)
+        return;
+
+    if (grainSize == 0)
+        grainSize = 1;
+
+    if (count <= grainSize || _workers.empty())
+    {
+        function(0, count);
+        return;
+    }
+
+    Job* root = createJob(Function());
+    for (unsigned int begin = 0; begin < count; begin += grainSize)
+    {
+        unsigned int end = std::min(begin + grainSize, count);
+        submit(createJob([&function, begin, end]() { function(begin, end); }, root));
+    }
+    submit(root);
+    wait(root);
+}
+
+unsigned int JobScheduler::getWorkerCount() const
+{
+    return (unsigned int)_workers.size();
+}
+
+bool JobScheduler::isMainThread() const
+{
+    return std::this_thread::get_id() == _mainThreadId;
+}
+
+void JobScheduler::enqueue(Job* job)
+{
+    if (job->affinity == MAIN_THREAD)
+    {
+        std::lock_guard<std::mutex> lock(_mainThreadQueue->mutex);
+        _mainThreadQueue->jobs.push_back(job);
+        return;
+    }
+
+    Queue* queue = _queues[__queueIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->jobs.push_back(job);
+    }
+    _queuedCount++;
+
+    // Take the wake mutex so that a worker that is about to sleep does not miss the notification.
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+    }
+    _wakeCondition.notify_one();
+}
+
+JobScheduler::Job* JobScheduler::acquire(unsigned int queueIndex)
+{
+    if (queueIndex == 0 && isMainThread())
+    {
+        std::lock_guard<std::mutex> lock(_mainThreadQueue->mutex);
+        if (!_mainThreadQueue->jobs.empty())
+        {
+            Job* job = _mainThreadQueue->jobs.front();
+            _mainThreadQueue->jobs.pop_front();
+            return job;
+        }
+    }
+
+    if (_queuedCount == 0)
+        return NULL;
+
+    // Newest jobs of the own queue first, they are most likely to be hot in the cache.
+    Queue* queue = _queues[queueIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (!queue->jobs.empty())
+        {
+            Job* job = queue->jobs.back();
+            queue->jobs.pop_back();
+            _queuedCount--;
+            return job;
+        }
+    }
+
+    // Steal the oldest jobs from the other queues.
+    const unsigned int queueCount = (unsigned int)_queues.size();
+    for (unsigned int i = 1; i < queueCount; i++)
+    {
+        queue = _queues[(queueIndex + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (!queue->jobs.empty())
+        {
+            Job* job = queue->jobs.front();
+            queue->jobs.pop_front();
+            _queuedCount--;
+            return job;
+        }
+    }
+
+    return NULL;
+}
+
+void JobScheduler::execute(Job* job)
+{
+    if (job->function)
+        job->function();
+
+    finish(job);
+}
+
+void JobScheduler::finish(Job* job)
+{
+    if (job->unfinished.fetch_sub(1) != 1)
+        return;
+
+    std::vector<Job*> dependents;
+    {
+        std::lock_guard<std::mutex> lock(_dependencyMutex);
+        job->finished = true;
+        dependents.swap(job->dependents);
+    }
+
+    for (size_t i = 0, count = dependents.size(); i < count; i++)
+    {
+        if (dependents[i]->pending.fetch_sub(1) == 1)
+            enqueue(dependents[i]);
+    }
+
+    Job* parent = job->parent;
+    if (parent)
+    {
+        delete job;
+        finish(parent);
+    }
+    else
+    {
+        job->done.store(true, std::memory_order_release);
+    }
+}
+
+void JobScheduler::workerThreadProc(unsigned int queueIndex)
+{
+    __queueIndex = queueIndex;
+
+    while (_running)
+    {
+        Job* job = acquire(queueIndex);
+        if (job)
+        {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _wakeCondition.wait(lock, [this]() { return !_running || _queuedCount > 0; });
+    }
+}
+
+}
@@ -0,0 +1,194 @@
+#ifndef JOBSCHEDULER_H_
+#define JOBSCHEDULER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+
+namespace gameplay
+{
+
+/**
+ * Defines a work-stealing task scheduler that runs jobs on a pool of worker threads.
+ *
+ * Each worker owns a job queue. Jobs spawned from a worker are pushed onto its own queue,
+ * idle workers steal from the queues of busy workers. The thread that waits on a job
+ * (usually the main thread) helps executing queued jobs until the job is finished.
+ *
+ * Jobs can be organized into graphs: a job can be created as a child of another job,
+ * in which case the parent job is not considered finished until all its children
+ * finished, and a job can depend on other jobs, in which case it is not started
+ * until all of them finished.
+ *
+ * Jobs marked with MAIN_THREAD affinity are only executed by the main thread. This is
+ * used for work that calls OpenGL, Lua scripts or user callbacks.
+ *
+ * Job handles are valid until the job is waited on (root jobs) or until the job
+ * finishes (child jobs). Dependencies must be declared before the jobs are submitted.
+ *
+ * @script{ignore}
+ */
+class JobScheduler
+{
+    friend class Game;
+
+public:
+
+    /**
+     * Job function.
+     */
+    typedef std::function<void()> Function;
+
+    /**
+     * Range function used by parallelFor. Called with a half-open [begin, end) range of indices.
+     */
+    typedef std::function<void(unsigned int begin, unsigned int end)> RangeFunction;
+
+    /**
+     * Defines the threads a job is allowed to run on.
+     */
+    enum Affinity
+    {
+        ANY_THREAD,
+        MAIN_THREAD
+    };
+
+    /**
+     * Opaque job handle.
+     */
+    class Job;
+
+    /**
+     * Destructor.
+     */
+    ~JobScheduler();
+
+    /**
+     * Creates a new job. The job is not executed until it is submitted.
+     *
+     * @param function The function to execute.
+     * @param parent Optional parent job. The parent is not finished until this job is finished.
+     *      The parent must not be finished at the time of the call.
+     * @param affinity The threads the job is allowed to run on.
+     *
+     * @return The new job.
+     */
+    Job* createJob(const Function& function, Job* parent = NULL, Affinity affinity = ANY_THREAD);
+
+    /**
+     * Makes a job wait for the completion of another job before it is started.
+     *
+     * Both jobs must not be submitted yet.
+     *
+     * @param job The dependent job.
+     * @param dependency The job that must finish first.
+     */
+    void addDependency(Job* job, Job* dependency);
+
+    /**
+     * Submits the job for execution. The job is queued as soon as all its dependencies finished.
+     *
+     * @param job The job to submit.
+     */
+    void submit(Job* job);
+
+    /**
+     * Waits until the root job and all its children are finished and releases the job handle.
+     *
+     * The calling thread executes queued jobs while waiting.
+     *
+     * @param job The root job to wait for.
+     */
+    void wait(Job* job);
+
+    /**
+     * Runs the function over the range [0, count) split into chunks of grainSize indices,
+     * and waits for completion. The calling thread takes part in the execution.
+     *
+     * @param count The number of indices.
+     * @param function The function to call for each chunk.
+     * @param grainSize The number of indices processed by a single job.
+     */
+    void parallelFor(unsigned int count, const RangeFunction& function, unsigned int grainSize = 1);
+
+    /**
+     * Gets the number of worker threads, not including the main thread.
+     *
+     * @return The number of worker threads.
+     */
+    unsigned int getWorkerCount() const;
+
+    /**
+     * Checks whether the calling thread is the thread the scheduler was created on.
+     *
+     * @return true if called on the main thread.
+     */
+    bool isMainThread() const;
+
+private:
+
+    /**
+     * Job queue owned by a thread.
+     */
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Job*> jobs;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param workerCount The number of worker threads to start. Zero makes all jobs run on the waiting thread.
+     */
+    JobScheduler(unsigned int workerCount);
+
+    /**
+     * Hidden copy constructor.
+     */
+    JobScheduler(const JobScheduler& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    JobScheduler& operator=(const JobScheduler&);
+
+    /**
+     * Pushes a ready job to a queue.
+     */
+    void enqueue(Job* job);
+
+    /**
+     * Pops a job from the queue of the calling thread or steals one from other queues.
+     */
+    Job* acquire(unsigned int queueIndex);
+
+    /**
+     * Executes the job and finishes it.
+     */
+    void execute(Job* job);
+
+    /**
+     * Marks one unit of the job finished, propagating to parent and dependent jobs.
+     */
+    void finish(Job* job);
+
+    /**
+     * Worker thread entry point.
+     */
+    void workerThreadProc(unsigned int queueIndex);
+
+    std::vector<std::thread*> _workers;
+    std::vector<Queue*> _queues;                // Queue 0 is the main thread queue, queue N is the worker N-1 queue.
+    Queue* _mainThreadQueue;                    // Jobs that are bound to the main thread.
+    std::mutex _dependencyMutex;                // Guards dependent job lists.
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+    std::atomic<unsigned int> _queuedCount;     // Number of jobs in all the queues.
+    std::atomic<bool> _running;
+    std::thread::id _mainThreadId;
+};
+
+}
+
+#endif
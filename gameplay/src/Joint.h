@@ -88,12 +88,13 @@ protected:
     void setInverseBindPose(const Matrix& m);
 
     /**
-     * Updates the joint matrix.
-     * 
-     * @param bindShape The bind shape matrix.
-     * @param matrixPalette The matrix palette to update.
+     * Updates the joint matrix if the joint transform changed.
+     *
+     * The joint matrix is shared by all the skins this joint influences, so it is computed
+     * once no matter how many skins use the joint. Resolves world matrices, so it must
+     * not be called concurrently.
      */
-    void updateJointMatrix(const Matrix& bindShape, Vector4* matrixPalette);
+    void updateJointMatrix();
 
     /**
      * Called when this Joint's transform changes.
@@ -133,11 +134,22 @@ private:
      */
     Matrix _bindPose;
 
+    /**
+     * The Joint's world matrix multiplied by its inverse bind pose.
+     */
+    Matrix _jointMatrix;
+
     /**
      * Flag used to mark if the Joint's matrix is dirty.
      */
     bool _jointMatrixDirty;
 
+    /**
+     * Incremented each time the Joint's matrix is recomputed, so that skins can tell
+     * whether their palette entry for this joint is up to date.
+     */
+    unsigned int _jointMatrixVersion;
+
     /**
      * Linked list of mesh skins that are referenced by this joint.
      */
@@ -5,8 +5,11 @@
 namespace gameplay
 {
 
+// Last version given to a material parameter value. Versions are unique across parameters.
+static unsigned long long __lastParameterVersion = 0;
+
 MaterialParameter::MaterialParameter(const char* name) :
-_type(MaterialParameter::NONE), _count(1), _dynamic(false), _name(name ? name : ""), _uniform(NULL), _loggerDirtyBits(0)
+_type(MaterialParameter::NONE), _count(1), _dynamic(false), _name(name ? name : ""), _uniform(NULL), _loggerDirtyBits(0), _version(0)
 {
     clearValue();
 }
@@ -73,6 +76,32 @@ void MaterialParameter::clearValue()
 
     memset(&_value, 0, sizeof(_value));
     _type = MaterialParameter::NONE;
+    valueChanged();
+}
+
+void MaterialParameter::valueChanged()
+{
+    _version = ++__lastParameterVersion;
+}
+
+bool MaterialParameter::isValueOwned() const
+{
+    switch (_type)
+    {
+    case MaterialParameter::FLOAT:
+    case MaterialParameter::INT:
+        return true;
+    case MaterialParameter::FLOAT_ARRAY:
+    case MaterialParameter::INT_ARRAY:
+    case MaterialParameter::VECTOR2:
+    case MaterialParameter::VECTOR3:
+    case MaterialParameter::VECTOR4:
+    case MaterialParameter::MATRIX:
+        return _dynamic;
+    default:
+        // Samplers must be bound to their texture unit each time and methods compute new values.
+        return false;
+    }
 }
 
 const char* MaterialParameter::getName() const
@@ -211,6 +240,7 @@ void MaterialParameter::setValue(const Matrix& value)
     _dynamic = true;
     _count = 1;
     _type = MaterialParameter::MATRIX;
+    valueChanged();
 }
 
 void MaterialParameter::setValue(const Matrix* values, unsigned int count)
@@ -464,6 +494,11 @@ void MaterialParameter::bind(Effect* effect)
         }
     }
 
+    // The program keeps uniform values, so a value owned by this parameter is not sent again
+    // while the uniform holds it. Other values are compared with the last value by the effect.
+    if (_uniform->_parameterVersion == _version)
+        return;
+
     switch (_type)
     {
     case MaterialParameter::FLOAT:
@@ -510,6 +545,11 @@ void MaterialParameter::bind(Effect* effect)
             break;
         }
     }
+
+    if (isValueOwned())
+    {
+        _uniform->_parameterVersion = _version;
+    }
 }
 
 void MaterialParameter::bindValue(Node* node, const char* binding)
@@ -735,6 +775,7 @@ void MaterialParameter::setAnimationPropertyValue(int propertyId, AnimationValue
                 default:
                     break;
             }
+            valueChanged();
         }
         break;
     }
@@ -430,6 +430,16 @@ private:
 
     void clearValue();
 
+    /**
+     * Gives the value of the parameter a new version.
+     */
+    void valueChanged();
+
+    /**
+     * Gets whether the value is stored by the parameter, so it only changes with its version.
+     */
+    bool isValueOwned() const;
+
     void bind(Effect* effect);
 
     void applyAnimationValue(AnimationValue* value, float blendWeight, int components);
@@ -481,6 +491,7 @@ private:
     std::string _name;
     Uniform* _uniform;
     char _loggerDirtyBits;
+    unsigned long long _version;
 };
 
 template <class ClassType, class ParameterType>
@@ -104,8 +104,10 @@ private:
 #define MATRIX_SIZE ( sizeof(float) * 16 )
 #define MATRIX3_SIZE ( sizeof(float) * 9 )
 
-#ifdef GP_USE_NEON
+#if defined(GP_USE_NEON)
 #include "MathUtilNeon.inl"
+#elif defined(GP_SIMD_SSE)
+#include "MathUtilSSE.inl"
 #else
 #include "MathUtil.inl"
 #endif
@@ -0,0 +1,231 @@
+namespace gameplay
+{
+
+inline void MathUtil::addMatrix(const float* m, float scalar, float* dst)
+{
+    __m128 s = _mm_set1_ps(scalar);
+    _mm_storeu_ps(&dst[0],  _mm_add_ps(_mm_loadu_ps(&m[0]),  s));
+    _mm_storeu_ps(&dst[4],  _mm_add_ps(_mm_loadu_ps(&m[4]),  s));
+    _mm_storeu_ps(&dst[8],  _mm_add_ps(_mm_loadu_ps(&m[8]),  s));
+    _mm_storeu_ps(&dst[12], _mm_add_ps(_mm_loadu_ps(&m[12]), s));
+}
+
+inline void MathUtil::addMatrix(const float* m1, const float* m2, float* dst)
+{
+    _mm_storeu_ps(&dst[0],  _mm_add_ps(_mm_loadu_ps(&m1[0]),  _mm_loadu_ps(&m2[0])));
+    _mm_storeu_ps(&dst[4],  _mm_add_ps(_mm_loadu_ps(&m1[4]),  _mm_loadu_ps(&m2[4])));
+    _mm_storeu_ps(&dst[8],  _mm_add_ps(_mm_loadu_ps(&m1[8]),  _mm_loadu_ps(&m2[8])));
+    _mm_storeu_ps(&dst[12], _mm_add_ps(_mm_loadu_ps(&m1[12]), _mm_loadu_ps(&m2[12])));
+}
+
+inline void MathUtil::subtractMatrix(const float* m1, const float* m2, float* dst)
+{
+    _mm_storeu_ps(&dst[0],  _mm_sub_ps(_mm_loadu_ps(&m1[0]),  _mm_loadu_ps(&m2[0])));
+    _mm_storeu_ps(&dst[4],  _mm_sub_ps(_mm_loadu_ps(&m1[4]),  _mm_loadu_ps(&m2[4])));
+    _mm_storeu_ps(&dst[8],  _mm_sub_ps(_mm_loadu_ps(&m1[8]),  _mm_loadu_ps(&m2[8])));
+    _mm_storeu_ps(&dst[12], _mm_sub_ps(_mm_loadu_ps(&m1[12]), _mm_loadu_ps(&m2[12])));
+}
+
+inline void MathUtil::multiplyMatrix(const float* m, float scalar, float* dst)
+{
+    __m128 s = _mm_set1_ps(scalar);
+    _mm_storeu_ps(&dst[0],  _mm_mul_ps(_mm_loadu_ps(&m[0]),  s));
+    _mm_storeu_ps(&dst[4],  _mm_mul_ps(_mm_loadu_ps(&m[4]),  s));
+    _mm_storeu_ps(&dst[8],  _mm_mul_ps(_mm_loadu_ps(&m[8]),  s));
+    _mm_storeu_ps(&dst[12], _mm_mul_ps(_mm_loadu_ps(&m[12]), s));
+}
+
+inline void MathUtil::multiplyMatrix(const float* m1, const float* m2, float* dst)
+{
+    // Each column of the product is a linear combination of the columns of m1.
+    // All columns are computed before storing to support the case where m1 or m2 is the same array as dst.
+    __m128 c0 = _mm_loadu_ps(&m1[0]);
+    __m128 c1 = _mm_loadu_ps(&m1[4]);
+    __m128 c2 = _mm_loadu_ps(&m1[8]);
+    __m128 c3 = _mm_loadu_ps(&m1[12]);
+
+    __m128 p[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        __m128 b = _mm_loadu_ps(&m2[i * 4]);
+        __m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0)));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1))));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2))));
+        p[i] = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3))));
+    }
+
+    _mm_storeu_ps(&dst[0],  p[0]);
+    _mm_storeu_ps(&dst[4],  p[1]);
+    _mm_storeu_ps(&dst[8],  p[2]);
+    _mm_storeu_ps(&dst[12], p[3]);
+}
+
+inline void MathUtil::negateMatrix(const float* m, float* dst)
+{
+    __m128 sign = _mm_set1_ps(-0.0f);
+    _mm_storeu_ps(&dst[0],  _mm_xor_ps(_mm_loadu_ps(&m[0]),  sign));
+    _mm_storeu_ps(&dst[4],  _mm_xor_ps(_mm_loadu_ps(&m[4]),  sign));
+    _mm_storeu_ps(&dst[8],  _mm_xor_ps(_mm_loadu_ps(&m[8]),  sign));
+    _mm_storeu_ps(&dst[12], _mm_xor_ps(_mm_loadu_ps(&m[12]), sign));
+}
+
+inline void MathUtil::transposeMatrix(const float* m, float* dst)
+{
+    __m128 r0 = _mm_loadu_ps(&m[0]);
+    __m128 r1 = _mm_loadu_ps(&m[4]);
+    __m128 r2 = _mm_loadu_ps(&m[8]);
+    __m128 r3 = _mm_loadu_ps(&m[12]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(&dst[0],  r0);
+    _mm_storeu_ps(&dst[4],  r1);
+    _mm_storeu_ps(&dst[8],  r2);
+    _mm_storeu_ps(&dst[12], r3);
+}
+
+inline void MathUtil::transformVector4(const float* m, float x, float y, float z, float w, float* dst)
+{
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(&m[0]), _mm_set1_ps(x));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&m[4]),  _mm_set1_ps(y)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&m[8]),  _mm_set1_ps(z)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&m[12]), _mm_set1_ps(w)));
+
+    // Only the x, y and z components are written, dst may point to a Vector3.
+    _mm_storel_pi((__m64*)dst, r);
+    _mm_store_ss(&dst[2], _mm_movehl_ps(r, r));
+}
+
+inline void MathUtil::transformVector4(const float* m, const float* v, float* dst)
+{
+    // Handle case where v == dst.
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(&m[0]), _mm_set1_ps(v[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&m[4]),  _mm_set1_ps(v[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&m[8]),  _mm_set1_ps(v[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(&m[12]), _mm_set1_ps(v[3])));
+    _mm_storeu_ps(dst, r);
+}
+
+inline void MathUtil::crossVector3(const float* v1, const float* v2, float* dst)
+{
+    float x = (v1[1] * v2[2]) - (v1[2] * v2[1]);
+    float y = (v1[2] * v2[0]) - (v1[0] * v2[2]);
+    float z = (v1[0] * v2[1]) - (v1[1] * v2[0]);
+
+    dst[0] = x;
+    dst[1] = y;
+    dst[2] = z;
+}
+
+inline void MathUtil::addMatrix3(const float* m, float scalar, float* dst)
+{
+    dst[0]  = m[0]  + scalar;
+    dst[1]  = m[1]  + scalar;
+    dst[2]  = m[2]  + scalar;
+    dst[3]  = m[3]  + scalar;
+    dst[4]  = m[4]  + scalar;
+    dst[5]  = m[5]  + scalar;
+    dst[6]  = m[6]  + scalar;
+    dst[7]  = m[7]  + scalar;
+    dst[8]  = m[8]  + scalar;
+}
+
+inline void MathUtil::addMatrix3(const float* m1, const float* m2, float* dst)
+{
+    dst[0]  = m1[0]  + m2[0];
+    dst[1]  = m1[1]  + m2[1];
+    dst[2]  = m1[2]  + m2[2];
+    dst[3]  = m1[3]  + m2[3];
+    dst[4]  = m1[4]  + m2[4];
+    dst[5]  = m1[5]  + m2[5];
+    dst[6]  = m1[6]  + m2[6];
+    dst[7]  = m1[7]  + m2[7];
+    dst[8]  = m1[8]  + m2[8];
+}
+
+inline void MathUtil::subtractMatrix3(const float* m1, const float* m2, float* dst)
+{
+    dst[0]  = m1[0]  - m2[0];
+    dst[1]  = m1[1]  - m2[1];
+    dst[2]  = m1[2]  - m2[2];
+    dst[3]  = m1[3]  - m2[3];
+    dst[4]  = m1[4]  - m2[4];
+    dst[5]  = m1[5]  - m2[5];
+    dst[6]  = m1[6]  - m2[6];
+    dst[7]  = m1[7]  - m2[7];
+    dst[8]  = m1[8]  - m2[8];
+}
+
+inline void MathUtil::multiplyMatrix3(const float* m, float scalar, float* dst)
+{
+    dst[0]  = m[0]  * scalar;
+    dst[1]  = m[1]  * scalar;
+    dst[2]  = m[2]  * scalar;
+    dst[3]  = m[3]  * scalar;
+    dst[4]  = m[4]  * scalar;
+    dst[5]  = m[5]  * scalar;
+    dst[6]  = m[6]  * scalar;
+    dst[7]  = m[7]  * scalar;
+    dst[8]  = m[8]  * scalar;
+}
+
+inline void MathUtil::multiplyMatrix3(const float* m1, const float* m2, float* dst)
+{
+    // Support the case where m1 or m2 is the same array as dst.
+    float product[9];
+
+    product[0]  = m1[0] * m2[0]  + m1[3] * m2[1] + m1[6]   * m2[2];
+    product[1]  = m1[1] * m2[0]  + m1[4] * m2[1] + m1[7]   * m2[2];
+    product[2]  = m1[2] * m2[0]  + m1[5] * m2[1] + m1[8]   * m2[2];
+
+    product[3]  = m1[0] * m2[3]  + m1[3] * m2[4] + m1[6]   * m2[5];
+    product[4]  = m1[1] * m2[3]  + m1[4] * m2[4] + m1[7]   * m2[5];
+    product[5]  = m1[2] * m2[3]  + m1[5] * m2[4] + m1[8]   * m2[5];
+
+    product[6]  = m1[0] * m2[6]  + m1[3] * m2[7] + m1[6]   * m2[8];
+    product[7]  = m1[1] * m2[6]  + m1[4] * m2[7] + m1[7]   * m2[8];
+    product[8]  = m1[2] * m2[6]  + m1[5] * m2[7] + m1[8]   * m2[8];
+
+    memcpy(dst, product, MATRIX3_SIZE);
+}
+
+inline void MathUtil::negateMatrix3(const float* m, float* dst)
+{
+    dst[0]  = -m[0];
+    dst[1]  = -m[1];
+    dst[2]  = -m[2];
+    dst[3]  = -m[3];
+    dst[4]  = -m[4];
+    dst[5]  = -m[5];
+    dst[6]  = -m[6];
+    dst[7]  = -m[7];
+    dst[8]  = -m[8];
+}
+
+inline void MathUtil::transposeMatrix3(const float* m, float* dst)
+{
+    float t[9] = {
+        m[0], m[3], m[6],
+        m[1], m[4], m[7],
+        m[2], m[5], m[8],
+    };
+    memcpy(dst, t, MATRIX3_SIZE);
+}
+
+inline void MathUtil::transformVector3(const float* m, float x, float y, float z, float* dst)
+{
+    dst[0] = x * m[0] + y * m[3] + z * m[6];
+    dst[1] = x * m[1] + y * m[4] + z * m[7];
+}
+
+inline void MathUtil::transformVector3(const float* m, const float* v, float* dst)
+{
+    // Handle case where v == dst.
+    float x = v[0] * m[0] + v[1] * m[3] + v[2] * m[6];
+    float y = v[0] * m[1] + v[1] * m[4] + v[2] * m[7];
+    float z = v[0] * m[2] + v[1] * m[5] + v[2] * m[8];
+
+    dst[0] = x;
+    dst[1] = y;
+    dst[2] = z;
+}
+
+}
@@ -22,6 +22,7 @@ class Mesh : public Ref
 {
     friend class Model;
     friend class Bundle;
+    friend class SoftwareSkin;
 
 public:
 
@@ -10,28 +10,25 @@
 
 #include "Base.h"
 #include "MeshBatch.h"
+#include "MeshPart.h"
 #include "Material.h"
-#include "Model.h"
 
 namespace gameplay
 {
 
 MeshBatch::MeshBatch(const VertexFormat& vertexFormat, Mesh::PrimitiveType primitiveType, Material* material, bool indexed, unsigned int initialCapacity, unsigned int growSize)
     : _vertexFormat(vertexFormat), _primitiveType(primitiveType), _material(material), _indexed(indexed), _capacity(0), _growSize(growSize),
-    _vertexCapacity(0), _indexCapacity(0), _vertexCount(0), _indexCount(0), _vertices(NULL), _verticesPtr(NULL), _indices(NULL), _indicesPtr(NULL), _started(false)
+    _vertexCapacity(0), _indexCapacity(0), _vertexCount(0), _indexCount(0), _vertices(NULL), _verticesPtr(NULL), _indices(NULL), _indicesPtr(NULL),
+    _lastIndex(0), _started(false), _mapped(false), _mesh(NULL)
 {
-#ifdef EMSCRIPTEN
-    _model = Model::create(Mesh::createMesh(vertexFormat, initialCapacity, true));
-    _model->getMesh()->release();
-#endif
     resize(initialCapacity);
 }
 
 MeshBatch::~MeshBatch()
 {
-#ifdef EMSCRIPTEN
-    SAFE_RELEASE(_model);
-#endif
+    if (_mapped)
+        unmap();
+    SAFE_RELEASE(_mesh);
     SAFE_RELEASE(_material);
     SAFE_DELETE_ARRAY(_vertices);
     SAFE_DELETE_ARRAY(_indices);
@@ -55,9 +52,6 @@ MeshBatch* MeshBatch::create(const VertexFormat& vertexFormat, Mesh::PrimitiveTy
     GP_ASSERT(material);
 
     MeshBatch* batch = new MeshBatch(vertexFormat, primitiveType, material, indexed, initialCapacity, growSize);
-#ifdef EMSCRIPTEN
-    batch->_model->setMaterial(material);
-#endif
 
     material->addRef();
 
@@ -87,7 +81,7 @@ void MeshBatch::add(const void* vertices, size_t size, unsigned int vertexCount,
     unsigned int vBytes = vertexCount * _vertexFormat.getVertexSize();
     memcpy(_verticesPtr, vertices, vBytes);
     
-    // Copy index data.
+    // Copy index data. The batch may be mapped, so the indices already written are never read back.
     if (_indexed)
     {
         GP_ASSERT(indices);
@@ -97,6 +91,8 @@ void MeshBatch::add(const void* vertices, size_t size, unsigned int vertexCount,
         {
             // Simply copy values directly into the start of the index array.
             memcpy(_indicesPtr, indices, indexCount * sizeof(unsigned short));
+            if (indexCount > 0)
+                _lastIndex = indices[indexCount - 1];
         }
         else
         {
@@ -104,7 +100,7 @@ void MeshBatch::add(const void* vertices, size_t size, unsigned int vertexCount,
             {
                 // Create a degenerate triangle to connect separate triangle strips
                 // by duplicating the previous and next vertices.
-                _indicesPtr[0] = *(_indicesPtr-1);
+                _indicesPtr[0] = _lastIndex;
                 _indicesPtr[1] = _vertexCount;
                 _indicesPtr += 2;
             }
@@ -115,6 +111,8 @@ void MeshBatch::add(const void* vertices, size_t size, unsigned int vertexCount,
             {
                 _indicesPtr[i] = indices[i] + _vertexCount;
             }
+            if (indexCount > 0)
+                _lastIndex = indices[indexCount - 1] + _vertexCount;
         }
         _indicesPtr += indexCount;
         _indexCount = newIndexCount;
@@ -124,9 +122,40 @@ void MeshBatch::add(const void* vertices, size_t size, unsigned int vertexCount,
     _vertexCount = newVertexCount;
 }
 
+unsigned char* MeshBatch::reserve(unsigned int vertexCount, unsigned int indexCount, unsigned short** indices)
+{
+    unsigned int newVertexCount = _vertexCount + vertexCount;
+    unsigned int newIndexCount = _indexCount + indexCount;
+
+    // Do we need to grow the batch?
+    while (newVertexCount > _vertexCapacity || (_indexed && newIndexCount > _indexCapacity))
+    {
+        if (_growSize == 0)
+            return NULL; // growing disabled, just clip batch
+        if (!resize(_capacity + _growSize))
+            return NULL; // failed to grow
+    }
+
+    GP_ASSERT(_verticesPtr);
+    unsigned char* vertices = _verticesPtr;
+    _verticesPtr += vertexCount * _vertexFormat.getVertexSize();
+    _vertexCount = newVertexCount;
+
+    if (_indexed)
+    {
+        GP_ASSERT(_indicesPtr);
+        *indices = _indicesPtr;
+        _indicesPtr += indexCount;
+        _indexCount = newIndexCount;
+    }
+
+    return vertices;
+}
+
 void MeshBatch::updateVertexAttributeBinding()
 {
     GP_ASSERT(_material);
+    GP_ASSERT(_mesh);
 
     // Update our vertex attribute bindings.
     for (unsigned int i = 0, techniqueCount = _material->getTechniqueCount(); i < techniqueCount; ++i)
@@ -137,11 +166,7 @@ void MeshBatch::updateVertexAttributeBinding()
         {
             Pass* p = t->getPassByIndex(j);
             GP_ASSERT(p);
-#ifdef EMSCRIPTEN
-            VertexAttributeBinding* b = VertexAttributeBinding::create(_model->getMesh(), p->getEffect());
-#else
-            VertexAttributeBinding* b = VertexAttributeBinding::create(_vertexFormat, _vertices, p->getEffect());
-#endif
+            VertexAttributeBinding* b = VertexAttributeBinding::create(_mesh, p->getEffect());
             p->setVertexAttributeBinding(b);
             SAFE_RELEASE(b);
         }
@@ -169,9 +194,11 @@ bool MeshBatch::resize(unsigned int capacity)
     if (capacity == _capacity)
         return true;
 
-    // Store old batch data.
-    unsigned char* oldVertices = _vertices;
-    unsigned short* oldIndices = _indices;
+    if (_mapped)
+    {
+        GP_WARN("Cannot resize a mesh batch while it is mapped, finish the batch first.");
+        return false;
+    }
 
     unsigned int vertexCapacity = 0;
     switch (_primitiveType)
@@ -206,6 +233,26 @@ bool MeshBatch::resize(unsigned int capacity)
         return false;
     }
 
+    // Create the dynamic buffers the batch is streamed into.
+    Mesh* mesh = Mesh::createMesh(_vertexFormat, vertexCapacity, true);
+    if (mesh == NULL)
+    {
+        GP_ERROR("Failed to create vertex buffer for mesh batch.");
+        return false;
+    }
+    if (_indexed && mesh->addPart(_primitiveType, Mesh::INDEX16, indexCapacity, true) == NULL)
+    {
+        GP_ERROR("Failed to create index buffer for mesh batch.");
+        SAFE_RELEASE(mesh);
+        return false;
+    }
+    SAFE_RELEASE(_mesh);
+    _mesh = mesh;
+
+    // Store old batch data.
+    unsigned char* oldVertices = _vertices;
+    unsigned short* oldIndices = _indices;
+
     // Allocate new data and reset pointers.
     unsigned int voffset = _verticesPtr - _vertices;
     unsigned int vBytes = vertexCapacity * _vertexFormat.getVertexSize();
@@ -236,12 +283,82 @@ bool MeshBatch::resize(unsigned int capacity)
     _vertexCapacity = vertexCapacity;
     _indexCapacity = indexCapacity;
 
-    // Update our vertex attribute bindings now that our client array pointers have changed
+    // Update our vertex attribute bindings now that our vertex buffer has changed
     updateVertexAttributeBinding();
 
     return true;
 }
 
+bool MeshBatch::map()
+{
+#ifdef GP_USE_MAP_BUFFER
+    // Only batches with a fixed budget are mapped, since batches that grow
+    // need to keep their primitives when their buffers are recreated.
+    if (_growSize != 0)
+        return false;
+#ifdef GP_LOAD_GL_EXTENSIONS
+    // The entry point is loaded at runtime, and only when the driver has the extension.
+    if (glMapBuffer == NULL)
+        return false;
+#endif
+
+    GP_ASSERT(_mesh);
+
+    // Orphan the buffers before mapping them, so the driver can give them new storage
+    // instead of waiting for the draws of the previous batch to complete.
+    GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, _mesh->getVertexBuffer()) );
+    GL_ASSERT( glBufferData(GL_ARRAY_BUFFER, _vertexCapacity * _vertexFormat.getVertexSize(), NULL, GL_STREAM_DRAW) );
+    unsigned char* vertices = (unsigned char*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+    if (vertices == NULL)
+        return false;
+
+    unsigned short* indices = NULL;
+    if (_indexed)
+    {
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _mesh->getPart(0)->getIndexBuffer()) );
+        GL_ASSERT( glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indexCapacity * sizeof(unsigned short), NULL, GL_STREAM_DRAW) );
+        indices = (unsigned short*)glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY);
+        if (indices == NULL)
+        {
+            GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, _mesh->getVertexBuffer()) );
+            GL_ASSERT( glUnmapBuffer(GL_ARRAY_BUFFER) );
+            return false;
+        }
+    }
+
+    _verticesPtr = vertices;
+    _indicesPtr = indices;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MeshBatch::unmap()
+{
+#ifdef GP_USE_MAP_BUFFER
+    GP_ASSERT(_mesh);
+
+    bool result = true;
+    GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, _mesh->getVertexBuffer()) );
+    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
+        result = false;
+    if (_indexed)
+    {
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _mesh->getPart(0)->getIndexBuffer()) );
+        if (!glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER))
+            result = false;
+    }
+
+    // Point back at the copy in memory, which is only used by batches that are not mapped.
+    _verticesPtr = _vertices + _vertexCount * _vertexFormat.getVertexSize();
+    _indicesPtr = _indices ? _indices + _indexCount : NULL;
+    return result;
+#else
+    return true;
+#endif
+}
+
 void MeshBatch::add(const float* vertices, unsigned int vertexCount, const unsigned short* indices, unsigned int indexCount)
 {
     add(vertices, sizeof(float), vertexCount, indices, indexCount);
@@ -249,10 +366,18 @@ void MeshBatch::add(const float* vertices, unsigned int vertexCount, const unsig
 
 void MeshBatch::start()
 {
+    if (_mapped)
+    {
+        _mapped = false;
+        unmap();
+    }
+
     _vertexCount = 0;
     _indexCount = 0;
+    _lastIndex = 0;
     _verticesPtr = _vertices;
     _indicesPtr = _indices;
+    _mapped = map();
     _started = true;
 }
 
@@ -263,9 +388,34 @@ bool MeshBatch::isStarted() const
 
 void MeshBatch::finish()
 {
-#ifdef EMSCRIPTEN
-    _model->getMesh()->setVertexData(reinterpret_cast<const float*>(_vertices), 0, _vertexCount);
-#endif
+    GP_ASSERT(_mesh);
+
+    if (_mapped)
+    {
+        _mapped = false;
+        if (!unmap())
+        {
+            // The contents of mapped buffers can be lost, for example on a mode switch.
+            GP_WARN("Mesh batch buffers were corrupted while mapped, discarding the batch.");
+            _vertexCount = 0;
+            _indexCount = 0;
+        }
+    }
+    else if (_vertexCount > 0)
+    {
+        // Orphan the buffers and upload the batch, so the driver does not wait
+        // for the draws of the previous batch to complete.
+        unsigned int vertexSize = _vertexFormat.getVertexSize();
+        GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, _mesh->getVertexBuffer()) );
+        GL_ASSERT( glBufferData(GL_ARRAY_BUFFER, _vertexCapacity * vertexSize, NULL, GL_STREAM_DRAW) );
+        GL_ASSERT( glBufferSubData(GL_ARRAY_BUFFER, 0, _vertexCount * vertexSize, _vertices) );
+        if (_indexed && _indexCount > 0)
+        {
+            GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _mesh->getPart(0)->getIndexBuffer()) );
+            GL_ASSERT( glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indexCapacity * sizeof(unsigned short), NULL, GL_STREAM_DRAW) );
+            GL_ASSERT( glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, _indexCount * sizeof(unsigned short), _indices) );
+        }
+    }
     _started = false;
 }
 
@@ -274,21 +424,8 @@ void MeshBatch::draw()
     if (_vertexCount == 0 || (_indexed && _indexCount == 0))
         return; // nothing to draw
 
-    // Not using VBOs, so unbind the element array buffer.
-    // ARRAY_BUFFER will be unbound automatically during pass->bind().
-    GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0 ) );
-
-#ifdef EMSCRIPTEN
-    if (!_indexed)
-    {
-        _model->draw();
-        return;
-    }
-#endif
-
     GP_ASSERT(_material);
-    if (_indexed)
-        GP_ASSERT(_indices);
+    GP_ASSERT(_mesh);
 
     // Bind the material.
     Technique* technique = _material->getTechnique();
@@ -302,7 +439,8 @@ void MeshBatch::draw()
 
         if (_indexed)
         {
-            GL_ASSERT( glDrawElements(_primitiveType, _indexCount, GL_UNSIGNED_SHORT, (GLvoid*)_indices) );
+            GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _mesh->getPart(0)->getIndexBuffer()) );
+            GL_ASSERT( glDrawElements(_primitiveType, _indexCount, GL_UNSIGNED_SHORT, 0) );
         }
         else
         {
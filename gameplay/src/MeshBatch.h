@@ -10,6 +10,15 @@ class Material;
 
 /**
  * Defines a class for rendering multiple mesh into a single draw call on the graphics device.
+ *
+ * The primitives of a batch are streamed into a dynamic vertex buffer, and index buffer for
+ * indexed batches, which are orphaned each time the batch is filled so the driver can give
+ * the batch new storage while the previous contents are still being drawn.
+ *
+ * A batch created with a growSize of zero has a fixed budget of primitives. When the platform
+ * supports it, such a batch maps its buffers in start() and primitives are written directly
+ * into the mapped memory, without a copy, until finish(). Batches that grow keep a copy of
+ * their primitives in memory and upload it in finish().
  */
 class MeshBatch
 {
@@ -23,7 +32,8 @@ public:
      * @param materialPath Path to a material file to be used for drawing the batch.
      * @param indexed True if the batched primitives will contain index data, false otherwise.
      * @param initialCapacity The initial capacity of the batch, in triangles.
-     * @param growSize Amount to grow the batch by when it overflows (a value of zero prevents batch growing).
+     * @param growSize Amount to grow the batch by when it overflows (a value of zero prevents batch growing
+     *      and streams the primitives directly into mapped buffers).
      *
      * @return A new mesh batch.
      * @script{create}
@@ -38,7 +48,8 @@ public:
      * @param material Material to be used for drawing the batch.
      * @param indexed True if the batched primitives will contain index data, false otherwise.
      * @param initialCapacity The initial capacity of the batch, in triangles.
-     * @param growSize Amount to grow the batch by when it overflows (a value of zero prevents batch growing).
+     * @param growSize Amount to grow the batch by when it overflows (a value of zero prevents batch growing
+     *      and streams the primitives directly into mapped buffers).
      *
      * @return A new mesh batch.
      * @script{create}
@@ -60,6 +71,8 @@ public:
     /**
      * Explicitly sets a new capacity for the batch.
      *
+     * The capacity of a batch that is mapped, between start() and finish(), cannot be changed.
+     *
      * @param capacity The new batch capacity.
      */
     void setCapacity(unsigned int capacity);
@@ -122,11 +135,35 @@ public:
      * The vertex list passed in should be a pointer of floats where every X floats represent a
      * single vertex (e.g. {x,y,z,u,v}).
      *
+     * The returned memory may be mapped graphics memory: it should only be written to, in order.
+     *
      * @param vertexCount Number of vertices.
+     *
+     * @return The first new vertex, or NULL if the batch is full.
      */
     template< class T >
     T * reserve(unsigned int vertexCount);
 
+    /**
+     * Reserves vertices and indices and returns pointer to first new vertex.
+     * Application then can write directly vertex and index data into the memory pointed by the
+     * returned pointers. Works only for indexed lists of primitives, not strips.
+     *
+     * The indices written are relative to the start of the batch: baseVertex should be added
+     * to the indices of the new vertices.
+     *
+     * The returned memory may be mapped graphics memory: it should only be written to, in order.
+     *
+     * @param vertexCount Number of vertices.
+     * @param indexCount Number of indices.
+     * @param indices Set to the first new index.
+     * @param baseVertex Set to the index of the first new vertex.
+     *
+     * @return The first new vertex, or NULL if the batch is full.
+     */
+    template< class T >
+    T * reserve(unsigned int vertexCount, unsigned int indexCount, unsigned short** indices, unsigned short* baseVertex);
+
     /**
      * Starts batching.
      *
@@ -173,10 +210,22 @@ private:
 
     void add(const void* vertices, size_t size, unsigned int vertexCount, const unsigned short* indices, unsigned int indexCount);
 
+    unsigned char* reserve(unsigned int vertexCount, unsigned int indexCount, unsigned short** indices);
+
     void updateVertexAttributeBinding();
 
     bool resize(unsigned int capacity);
 
+    /**
+     * Orphans and maps the buffers of the batch, returns false if they cannot be mapped.
+     */
+    bool map();
+
+    /**
+     * Unmaps the buffers of the batch, returns false if their contents were lost.
+     */
+    bool unmap();
+
     const VertexFormat _vertexFormat;
     Mesh::PrimitiveType _primitiveType;
     Material* _material;
@@ -191,11 +240,10 @@ private:
     unsigned char* _verticesPtr;
     unsigned short* _indices;
     unsigned short* _indicesPtr;
+    unsigned short _lastIndex;
     bool _started;
-
-#ifdef EMSCRIPTEN
-    Model * _model;
-#endif
+    bool _mapped;
+    Mesh* _mesh;
 };
 
 }
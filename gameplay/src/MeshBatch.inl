@@ -20,28 +20,25 @@ T * MeshBatch::reserve(unsigned int vertexCount)
 {
     GP_ASSERT(sizeof(T) == _vertexFormat.getVertexSize());
     GP_ASSERT(!_indexed);
-    
-    unsigned int newVertexCount = _vertexCount + vertexCount;
-    
-    // Do we need to grow the batch?
-    while (newVertexCount > _vertexCapacity)
-    {
-        if (_growSize == 0)
-            return NULL; // growing disabled, just clip batch
-        if (!resize(_capacity + _growSize))
-            return NULL; // failed to grow
-    }
-    
-    // Copy vertex data.
-    GP_ASSERT(_verticesPtr);
-    unsigned int vBytes = vertexCount * _vertexFormat.getVertexSize();
-
-    unsigned char* oldPtr = _verticesPtr;
-        
-    _verticesPtr += vBytes;
-    _vertexCount = newVertexCount;
-
-    return reinterpret_cast< T * >( oldPtr );
+
+    return reinterpret_cast< T * >( reserve(vertexCount, 0, NULL) );
+}
+
+template <class T>
+T * MeshBatch::reserve(unsigned int vertexCount, unsigned int indexCount, unsigned short** indices, unsigned short* baseVertex)
+{
+    GP_ASSERT(sizeof(T) == _vertexFormat.getVertexSize());
+    GP_ASSERT(_indexed);
+    GP_ASSERT(_primitiveType != Mesh::TRIANGLE_STRIP && _primitiveType != Mesh::LINE_STRIP);
+    GP_ASSERT(indices);
+    GP_ASSERT(baseVertex);
+
+    unsigned short base = (unsigned short)_vertexCount;
+    unsigned char* vertices = reserve(vertexCount, indexCount, indices);
+    if (vertices)
+        *baseVertex = base;
+
+    return reinterpret_cast< T * >( vertices );
 }
 
 }
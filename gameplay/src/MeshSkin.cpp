@@ -2,10 +2,14 @@
 #include "MeshSkin.h"
 #include "Joint.h"
 #include "Model.h"
+#include "Game.h"
 
 // The number of rows in each palette matrix.
 #define PALETTE_ROWS 3
 
+// The number of skins whose palettes are built by a single job.
+#define PALETTE_SKINS_PER_JOB 4
+
 namespace gameplay
 {
 
@@ -29,6 +33,7 @@ const Matrix& MeshSkin::getBindShape() const
 void MeshSkin::setBindShape(const float* matrix)
 {
     _bindShape.set(matrix);
+    std::fill(_matrixPaletteVersions.begin(), _matrixPaletteVersions.end(), 0);
 }
 
 unsigned int MeshSkin::getJointCount() const
@@ -116,9 +121,11 @@ void MeshSkin::setJointCount(unsigned int jointCount)
 
     // Resize the joints vector and initialize to NULL.
     _joints.resize(jointCount);
+    _matrixPaletteVersions.resize(jointCount);
     for (unsigned int i = 0; i < jointCount; i++)
     {
         _joints[i] = NULL;
+        _matrixPaletteVersions[i] = 0;
     }
 
     // Rebuild the matrix palette. Each matrix is 3 rows of Vector4.
@@ -147,6 +154,7 @@ void MeshSkin::setJoint(Joint* joint, unsigned int index)
     }
 
     _joints[index] = joint;
+    _matrixPaletteVersions[index] = 0;
 
     if (joint)
     {
@@ -159,12 +167,73 @@ Vector4* MeshSkin::getMatrixPalette() const
 {
     GP_ASSERT(_matrixPalette);
 
+    updateJointMatrices();
+    updateMatrixPalette();
+    return _matrixPalette;
+}
+
+void MeshSkin::updateMatrixPalettes(MeshSkin* const* skins, unsigned int count)
+{
+    // Resolving joint matrices walks up the node hierarchy, so it is done on the calling thread.
+    // Joints shared by several skins are only computed once.
+    for (unsigned int i = 0; i < count; i++)
+    {
+        GP_ASSERT(skins[i]);
+        skins[i]->updateJointMatrices();
+    }
+
+    JobScheduler* scheduler = Game::getInstance()->getJobScheduler();
+    if (!scheduler)
+    {
+        for (unsigned int i = 0; i < count; i++)
+            skins[i]->updateMatrixPalette();
+        return;
+    }
+
+    scheduler->parallelFor(count, [skins](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int i = begin; i < end; i++)
+            skins[i]->updateMatrixPalette();
+    }, PALETTE_SKINS_PER_JOB);
+}
+
+void MeshSkin::updateJointMatrices() const
+{
     for (size_t i = 0, count = _joints.size(); i < count; i++)
     {
         GP_ASSERT(_joints[i]);
-        _joints[i]->updateJointMatrix(getBindShape(), &_matrixPalette[i * PALETTE_ROWS]);
+        _joints[i]->updateJointMatrix();
+    }
+}
+
+void MeshSkin::updateMatrixPalette() const
+{
+    GP_ASSERT(_matrixPalette);
+
+    const bool bindShapeIdentity = _bindShape.isIdentity();
+    Matrix t;
+    for (size_t i = 0, count = _joints.size(); i < count; i++)
+    {
+        const Joint* joint = _joints[i];
+        GP_ASSERT(joint);
+        GP_ASSERT(!joint->_jointMatrixDirty);
+        if (_matrixPaletteVersions[i] == joint->_jointMatrixVersion)
+            continue;
+        _matrixPaletteVersions[i] = joint->_jointMatrixVersion;
+
+        // The palette stores the first three rows of the matrix, which are the
+        // first three columns of its transpose.
+        if (bindShapeIdentity)
+        {
+            joint->_jointMatrix.transpose(&t);
+        }
+        else
+        {
+            Matrix::multiply(joint->_jointMatrix, _bindShape, &t);
+            t.transpose();
+        }
+        memcpy(&_matrixPalette[i * PALETTE_ROWS].x, t.m, sizeof(float) * 4 * PALETTE_ROWS);
     }
-    return _matrixPalette;
 }
 
 unsigned int MeshSkin::getMatrixPaletteSize() const
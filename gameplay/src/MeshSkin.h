@@ -97,6 +97,21 @@ public:
      */
     Vector4* getMatrixPalette() const;
 
+    /**
+     * Updates the matrix palettes of a batch of skins.
+     *
+     * The joint matrices are resolved once on the calling thread, including the joints
+     * that are shared by several skins, then the palettes of the skins are built on the
+     * worker threads of the game's job scheduler. A following call to getMatrixPalette()
+     * returns the palette without recomputing it if the joints did not change.
+     *
+     * @param skins The skins to update.
+     * @param count The number of skins.
+     *
+     * @script{ignore}
+     */
+    static void updateMatrixPalettes(MeshSkin* const* skins, unsigned int count);
+
     /**
      * Returns the number of elements in the matrix palette array.
      * Each element is a Vector4* that represents a row.
@@ -175,6 +190,17 @@ private:
      */
     void clearJoints();
 
+    /**
+     * Updates the joint matrices of all the joints of this skin. Must not be called concurrently.
+     */
+    void updateJointMatrices() const;
+
+    /**
+     * Builds the palette entries of the joints whose joint matrix changed since the last update.
+     * The joint matrices must be up to date. Different skins can be updated concurrently.
+     */
+    void updateMatrixPalette() const;
+
     Matrix _bindShape;
     std::vector<Joint*> _joints;
     Joint* _rootJoint;
@@ -189,6 +215,8 @@ private:
     // Each 4x3 row-wise matrix is represented as 3 Vector4's.
     // The number of Vector4's is (_joints.size() * 3).
     Vector4* _matrixPalette;
+    // The joint matrix version each palette entry was built from, zero if the entry is out of date.
+    mutable std::vector<unsigned int> _matrixPaletteVersions;
     Model* _model;
 };
 
@@ -5,17 +5,23 @@
 #include "Technique.h"
 #include "Pass.h"
 #include "Node.h"
+#include "SoftwareSkin.h"
+#include "RenderQueue.h"
+#include "Game.h"
+
+// Number of models skinned by a single job.
+#define SOFTWARE_SKIN_MODELS_PER_JOB 1
 
 namespace gameplay
 {
 
 Model::Model() : Drawable(),
-    _mesh(NULL), _material(NULL), _partCount(0), _partMaterials(NULL), _skin(NULL)
+    _mesh(NULL), _material(NULL), _partCount(0), _partMaterials(NULL), _skin(NULL), _softwareSkin(NULL)
 {
 }
 
 Model::Model(Mesh* mesh) : Drawable(),
-    _mesh(mesh), _material(NULL), _partCount(0), _partMaterials(NULL), _skin(NULL)
+    _mesh(mesh), _material(NULL), _partCount(0), _partMaterials(NULL), _skin(NULL), _softwareSkin(NULL)
 {
     GP_ASSERT(mesh);
     _partCount = mesh->getPartCount();
@@ -32,6 +38,7 @@ Model::~Model()
         }
         SAFE_DELETE_ARRAY(_partMaterials);
     }
+    SAFE_RELEASE(_softwareSkin);
     SAFE_RELEASE(_mesh);
     SAFE_DELETE(_skin);
 }
@@ -251,6 +258,68 @@ void Model::setSkin(MeshSkin* skin)
     }
 }
 
+bool Model::setSoftwareSkinning(bool enabled)
+{
+    GP_ASSERT(_mesh);
+
+    if (!enabled)
+    {
+        SAFE_RELEASE(_softwareSkin);
+        return true;
+    }
+    if (_softwareSkin)
+        return true;
+
+    _softwareSkin = SoftwareSkin::create(_mesh);
+    return _softwareSkin != NULL;
+}
+
+bool Model::isSoftwareSkinning() const
+{
+    return _softwareSkin != NULL;
+}
+
+void Model::updateSoftwareSkins(Model* const* models, unsigned int count)
+{
+    std::vector<Model*> skinned;
+    std::vector<MeshSkin*> skins;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        GP_ASSERT(models[i]);
+        if (models[i]->_softwareSkin && models[i]->_skin)
+        {
+            skinned.push_back(models[i]);
+            skins.push_back(models[i]->_skin);
+        }
+    }
+    if (skinned.empty())
+        return;
+
+    MeshSkin::updateMatrixPalettes(&skins[0], (unsigned int)skins.size());
+
+    // Keep the results of this batch cached until they are bound.
+    SoftwareSkin::beginPrepare();
+
+    // The palettes are up to date, so reading them on the worker threads does not modify the skins.
+    std::vector<const Vector4*> palettes(skins.size());
+    for (size_t i = 0; i < skins.size(); ++i)
+        palettes[i] = skins[i]->getMatrixPalette();
+
+    JobScheduler* scheduler = Game::getInstance()->getJobScheduler();
+    if (!scheduler)
+    {
+        for (size_t i = 0; i < skinned.size(); ++i)
+            skinned[i]->_softwareSkin->prepare(palettes[i], skins[i]->getMatrixPaletteSize());
+        return;
+    }
+
+    scheduler->parallelFor((unsigned int)skinned.size(), [&skinned, &skins, &palettes](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int i = begin; i < end; ++i)
+            skinned[i]->_softwareSkin->prepare(palettes[i], skins[i]->getMatrixPaletteSize());
+    }, SOFTWARE_SKIN_MODELS_PER_JOB);
+}
+
 void Model::setNode(Node* node)
 {
     Drawable::setNode(node);
@@ -355,6 +424,16 @@ unsigned int Model::draw(bool wireframe) const
 {
     GP_ASSERT(_mesh);
 
+    // While a render queue is recording, the draw calls are issued by RenderQueue::end().
+    RenderQueue* queue = RenderQueue::getActive();
+    if (queue)
+    {
+        queue->add(this, wireframe);
+        return _mesh->getPartCount();
+    }
+
+    bindSoftwareSkin();
+
     unsigned int partCount = _mesh->getPartCount();
     if (partCount == 0)
     {
@@ -370,10 +449,7 @@ unsigned int Model::draw(bool wireframe) const
                 GP_ASSERT(pass);
                 pass->bind();
                 GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
-                if (!wireframe || !drawWireframe(_mesh))
-                {
-                    GL_ASSERT( glDrawArrays(_mesh->getPrimitiveType(), 0, _mesh->getVertexCount()) );
-                }
+                drawGeometry(NULL, wireframe);
                 pass->unbind();
             }
         }
@@ -398,10 +474,7 @@ unsigned int Model::draw(bool wireframe) const
                     GP_ASSERT(pass);
                     pass->bind();
                     GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, part->_indexBuffer) );
-                    if (!wireframe || !drawWireframe(part))
-                    {
-                        GL_ASSERT( glDrawElements(part->getPrimitiveType(), part->getIndexCount(), part->getIndexFormat(), 0) );
-                    }
+                    drawGeometry(part, wireframe);
                     pass->unbind();
                 }
             }
@@ -410,6 +483,29 @@ unsigned int Model::draw(bool wireframe) const
     return partCount;
 }
 
+void Model::bindSoftwareSkin() const
+{
+    if (_softwareSkin && _skin)
+    {
+        _softwareSkin->bind(_skin->getMatrixPalette(), _skin->getMatrixPaletteSize());
+    }
+}
+
+void Model::drawGeometry(MeshPart* part, bool wireframe) const
+{
+    if (part)
+    {
+        if (!wireframe || !drawWireframe(part))
+        {
+            GL_ASSERT( glDrawElements(part->getPrimitiveType(), part->getIndexCount(), part->getIndexFormat(), 0) );
+        }
+    }
+    else if (!wireframe || !drawWireframe(_mesh))
+    {
+        GL_ASSERT( glDrawArrays(_mesh->getPrimitiveType(), 0, _mesh->getVertexCount()) );
+    }
+}
+
 void Model::setMaterialNodeBinding(Material *material)
 {
     GP_ASSERT(material);
@@ -433,6 +529,11 @@ Drawable* Model::clone(NodeCloneContext& context)
     {
         model->setSkin(getSkin()->clone(context));
     }
+    if (_softwareSkin)
+    {
+        model->_softwareSkin = _softwareSkin;
+        _softwareSkin->addRef();
+    }
     if (getMaterial())
     {
         Material* materialClone = getMaterial()->clone(context);
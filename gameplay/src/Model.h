@@ -11,6 +11,7 @@ namespace gameplay
 
 class Bundle;
 class MeshSkin;
+class SoftwareSkin;
 
 
 /**
@@ -25,6 +26,8 @@ class Model : public Ref, public Drawable
     friend class Scene;
     friend class Mesh;
     friend class Bundle;
+    friend class RenderQueue;
+    friend class InstancedModel;
 
 public:
 
@@ -131,6 +134,46 @@ public:
      */
     MeshSkin* getSkin() const;
 
+    /**
+     * Enables or disables skinning on the CPU for this model.
+     *
+     * When enabled, the vertices of the mesh are skinned on the CPU and streamed to its
+     * vertex buffer before the model is drawn, which removes the joint count limit of the
+     * skinning shaders. The materials of the model must not use the SKINNING define.
+     * Models sharing a mesh and playing the same animation frame share the skinned vertices.
+     *
+     * @param enabled true to skin on the CPU, false to skin in the shaders.
+     *
+     * @return true if the mode was changed, false if the mesh bind pose could not be loaded.
+     *
+     * @see SoftwareSkin
+     * @script{ignore}
+     */
+    bool setSoftwareSkinning(bool enabled);
+
+    /**
+     * Determines whether this model is skinned on the CPU.
+     *
+     * @return true if the model is skinned on the CPU.
+     *
+     * @script{ignore}
+     */
+    bool isSoftwareSkinning() const;
+
+    /**
+     * Skins a batch of models on the CPU ahead of drawing them.
+     *
+     * The matrix palettes of the models are updated, then the vertices of the models are
+     * skinned on the worker threads of the game's job scheduler. Models that are not
+     * skinned on the CPU are ignored.
+     *
+     * @param models The models to skin.
+     * @param count The number of models.
+     *
+     * @script{ignore}
+     */
+    static void updateSoftwareSkins(Model* const* models, unsigned int count);
+
     /**
      * @see Drawable::draw
      *
@@ -188,11 +231,23 @@ private:
 
     void validatePartCount();
 
+    /**
+     * Uploads the vertices skinned on the CPU for this model, if it is skinned on the CPU.
+     */
+    void bindSoftwareSkin() const;
+
+    /**
+     * Issues the draw call of a mesh part, or of the whole mesh if part is NULL.
+     * The pass and the index buffer must be bound.
+     */
+    void drawGeometry(MeshPart* part, bool wireframe) const;
+
     Mesh* _mesh;
     Material* _material;
     unsigned int _partCount;
     Material** _partMaterials;
     MeshSkin* _skin;
+    SoftwareSkin* _softwareSkin;
 };
 
 }
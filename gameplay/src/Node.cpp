@@ -9,16 +9,20 @@
 #include "PhysicsGhostObject.h"
 #include "PhysicsCharacter.h"
 #include "Terrain.h"
+#include "InstancedModel.h"
 #include "Game.h"
 #include "Drawable.h"
 #include "Form.h"
 #include "Ref.h"
+#include "BoundingVolumeHierarchy.h"
 
 // Node dirty flags
 #define NODE_DIRTY_WORLD 1
 #define NODE_DIRTY_BOUNDS 2
 #define NODE_DIRTY_HIERARCHY 4
 #define NODE_DIRTY_ALL (NODE_DIRTY_WORLD | NODE_DIRTY_BOUNDS | NODE_DIRTY_HIERARCHY)
+// Set while the node is queued for an update of the drawable tree of its scene
+#define NODE_DIRTY_CULLING 8
 
 namespace gameplay
 {
@@ -26,7 +30,7 @@ namespace gameplay
 Node::Node(const char* id)
     : _scene(NULL), _firstChild(NULL), _nextSibling(NULL), _prevSibling(NULL), _parent(NULL), _childCount(0), _enabled(true), _tags(NULL),
     _drawable(NULL), _camera(NULL), _light(NULL), _audioSource(NULL), _collisionObject(NULL), _agent(NULL), _userObject(NULL),
-      _dirtyBits(NODE_DIRTY_ALL)
+      _dirtyBits(NODE_DIRTY_ALL), _cullingProxy(-1)
 {
     GP_REGISTER_SCRIPT_EVENTS();
     if (id)
@@ -121,6 +125,11 @@ void Node::addChild(Node* child)
     child->_parent = this;
     ++_childCount;
     setBoundsDirty();
+    sceneHierarchyChanged();
+
+    Scene* scene = getScene();
+    if (scene && scene->_drawableTree)
+        scene->insertDrawables(child);
 
     if (_dirtyBits & NODE_DIRTY_HIERARCHY)
     {
@@ -154,6 +163,11 @@ void Node::removeAllChildren()
 
 void Node::remove()
 {
+    // Take our drawables out of the drawable tree of the scene we are leaving.
+    Scene* scene = getScene();
+    if (scene && scene->_drawableTree)
+        scene->removeDrawables(this);
+
     // Re-link our neighbours.
     if (_prevSibling)
     {
@@ -177,9 +191,11 @@ void Node::remove()
     _prevSibling = NULL;
     _parent = NULL;
 
-    if (parent && parent->_dirtyBits & NODE_DIRTY_HIERARCHY)
+    if (parent)
     {
-        parent->hierarchyChanged();
+        parent->sceneHierarchyChanged();
+        if (parent->_dirtyBits & NODE_DIRTY_HIERARCHY)
+            parent->hierarchyChanged();
     }
 }
 
@@ -467,6 +483,28 @@ const Matrix& Node::getWorldMatrix() const
     return _world;
 }
 
+void Node::updateWorldMatrix() const
+{
+    if (_dirtyBits & NODE_DIRTY_WORLD)
+    {
+        _dirtyBits &= ~NODE_DIRTY_WORLD;
+
+        if (!isStatic())
+        {
+            Node* parent = getParent();
+            if (parent && (!_collisionObject || _collisionObject->isKinematic()))
+            {
+                GP_ASSERT(!(parent->_dirtyBits & NODE_DIRTY_WORLD));
+                Matrix::multiply(parent->_world, getMatrix(), &_world);
+            }
+            else
+            {
+                _world = getMatrix();
+            }
+        }
+    }
+}
+
 const Matrix& Node::getWorldViewMatrix() const
 {
     static Matrix worldView;
@@ -662,6 +700,8 @@ void Node::transformChanged()
 {
     // Our local transform was changed, so mark our world matrices dirty.
     _dirtyBits |= NODE_DIRTY_WORLD | NODE_DIRTY_BOUNDS;
+    if (_cullingProxy >= 0)
+        queueCullingUpdate();
 
     // Notify our children that their transform has also changed (since transforms are inherited).
     for (Node* n = getFirstChild(); n != NULL; n = n->getNextSibling())
@@ -683,10 +723,65 @@ void Node::transformChanged()
     Transform::transformChanged();
 }
 
+void Node::sceneHierarchyChanged()
+{
+    Scene* scene = getScene();
+    if (scene)
+        scene->_nodeOrderDirty = true;
+}
+
+void Node::queueCullingUpdate()
+{
+    if (_dirtyBits & NODE_DIRTY_CULLING)
+        return;
+
+    Scene* scene = getScene();
+    if (scene && scene->_drawableTree)
+    {
+        _dirtyBits |= NODE_DIRTY_CULLING;
+        scene->_drawableTreeUpdates.push_back(this);
+    }
+}
+
+void Node::updateCullingProxy(BoundingVolumeHierarchy* tree)
+{
+    GP_ASSERT(tree);
+
+    _dirtyBits &= ~NODE_DIRTY_CULLING;
+    if (_drawable)
+    {
+        if (_cullingProxy < 0)
+            _cullingProxy = tree->insert(getBoundingSphere(), this);
+        else
+            tree->update(_cullingProxy, getBoundingSphere());
+    }
+    else if (_cullingProxy >= 0)
+    {
+        tree->remove(_cullingProxy);
+        _cullingProxy = -1;
+    }
+}
+
+bool Node::removeCullingProxy(BoundingVolumeHierarchy* tree)
+{
+    GP_ASSERT(tree);
+
+    if (_cullingProxy >= 0)
+    {
+        tree->remove(_cullingProxy);
+        _cullingProxy = -1;
+    }
+    bool queued = (_dirtyBits & NODE_DIRTY_CULLING) != 0;
+    _dirtyBits &= ~NODE_DIRTY_CULLING;
+    return queued;
+}
+
 void Node::setBoundsDirty()
 {
     // Mark ourself and our parent nodes as dirty
     _dirtyBits |= NODE_DIRTY_BOUNDS;
+    if (_cullingProxy >= 0)
+        queueCullingUpdate();
 
     // Mark our parent bounds as dirty as well
     if (_parent)
@@ -831,6 +926,7 @@ void Node::setDrawable(Drawable* drawable)
                 ref->addRef();
             _drawable->setNode(this);
         }
+        queueCullingUpdate();
     }
     setBoundsDirty();
 }
@@ -865,6 +961,19 @@ const BoundingSphere& Node::getBoundingSphere() const
                 _bounds.merge(model->getMesh()->getBoundingSphere());
             }
         }
+        InstancedModel* instancedModel = dynamic_cast<InstancedModel*>(_drawable);
+        if (instancedModel && instancedModel->getInstanceCount() > 0)
+        {
+            if (empty)
+            {
+                _bounds.set(instancedModel->getBoundingSphere());
+                empty = false;
+            }
+            else
+            {
+                _bounds.merge(instancedModel->getBoundingSphere());
+            }
+        }
         if (_light)
         {
             switch (_light->getLightType())
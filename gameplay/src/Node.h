@@ -25,6 +25,7 @@ class Light;
 class AudioSource;
 class AIAgent;
 class Drawable;
+class BoundingVolumeHierarchy;
 
 /**
  * Defines a hierarchical structure of objects in 3D transformation spaces.
@@ -41,6 +42,7 @@ class Node : public Transform, public Ref
     friend class Bundle;
     friend class MeshSkin;
     friend class Light;
+    friend class InstancedModel;
 
     GP_SCRIPT_EVENTS_START();
     GP_SCRIPT_EVENT(update, "<Node>f");
@@ -665,6 +667,37 @@ protected:
      */
     void setBoundsDirty();
 
+    /**
+     * Resolves the world matrix of this node if it is dirty, assuming the
+     * world matrix of the parent node is already resolved.
+     *
+     * Used by the scene to update world matrices in a single pass, without
+     * recursing through the parent and child nodes.
+     */
+    void updateWorldMatrix() const;
+
+    /**
+     * Notifies the scene this node belongs to that its node hierarchy changed.
+     */
+    void sceneHierarchyChanged();
+
+    /**
+     * Queues the node for an update of its bounding sphere in the drawable tree of its scene.
+     */
+    void queueCullingUpdate();
+
+    /**
+     * Inserts, moves or removes the drawable of the node in a drawable tree, as queued.
+     */
+    void updateCullingProxy(BoundingVolumeHierarchy* tree);
+
+    /**
+     * Removes the drawable of the node from a drawable tree.
+     *
+     * @return true if the node was queued for an update, which is cancelled.
+     */
+    bool removeCullingProxy(BoundingVolumeHierarchy* tree);
+
     /**
      * Returns the first child node that matches the given ID.
      *
@@ -752,6 +785,8 @@ protected:
     mutable BoundingSphere _bounds;
     /** The dirty bits used for optimization. */
     mutable int _dirtyBits;
+    /** The proxy of the drawable in the drawable tree of the scene, or -1. */
+    int _cullingProxy;
 };
 
 /**
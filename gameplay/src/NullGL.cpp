@@ -0,0 +1,1003 @@
+#ifdef GP_NULL_GL
+
+#include "Base.h"
+#include "NullGL.h"
+
+// Limits reported by glGetIntegerv.
+#define NULL_GL_MAX_VERTEX_ATTRIBS 16
+#define NULL_GL_MAX_COLOR_ATTACHMENTS 8
+#define NULL_GL_MAX_TEXTURE_SIZE 8192
+#define NULL_GL_MAX_TEXTURE_UNITS 16
+
+using namespace gameplay;
+
+/**
+ * An attribute or uniform declared in a shader source.
+ */
+struct NullGLVariable
+{
+    std::string name;
+    GLenum type;
+    GLint size;
+    GLint location;
+};
+
+struct NullGLShader
+{
+    GLenum type;
+    std::string source;
+};
+
+struct NullGLProgram
+{
+    std::vector<GLuint> shaders;
+    std::vector<NullGLVariable> attributes;
+    std::vector<NullGLVariable> uniforms;
+};
+
+static NullGL::Statistics __statistics;
+static GLuint __lastName = 0;
+static std::unordered_map<unsigned long long, unsigned long long> __state;
+static std::unordered_map<GLuint, GLsizeiptr> __buffers;
+static std::unordered_map<GLenum, GLuint> __boundBuffers;
+static std::unordered_map<GLuint, NullGLShader> __shaders;
+static std::unordered_map<GLuint, NullGLProgram> __programs;
+static std::set<GLuint> __textures;
+static std::set<GLuint> __vertexArrays;
+static std::unordered_map<GLenum, std::vector<unsigned char> > __mappedBuffers;
+static GLuint __activeTexture = 0;
+static GLuint __vertexArray = 0;
+static GLuint __framebuffer = 0;
+static GLint __viewport[4] = { 0, 0, 0, 0 };
+
+static const char* __entryPointNames[] =
+{
+#define GP_NULL_GL_NAME(name) "gl" #name,
+    GP_NULL_GL_ENTRY_POINTS(GP_NULL_GL_NAME)
+#undef GP_NULL_GL_NAME
+};
+
+static inline void record(NullGL::EntryPoint entryPoint)
+{
+    ++__statistics.calls[entryPoint];
+}
+
+/**
+ * Records a state change. The state is identified by the entry point that sets it and a
+ * target, such as the capability or the bind point.
+ */
+static void changeState(NullGL::EntryPoint state, unsigned long long target, unsigned long long value)
+{
+    ++__statistics.stateChanges;
+
+    const unsigned long long key = ((unsigned long long)state << 48) ^ target;
+    std::unordered_map<unsigned long long, unsigned long long>::iterator itr = __state.find(key);
+    if (itr == __state.end())
+    {
+        __state[key] = value;
+    }
+    else if (itr->second == value)
+    {
+        ++__statistics.redundantStateChanges;
+    }
+    else
+    {
+        itr->second = value;
+    }
+}
+
+static void genNames(GLsizei n, GLuint* names)
+{
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        names[i] = ++__lastName;
+    }
+}
+
+static void recordDraw(GLsizei count, GLsizei instances)
+{
+    ++__statistics.drawCalls;
+    __statistics.verticesDrawn += (unsigned long long)count * (unsigned long long)instances;
+}
+
+static void recordUniform(GLsizei count, size_t size)
+{
+    __statistics.uniformBytes += (unsigned long long)count * size;
+}
+
+static size_t getPixelSize(GLenum format, GLenum type)
+{
+    switch (type)
+    {
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+        return 2;
+    default:
+        break;
+    }
+
+    size_t components;
+    switch (format)
+    {
+    case GL_RGBA:
+        components = 4;
+        break;
+    case GL_RGB:
+        components = 3;
+        break;
+    case GL_LUMINANCE_ALPHA:
+        components = 2;
+        break;
+    default:
+        components = 1;
+        break;
+    }
+
+    switch (type)
+    {
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+        return components * 2;
+    case GL_UNSIGNED_INT:
+    case GL_INT:
+    case GL_FLOAT:
+        return components * 4;
+    default:
+        return components;
+    }
+}
+
+static GLenum getVariableType(const std::string& type)
+{
+    if (type == "float") return GL_FLOAT;
+    if (type == "vec2") return GL_FLOAT_VEC2;
+    if (type == "vec3") return GL_FLOAT_VEC3;
+    if (type == "vec4") return GL_FLOAT_VEC4;
+    if (type == "mat3") return GL_FLOAT_MAT3;
+    if (type == "mat4") return GL_FLOAT_MAT4;
+    if (type == "int") return GL_INT;
+    if (type == "bool") return GL_BOOL;
+    if (type == "sampler2D") return GL_SAMPLER_2D;
+    if (type == "samplerCube") return GL_SAMPLER_CUBE;
+    return GL_FLOAT_VEC4;
+}
+
+/**
+ * Adds the variables declared with a storage qualifier in a shader source. Declarations
+ * in conditional blocks are added whether or not the block is compiled.
+ */
+static void parseDeclarations(const std::string& source, const char* qualifier, std::vector<NullGLVariable>& variables)
+{
+    std::istringstream lines(source);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        std::istringstream tokens(line);
+        std::string token;
+        if (!(tokens >> token) || token != qualifier)
+            continue;
+
+        std::string type;
+        while (tokens >> type && (type == "lowp" || type == "mediump" || type == "highp"))
+            ;
+
+        std::string declarators;
+        std::getline(tokens, declarators, ';');
+        std::istringstream names(declarators);
+        std::string declarator;
+        while (std::getline(names, declarator, ','))
+        {
+            NullGLVariable variable;
+            variable.type = getVariableType(type);
+            variable.size = 1;
+            size_t bracket = declarator.find('[');
+            if (bracket != std::string::npos)
+            {
+                // Array sizes that are not literals, such as macros, count as one element.
+                int size = atoi(declarator.c_str() + bracket + 1);
+                variable.size = size > 0 ? size : 1;
+                declarator.erase(bracket);
+            }
+            std::istringstream name(declarator);
+            if (!(name >> variable.name))
+                continue;
+
+            bool declared = false;
+            for (size_t i = 0, count = variables.size(); i < count && !declared; ++i)
+            {
+                declared = variables[i].name == variable.name;
+            }
+            if (!declared)
+            {
+                // Uniform arrays take one location per element, like they do in GL.
+                variable.location = variables.empty() ? 0 : variables.back().location + (qualifier[0] == 'u' ? variables.back().size : 1);
+                variables.push_back(variable);
+            }
+        }
+    }
+}
+
+static NullGLProgram* getProgram(GLuint program)
+{
+    std::unordered_map<GLuint, NullGLProgram>::iterator itr = __programs.find(program);
+    return itr == __programs.end() ? NULL : &itr->second;
+}
+
+static void getActiveVariable(const std::vector<NullGLVariable>& variables, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    GP_ASSERT(index < variables.size());
+    const NullGLVariable& variable = variables[index];
+    GLsizei nameLength = (GLsizei)std::min(variable.name.size(), (size_t)(bufSize > 0 ? bufSize - 1 : 0));
+    if (name && bufSize > 0)
+    {
+        memcpy(name, variable.name.c_str(), nameLength);
+        name[nameLength] = '\0';
+    }
+    if (length)
+        *length = nameLength;
+    if (size)
+        *size = variable.size;
+    if (type)
+        *type = variable.type;
+}
+
+static GLint getMaxNameLength(const std::vector<NullGLVariable>& variables)
+{
+    size_t length = 0;
+    for (size_t i = 0, count = variables.size(); i < count; ++i)
+    {
+        length = std::max(length, variables[i].name.size() + 1);
+    }
+    return (GLint)length;
+}
+
+namespace gameplay
+{
+
+const NullGL::Statistics& NullGL::getStatistics()
+{
+    return __statistics;
+}
+
+void NullGL::resetStatistics()
+{
+    memset(&__statistics, 0, sizeof(__statistics));
+}
+
+const char* NullGL::getEntryPointName(EntryPoint entryPoint)
+{
+    GP_ASSERT(entryPoint < ENTRY_POINT_COUNT);
+    return __entryPointNames[entryPoint];
+}
+
+}
+
+void nullglActiveTexture(GLenum texture)
+{
+    record(NullGL::ActiveTexture);
+    changeState(NullGL::ActiveTexture, 0, texture);
+    __activeTexture = texture - GL_TEXTURE0;
+}
+
+void nullglAttachShader(GLuint program, GLuint shader)
+{
+    record(NullGL::AttachShader);
+    NullGLProgram* p = getProgram(program);
+    if (p)
+    {
+        p->shaders.push_back(shader);
+    }
+}
+
+void nullglBindAttribLocation(GLuint program, GLuint index, const GLchar* name)
+{
+    record(NullGL::BindAttribLocation);
+}
+
+void nullglBindBuffer(GLenum target, GLuint buffer)
+{
+    // The element array buffer binding is part of the vertex array object state.
+    record(NullGL::BindBuffer);
+    changeState(NullGL::BindBuffer, target == GL_ELEMENT_ARRAY_BUFFER ? ((unsigned long long)__vertexArray << 16) | target : target, buffer);
+    __boundBuffers[target] = buffer;
+}
+
+void nullglBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    record(NullGL::BindFramebuffer);
+    changeState(NullGL::BindFramebuffer, 0, framebuffer);
+    __framebuffer = framebuffer;
+}
+
+void nullglBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    record(NullGL::BindRenderbuffer);
+    changeState(NullGL::BindRenderbuffer, target, renderbuffer);
+}
+
+void nullglBindTexture(GLenum target, GLuint texture)
+{
+    record(NullGL::BindTexture);
+    changeState(NullGL::BindTexture, ((unsigned long long)__activeTexture << 16) | target, texture);
+    __textures.insert(texture);
+}
+
+void nullglBindVertexArray(GLuint array)
+{
+    record(NullGL::BindVertexArray);
+    changeState(NullGL::BindVertexArray, 0, array);
+    __vertexArray = array;
+}
+
+void nullglBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+    record(NullGL::BlendFunc);
+    changeState(NullGL::BlendFunc, 0, ((unsigned long long)sfactor << 32) | dfactor);
+}
+
+void nullglBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+    record(NullGL::BufferData);
+    __buffers[__boundBuffers[target]] = size;
+    if (data)
+    {
+        __statistics.bufferBytes += size;
+    }
+}
+
+void nullglBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+    record(NullGL::BufferSubData);
+    __statistics.bufferBytes += size;
+}
+
+GLenum nullglCheckFramebufferStatus(GLenum target)
+{
+    record(NullGL::CheckFramebufferStatus);
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void nullglClear(GLbitfield mask)
+{
+    record(NullGL::Clear);
+}
+
+void nullglClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    unsigned long long value = std::hash<float>()(red);
+    value = value * 31 + std::hash<float>()(green);
+    value = value * 31 + std::hash<float>()(blue);
+    value = value * 31 + std::hash<float>()(alpha);
+    record(NullGL::ClearColor);
+    changeState(NullGL::ClearColor, 0, value);
+}
+
+void nullglClearDepth(GLclampd depth)
+{
+    record(NullGL::ClearDepth);
+    changeState(NullGL::ClearDepth, 0, std::hash<double>()(depth));
+}
+
+void nullglClearStencil(GLint s)
+{
+    record(NullGL::ClearStencil);
+    changeState(NullGL::ClearStencil, 0, (unsigned int)s);
+}
+
+void nullglCompileShader(GLuint shader)
+{
+    record(NullGL::CompileShader);
+}
+
+void nullglCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data)
+{
+    record(NullGL::CompressedTexImage2D);
+    if (data)
+    {
+        __statistics.textureBytes += imageSize;
+    }
+}
+
+GLuint nullglCreateProgram()
+{
+    record(NullGL::CreateProgram);
+    GLuint program = ++__lastName;
+    __programs[program] = NullGLProgram();
+    return program;
+}
+
+GLuint nullglCreateShader(GLenum type)
+{
+    record(NullGL::CreateShader);
+    GLuint shader = ++__lastName;
+    __shaders[shader].type = type;
+    return shader;
+}
+
+void nullglCullFace(GLenum mode)
+{
+    record(NullGL::CullFace);
+    changeState(NullGL::CullFace, 0, mode);
+}
+
+void nullglDeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    record(NullGL::DeleteBuffers);
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        __buffers.erase(buffers[i]);
+    }
+}
+
+void nullglDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+{
+    record(NullGL::DeleteFramebuffers);
+}
+
+void nullglDeleteProgram(GLuint program)
+{
+    record(NullGL::DeleteProgram);
+    __programs.erase(program);
+}
+
+void nullglDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+{
+    record(NullGL::DeleteRenderbuffers);
+}
+
+void nullglDeleteShader(GLuint shader)
+{
+    record(NullGL::DeleteShader);
+}
+
+void nullglDeleteTextures(GLsizei n, const GLuint* textures)
+{
+    record(NullGL::DeleteTextures);
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        __textures.erase(textures[i]);
+    }
+}
+
+void nullglDeleteVertexArrays(GLsizei n, const GLuint* arrays)
+{
+    record(NullGL::DeleteVertexArrays);
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        __vertexArrays.erase(arrays[i]);
+    }
+}
+
+void nullglDepthFunc(GLenum func)
+{
+    record(NullGL::DepthFunc);
+    changeState(NullGL::DepthFunc, 0, func);
+}
+
+void nullglDepthMask(GLboolean flag)
+{
+    record(NullGL::DepthMask);
+    changeState(NullGL::DepthMask, 0, flag);
+}
+
+void nullglDisable(GLenum cap)
+{
+    // Enabling and disabling a capability set the same state.
+    record(NullGL::Disable);
+    changeState(NullGL::Enable, cap, GL_FALSE);
+}
+
+void nullglDisableVertexAttribArray(GLuint index)
+{
+    record(NullGL::DisableVertexAttribArray);
+    changeState(NullGL::EnableVertexAttribArray, ((unsigned long long)__vertexArray << 16) | index, GL_FALSE);
+}
+
+void nullglDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    record(NullGL::DrawArrays);
+    recordDraw(count, 1);
+}
+
+void nullglDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei primcount)
+{
+    record(NullGL::DrawArraysInstanced);
+    recordDraw(count, primcount);
+}
+
+void nullglDrawBuffer(GLenum mode)
+{
+    record(NullGL::DrawBuffer);
+}
+
+void nullglDrawBuffers(GLsizei n, const GLenum* bufs)
+{
+    record(NullGL::DrawBuffers);
+}
+
+void nullglDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+    record(NullGL::DrawElements);
+    recordDraw(count, 1);
+}
+
+void nullglDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount)
+{
+    record(NullGL::DrawElementsInstanced);
+    recordDraw(count, primcount);
+}
+
+void nullglEnable(GLenum cap)
+{
+    record(NullGL::Enable);
+    changeState(NullGL::Enable, cap, GL_TRUE);
+}
+
+void nullglEnableVertexAttribArray(GLuint index)
+{
+    record(NullGL::EnableVertexAttribArray);
+    changeState(NullGL::EnableVertexAttribArray, ((unsigned long long)__vertexArray << 16) | index, GL_TRUE);
+}
+
+void nullglFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+    record(NullGL::FramebufferRenderbuffer);
+}
+
+void nullglFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    record(NullGL::FramebufferTexture2D);
+}
+
+void nullglFrontFace(GLenum mode)
+{
+    record(NullGL::FrontFace);
+    changeState(NullGL::FrontFace, 0, mode);
+}
+
+void nullglGenBuffers(GLsizei n, GLuint* buffers)
+{
+    record(NullGL::GenBuffers);
+    genNames(n, buffers);
+}
+
+void nullglGenFramebuffers(GLsizei n, GLuint* framebuffers)
+{
+    record(NullGL::GenFramebuffers);
+    genNames(n, framebuffers);
+}
+
+void nullglGenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+{
+    record(NullGL::GenRenderbuffers);
+    genNames(n, renderbuffers);
+}
+
+void nullglGenTextures(GLsizei n, GLuint* textures)
+{
+    record(NullGL::GenTextures);
+    genNames(n, textures);
+}
+
+void nullglGenVertexArrays(GLsizei n, GLuint* arrays)
+{
+    record(NullGL::GenVertexArrays);
+    genNames(n, arrays);
+    __vertexArrays.insert(arrays, arrays + n);
+}
+
+void nullglGenerateMipmap(GLenum target)
+{
+    record(NullGL::GenerateMipmap);
+}
+
+void nullglGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    record(NullGL::GetActiveAttrib);
+    NullGLProgram* p = getProgram(program);
+    GP_ASSERT(p);
+    getActiveVariable(p->attributes, index, bufSize, length, size, type, name);
+}
+
+void nullglGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    record(NullGL::GetActiveUniform);
+    NullGLProgram* p = getProgram(program);
+    GP_ASSERT(p);
+    getActiveVariable(p->uniforms, index, bufSize, length, size, type, name);
+}
+
+GLint nullglGetAttribLocation(GLuint program, const GLchar* name)
+{
+    record(NullGL::GetAttribLocation);
+    NullGLProgram* p = getProgram(program);
+    if (p)
+    {
+        for (size_t i = 0, count = p->attributes.size(); i < count; ++i)
+        {
+            if (p->attributes[i].name == name)
+                return p->attributes[i].location;
+        }
+    }
+    return -1;
+}
+
+GLenum nullglGetError()
+{
+    record(NullGL::GetError);
+    return GL_NO_ERROR;
+}
+
+void nullglGetIntegerv(GLenum pname, GLint* params)
+{
+    record(NullGL::GetIntegerv);
+    switch (pname)
+    {
+    case GL_MAX_VERTEX_ATTRIBS:
+        *params = NULL_GL_MAX_VERTEX_ATTRIBS;
+        break;
+    case GL_MAX_COLOR_ATTACHMENTS:
+        *params = NULL_GL_MAX_COLOR_ATTACHMENTS;
+        break;
+    case GL_MAX_TEXTURE_SIZE:
+        *params = NULL_GL_MAX_TEXTURE_SIZE;
+        break;
+    case GL_MAX_TEXTURE_IMAGE_UNITS:
+    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+        *params = NULL_GL_MAX_TEXTURE_UNITS;
+        break;
+    case GL_FRAMEBUFFER_BINDING:
+        *params = (GLint)__framebuffer;
+        break;
+    case GL_VIEWPORT:
+        memcpy(params, __viewport, sizeof(__viewport));
+        break;
+    case GL_MAJOR_VERSION:
+        *params = 2;
+        break;
+    case GL_MINOR_VERSION:
+        *params = 1;
+        break;
+    default:
+        *params = 0;
+        break;
+    }
+}
+
+void nullglGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+    record(NullGL::GetProgramInfoLog);
+    if (length)
+        *length = 0;
+    if (infoLog && bufSize > 0)
+        infoLog[0] = '\0';
+}
+
+void nullglGetProgramiv(GLuint program, GLenum pname, GLint* params)
+{
+    record(NullGL::GetProgramiv);
+    NullGLProgram* p = getProgram(program);
+    switch (pname)
+    {
+    case GL_LINK_STATUS:
+        *params = p ? GL_TRUE : GL_FALSE;
+        break;
+    case GL_ACTIVE_ATTRIBUTES:
+        *params = p ? (GLint)p->attributes.size() : 0;
+        break;
+    case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH:
+        *params = p ? getMaxNameLength(p->attributes) : 0;
+        break;
+    case GL_ACTIVE_UNIFORMS:
+        *params = p ? (GLint)p->uniforms.size() : 0;
+        break;
+    case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+        *params = p ? getMaxNameLength(p->uniforms) : 0;
+        break;
+    default:
+        *params = 0;
+        break;
+    }
+}
+
+void nullglGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+    record(NullGL::GetShaderInfoLog);
+    if (length)
+        *length = 0;
+    if (infoLog && bufSize > 0)
+        infoLog[0] = '\0';
+}
+
+void nullglGetShaderiv(GLuint shader, GLenum pname, GLint* params)
+{
+    record(NullGL::GetShaderiv);
+    *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+const GLubyte* nullglGetString(GLenum name)
+{
+    record(NullGL::GetString);
+    switch (name)
+    {
+    case GL_VENDOR:
+        return (const GLubyte*)"gameplay";
+    case GL_RENDERER:
+        return (const GLubyte*)"Null GL";
+    case GL_VERSION:
+        return (const GLubyte*)"2.1";
+    case GL_SHADING_LANGUAGE_VERSION:
+        return (const GLubyte*)"1.20";
+    default:
+        return (const GLubyte*)"";
+    }
+}
+
+GLint nullglGetUniformLocation(GLuint program, const GLchar* name)
+{
+    record(NullGL::GetUniformLocation);
+    NullGLProgram* p = getProgram(program);
+    if (p == NULL)
+        return -1;
+
+    // Array elements are queried as "name[index]".
+    std::string uniformName = name;
+    GLint index = 0;
+    size_t bracket = uniformName.find('[');
+    if (bracket != std::string::npos)
+    {
+        index = atoi(name + bracket + 1);
+        uniformName.erase(bracket);
+    }
+    for (size_t i = 0, count = p->uniforms.size(); i < count; ++i)
+    {
+        const NullGLVariable& uniform = p->uniforms[i];
+        if (uniform.name == uniformName)
+            return index < uniform.size ? uniform.location + index : -1;
+    }
+    return -1;
+}
+
+void nullglHint(GLenum target, GLenum mode)
+{
+    record(NullGL::Hint);
+    changeState(NullGL::Hint, target, mode);
+}
+
+GLboolean nullglIsTexture(GLuint texture)
+{
+    record(NullGL::IsTexture);
+    return __textures.find(texture) != __textures.end() ? GL_TRUE : GL_FALSE;
+}
+
+GLboolean nullglIsVertexArray(GLuint array)
+{
+    record(NullGL::IsVertexArray);
+    return __vertexArrays.find(array) != __vertexArrays.end() ? GL_TRUE : GL_FALSE;
+}
+
+void nullglLinkProgram(GLuint program)
+{
+    record(NullGL::LinkProgram);
+    NullGLProgram* p = getProgram(program);
+    if (p == NULL)
+        return;
+
+    p->attributes.clear();
+    p->uniforms.clear();
+    for (size_t i = 0, count = p->shaders.size(); i < count; ++i)
+    {
+        std::unordered_map<GLuint, NullGLShader>::const_iterator itr = __shaders.find(p->shaders[i]);
+        if (itr == __shaders.end())
+            continue;
+
+        if (itr->second.type == GL_VERTEX_SHADER)
+        {
+            parseDeclarations(itr->second.source, "attribute", p->attributes);
+        }
+        parseDeclarations(itr->second.source, "uniform", p->uniforms);
+    }
+}
+
+void* nullglMapBuffer(GLenum target, GLenum access)
+{
+    record(NullGL::MapBuffer);
+    std::unordered_map<GLuint, GLsizeiptr>::const_iterator itr = __buffers.find(__boundBuffers[target]);
+    size_t size = itr == __buffers.end() ? 0 : (size_t)itr->second;
+    std::vector<unsigned char>& memory = __mappedBuffers[target];
+    memory.assign(size, 0);
+    return memory.empty() ? NULL : &memory[0];
+}
+
+void nullglPixelStorei(GLenum pname, GLint param)
+{
+    record(NullGL::PixelStorei);
+    changeState(NullGL::PixelStorei, pname, (unsigned int)param);
+}
+
+void nullglReadBuffer(GLenum mode)
+{
+    record(NullGL::ReadBuffer);
+}
+
+void nullglReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels)
+{
+    record(NullGL::ReadPixels);
+    if (pixels)
+    {
+        memset(pixels, 0, (size_t)width * (size_t)height * getPixelSize(format, type));
+    }
+}
+
+void nullglRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    record(NullGL::RenderbufferStorage);
+}
+
+void nullglShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+{
+    record(NullGL::ShaderSource);
+    std::string& source = __shaders[shader].source;
+    source.clear();
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (string[i] == NULL)
+            continue;
+        if (length && length[i] >= 0)
+            source.append(string[i], length[i]);
+        else
+            source.append(string[i]);
+    }
+}
+
+void nullglStencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+    record(NullGL::StencilFunc);
+    changeState(NullGL::StencilFunc, 0, ((unsigned long long)func << 48) ^ ((unsigned long long)(unsigned int)ref << 32) ^ mask);
+}
+
+void nullglStencilMask(GLuint mask)
+{
+    record(NullGL::StencilMask);
+    changeState(NullGL::StencilMask, 0, mask);
+}
+
+void nullglStencilOp(GLenum fail, GLenum zfail, GLenum zpass)
+{
+    record(NullGL::StencilOp);
+    changeState(NullGL::StencilOp, 0, ((unsigned long long)fail << 32) ^ ((unsigned long long)zfail << 16) ^ zpass);
+}
+
+void nullglTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
+{
+    record(NullGL::TexImage2D);
+    if (pixels)
+    {
+        __statistics.textureBytes += (unsigned long long)width * (unsigned long long)height * getPixelSize(format, type);
+    }
+}
+
+void nullglTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+    record(NullGL::TexParameteri);
+}
+
+void nullglTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+{
+    record(NullGL::TexSubImage2D);
+    if (pixels)
+    {
+        __statistics.textureBytes += (unsigned long long)width * (unsigned long long)height * getPixelSize(format, type);
+    }
+}
+
+void nullglUniform1f(GLint location, GLfloat v0)
+{
+    record(NullGL::Uniform1f);
+    recordUniform(1, sizeof(GLfloat));
+}
+
+void nullglUniform1fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    record(NullGL::Uniform1fv);
+    recordUniform(count, sizeof(GLfloat));
+}
+
+void nullglUniform1i(GLint location, GLint v0)
+{
+    record(NullGL::Uniform1i);
+    recordUniform(1, sizeof(GLint));
+}
+
+void nullglUniform1iv(GLint location, GLsizei count, const GLint* value)
+{
+    record(NullGL::Uniform1iv);
+    recordUniform(count, sizeof(GLint));
+}
+
+void nullglUniform2f(GLint location, GLfloat v0, GLfloat v1)
+{
+    record(NullGL::Uniform2f);
+    recordUniform(1, 2 * sizeof(GLfloat));
+}
+
+void nullglUniform2fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    record(NullGL::Uniform2fv);
+    recordUniform(count, 2 * sizeof(GLfloat));
+}
+
+void nullglUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+{
+    record(NullGL::Uniform3f);
+    recordUniform(1, 3 * sizeof(GLfloat));
+}
+
+void nullglUniform3fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    record(NullGL::Uniform3fv);
+    recordUniform(count, 3 * sizeof(GLfloat));
+}
+
+void nullglUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+    record(NullGL::Uniform4f);
+    recordUniform(1, 4 * sizeof(GLfloat));
+}
+
+void nullglUniform4fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    record(NullGL::Uniform4fv);
+    recordUniform(count, 4 * sizeof(GLfloat));
+}
+
+void nullglUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    record(NullGL::UniformMatrix4fv);
+    recordUniform(count, 16 * sizeof(GLfloat));
+}
+
+GLboolean nullglUnmapBuffer(GLenum target)
+{
+    record(NullGL::UnmapBuffer);
+    std::vector<unsigned char>& memory = __mappedBuffers[target];
+    __statistics.bufferBytes += memory.size();
+    memory.clear();
+    return GL_TRUE;
+}
+
+void nullglUseProgram(GLuint program)
+{
+    record(NullGL::UseProgram);
+    changeState(NullGL::UseProgram, 0, program);
+}
+
+void nullglVertexAttrib4fv(GLuint index, const GLfloat* v)
+{
+    record(NullGL::VertexAttrib4fv);
+}
+
+void nullglVertexAttribDivisor(GLuint index, GLuint divisor)
+{
+    record(NullGL::VertexAttribDivisor);
+    changeState(NullGL::VertexAttribDivisor, ((unsigned long long)__vertexArray << 16) | index, divisor);
+}
+
+void nullglVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+{
+    record(NullGL::VertexAttribPointer);
+}
+
+void nullglViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    unsigned long long value = ((unsigned long long)(x & 0xFFFF) << 48) | ((unsigned long long)(y & 0xFFFF) << 32) | ((unsigned long long)(width & 0xFFFF) << 16) | (unsigned long long)(height & 0xFFFF);
+    record(NullGL::Viewport);
+    changeState(NullGL::Viewport, 0, value);
+    __viewport[0] = x;
+    __viewport[1] = y;
+    __viewport[2] = width;
+    __viewport[3] = height;
+}
+
+#endif
@@ -0,0 +1,464 @@
+#ifndef NULLGL_H_
+#define NULLGL_H_
+
+// Included by Base.h after the GL headers when the engine is built with GP_NULL_GL.
+
+// GL entry points used by the engine, recorded by the null GL backend.
+#define GP_NULL_GL_ENTRY_POINTS(ENTRY_POINT) \
+    ENTRY_POINT(ActiveTexture) \
+    ENTRY_POINT(AttachShader) \
+    ENTRY_POINT(BindAttribLocation) \
+    ENTRY_POINT(BindBuffer) \
+    ENTRY_POINT(BindFramebuffer) \
+    ENTRY_POINT(BindRenderbuffer) \
+    ENTRY_POINT(BindTexture) \
+    ENTRY_POINT(BindVertexArray) \
+    ENTRY_POINT(BlendFunc) \
+    ENTRY_POINT(BufferData) \
+    ENTRY_POINT(BufferSubData) \
+    ENTRY_POINT(CheckFramebufferStatus) \
+    ENTRY_POINT(Clear) \
+    ENTRY_POINT(ClearColor) \
+    ENTRY_POINT(ClearDepth) \
+    ENTRY_POINT(ClearStencil) \
+    ENTRY_POINT(CompileShader) \
+    ENTRY_POINT(CompressedTexImage2D) \
+    ENTRY_POINT(CreateProgram) \
+    ENTRY_POINT(CreateShader) \
+    ENTRY_POINT(CullFace) \
+    ENTRY_POINT(DeleteBuffers) \
+    ENTRY_POINT(DeleteFramebuffers) \
+    ENTRY_POINT(DeleteProgram) \
+    ENTRY_POINT(DeleteRenderbuffers) \
+    ENTRY_POINT(DeleteShader) \
+    ENTRY_POINT(DeleteTextures) \
+    ENTRY_POINT(DeleteVertexArrays) \
+    ENTRY_POINT(DepthFunc) \
+    ENTRY_POINT(DepthMask) \
+    ENTRY_POINT(Disable) \
+    ENTRY_POINT(DisableVertexAttribArray) \
+    ENTRY_POINT(DrawArrays) \
+    ENTRY_POINT(DrawArraysInstanced) \
+    ENTRY_POINT(DrawBuffer) \
+    ENTRY_POINT(DrawBuffers) \
+    ENTRY_POINT(DrawElements) \
+    ENTRY_POINT(DrawElementsInstanced) \
+    ENTRY_POINT(Enable) \
+    ENTRY_POINT(EnableVertexAttribArray) \
+    ENTRY_POINT(FramebufferRenderbuffer) \
+    ENTRY_POINT(FramebufferTexture2D) \
+    ENTRY_POINT(FrontFace) \
+    ENTRY_POINT(GenBuffers) \
+    ENTRY_POINT(GenFramebuffers) \
+    ENTRY_POINT(GenRenderbuffers) \
+    ENTRY_POINT(GenTextures) \
+    ENTRY_POINT(GenVertexArrays) \
+    ENTRY_POINT(GenerateMipmap) \
+    ENTRY_POINT(GetActiveAttrib) \
+    ENTRY_POINT(GetActiveUniform) \
+    ENTRY_POINT(GetAttribLocation) \
+    ENTRY_POINT(GetError) \
+    ENTRY_POINT(GetIntegerv) \
+    ENTRY_POINT(GetProgramInfoLog) \
+    ENTRY_POINT(GetProgramiv) \
+    ENTRY_POINT(GetShaderInfoLog) \
+    ENTRY_POINT(GetShaderiv) \
+    ENTRY_POINT(GetString) \
+    ENTRY_POINT(GetUniformLocation) \
+    ENTRY_POINT(Hint) \
+    ENTRY_POINT(IsTexture) \
+    ENTRY_POINT(IsVertexArray) \
+    ENTRY_POINT(LinkProgram) \
+    ENTRY_POINT(MapBuffer) \
+    ENTRY_POINT(PixelStorei) \
+    ENTRY_POINT(ReadBuffer) \
+    ENTRY_POINT(ReadPixels) \
+    ENTRY_POINT(RenderbufferStorage) \
+    ENTRY_POINT(ShaderSource) \
+    ENTRY_POINT(StencilFunc) \
+    ENTRY_POINT(StencilMask) \
+    ENTRY_POINT(StencilOp) \
+    ENTRY_POINT(TexImage2D) \
+    ENTRY_POINT(TexParameteri) \
+    ENTRY_POINT(TexSubImage2D) \
+    ENTRY_POINT(Uniform1f) \
+    ENTRY_POINT(Uniform1fv) \
+    ENTRY_POINT(Uniform1i) \
+    ENTRY_POINT(Uniform1iv) \
+    ENTRY_POINT(Uniform2f) \
+    ENTRY_POINT(Uniform2fv) \
+    ENTRY_POINT(Uniform3f) \
+    ENTRY_POINT(Uniform3fv) \
+    ENTRY_POINT(Uniform4f) \
+    ENTRY_POINT(Uniform4fv) \
+    ENTRY_POINT(UniformMatrix4fv) \
+    ENTRY_POINT(UnmapBuffer) \
+    ENTRY_POINT(UseProgram) \
+    ENTRY_POINT(VertexAttrib4fv) \
+    ENTRY_POINT(VertexAttribDivisor) \
+    ENTRY_POINT(VertexAttribPointer) \
+    ENTRY_POINT(Viewport)
+
+namespace gameplay
+{
+
+/**
+ * Defines the null GL backend, which replaces the GL entry points used by the engine
+ * with functions that record the calls instead of rendering.
+ *
+ * The backend is compiled in when the engine is built with GP_NULL_GL (the GP_NULL_GL
+ * CMake option on Linux). The Linux platform then runs the game without a window or a
+ * GL context, so the CPU side of rendering can be measured on machines without a GPU.
+ *
+ * The backend keeps just enough state for the engine to work: object names, buffer
+ * sizes and the attributes and uniforms declared in the shader sources, which are
+ * reported as active whether or not the shader uses them. Mapped buffers and read
+ * pixels are zero-filled scratch memory.
+ *
+ * @script{ignore}
+ */
+class NullGL
+{
+public:
+
+    /**
+     * The recorded GL entry points.
+     */
+    enum EntryPoint
+    {
+#define GP_NULL_GL_ENUM(name) name,
+        GP_NULL_GL_ENTRY_POINTS(GP_NULL_GL_ENUM)
+#undef GP_NULL_GL_ENUM
+        ENTRY_POINT_COUNT
+    };
+
+    /**
+     * Counters of the recorded GL calls.
+     */
+    struct Statistics
+    {
+        /** Number of calls per entry point. */
+        unsigned int calls[ENTRY_POINT_COUNT];
+        /** Number of draw calls, instanced or not. */
+        unsigned int drawCalls;
+        /** Number of vertices or indices submitted by the draw calls, for all instances. */
+        unsigned long long verticesDrawn;
+        /** Number of bytes uploaded to buffers, including mapped buffers. */
+        unsigned long long bufferBytes;
+        /** Number of bytes uploaded to textures. */
+        unsigned long long textureBytes;
+        /** Number of bytes uploaded to uniforms. */
+        unsigned long long uniformBytes;
+        /** Number of calls that set a bind point, a capability or a fixed-function state. */
+        unsigned int stateChanges;
+        /** Number of state changes that set the value the state already had. */
+        unsigned int redundantStateChanges;
+    };
+
+    /**
+     * Gets the counters recorded since the last reset.
+     *
+     * @return The statistics.
+     */
+    static const Statistics& getStatistics();
+
+    /**
+     * Resets the counters. The GL state and objects are kept.
+     */
+    static void resetStatistics();
+
+    /**
+     * Gets the name of a GL entry point.
+     *
+     * @param entryPoint The entry point.
+     *
+     * @return The name of the GL function, such as "glDrawElements".
+     */
+    static const char* getEntryPointName(EntryPoint entryPoint);
+};
+
+}
+
+// Route the GL entry points used by the engine to the null GL backend.
+#undef glActiveTexture
+#define glActiveTexture nullglActiveTexture
+#undef glAttachShader
+#define glAttachShader nullglAttachShader
+#undef glBindAttribLocation
+#define glBindAttribLocation nullglBindAttribLocation
+#undef glBindBuffer
+#define glBindBuffer nullglBindBuffer
+#undef glBindFramebuffer
+#define glBindFramebuffer nullglBindFramebuffer
+#undef glBindRenderbuffer
+#define glBindRenderbuffer nullglBindRenderbuffer
+#undef glBindTexture
+#define glBindTexture nullglBindTexture
+#undef glBindVertexArray
+#define glBindVertexArray nullglBindVertexArray
+#undef glBlendFunc
+#define glBlendFunc nullglBlendFunc
+#undef glBufferData
+#define glBufferData nullglBufferData
+#undef glBufferSubData
+#define glBufferSubData nullglBufferSubData
+#undef glCheckFramebufferStatus
+#define glCheckFramebufferStatus nullglCheckFramebufferStatus
+#undef glClear
+#define glClear nullglClear
+#undef glClearColor
+#define glClearColor nullglClearColor
+#undef glClearDepth
+#define glClearDepth nullglClearDepth
+#undef glClearStencil
+#define glClearStencil nullglClearStencil
+#undef glCompileShader
+#define glCompileShader nullglCompileShader
+#undef glCompressedTexImage2D
+#define glCompressedTexImage2D nullglCompressedTexImage2D
+#undef glCreateProgram
+#define glCreateProgram nullglCreateProgram
+#undef glCreateShader
+#define glCreateShader nullglCreateShader
+#undef glCullFace
+#define glCullFace nullglCullFace
+#undef glDeleteBuffers
+#define glDeleteBuffers nullglDeleteBuffers
+#undef glDeleteFramebuffers
+#define glDeleteFramebuffers nullglDeleteFramebuffers
+#undef glDeleteProgram
+#define glDeleteProgram nullglDeleteProgram
+#undef glDeleteRenderbuffers
+#define glDeleteRenderbuffers nullglDeleteRenderbuffers
+#undef glDeleteShader
+#define glDeleteShader nullglDeleteShader
+#undef glDeleteTextures
+#define glDeleteTextures nullglDeleteTextures
+#undef glDeleteVertexArrays
+#define glDeleteVertexArrays nullglDeleteVertexArrays
+#undef glDepthFunc
+#define glDepthFunc nullglDepthFunc
+#undef glDepthMask
+#define glDepthMask nullglDepthMask
+#undef glDisable
+#define glDisable nullglDisable
+#undef glDisableVertexAttribArray
+#define glDisableVertexAttribArray nullglDisableVertexAttribArray
+#undef glDrawArrays
+#define glDrawArrays nullglDrawArrays
+#undef glDrawArraysInstanced
+#define glDrawArraysInstanced nullglDrawArraysInstanced
+#undef glDrawBuffer
+#define glDrawBuffer nullglDrawBuffer
+#undef glDrawBuffers
+#define glDrawBuffers nullglDrawBuffers
+#undef glDrawElements
+#define glDrawElements nullglDrawElements
+#undef glDrawElementsInstanced
+#define glDrawElementsInstanced nullglDrawElementsInstanced
+#undef glEnable
+#define glEnable nullglEnable
+#undef glEnableVertexAttribArray
+#define glEnableVertexAttribArray nullglEnableVertexAttribArray
+#undef glFramebufferRenderbuffer
+#define glFramebufferRenderbuffer nullglFramebufferRenderbuffer
+#undef glFramebufferTexture2D
+#define glFramebufferTexture2D nullglFramebufferTexture2D
+#undef glFrontFace
+#define glFrontFace nullglFrontFace
+#undef glGenBuffers
+#define glGenBuffers nullglGenBuffers
+#undef glGenFramebuffers
+#define glGenFramebuffers nullglGenFramebuffers
+#undef glGenRenderbuffers
+#define glGenRenderbuffers nullglGenRenderbuffers
+#undef glGenTextures
+#define glGenTextures nullglGenTextures
+#undef glGenVertexArrays
+#define glGenVertexArrays nullglGenVertexArrays
+#undef glGenerateMipmap
+#define glGenerateMipmap nullglGenerateMipmap
+#undef glGetActiveAttrib
+#define glGetActiveAttrib nullglGetActiveAttrib
+#undef glGetActiveUniform
+#define glGetActiveUniform nullglGetActiveUniform
+#undef glGetAttribLocation
+#define glGetAttribLocation nullglGetAttribLocation
+#undef glGetError
+#define glGetError nullglGetError
+#undef glGetIntegerv
+#define glGetIntegerv nullglGetIntegerv
+#undef glGetProgramInfoLog
+#define glGetProgramInfoLog nullglGetProgramInfoLog
+#undef glGetProgramiv
+#define glGetProgramiv nullglGetProgramiv
+#undef glGetShaderInfoLog
+#define glGetShaderInfoLog nullglGetShaderInfoLog
+#undef glGetShaderiv
+#define glGetShaderiv nullglGetShaderiv
+#undef glGetString
+#define glGetString nullglGetString
+#undef glGetUniformLocation
+#define glGetUniformLocation nullglGetUniformLocation
+#undef glHint
+#define glHint nullglHint
+#undef glIsTexture
+#define glIsTexture nullglIsTexture
+#undef glIsVertexArray
+#define glIsVertexArray nullglIsVertexArray
+#undef glLinkProgram
+#define glLinkProgram nullglLinkProgram
+#undef glMapBuffer
+#define glMapBuffer nullglMapBuffer
+#undef glPixelStorei
+#define glPixelStorei nullglPixelStorei
+#undef glReadBuffer
+#define glReadBuffer nullglReadBuffer
+#undef glReadPixels
+#define glReadPixels nullglReadPixels
+#undef glRenderbufferStorage
+#define glRenderbufferStorage nullglRenderbufferStorage
+#undef glShaderSource
+#define glShaderSource nullglShaderSource
+#undef glStencilFunc
+#define glStencilFunc nullglStencilFunc
+#undef glStencilMask
+#define glStencilMask nullglStencilMask
+#undef glStencilOp
+#define glStencilOp nullglStencilOp
+#undef glTexImage2D
+#define glTexImage2D nullglTexImage2D
+#undef glTexParameteri
+#define glTexParameteri nullglTexParameteri
+#undef glTexSubImage2D
+#define glTexSubImage2D nullglTexSubImage2D
+#undef glUniform1f
+#define glUniform1f nullglUniform1f
+#undef glUniform1fv
+#define glUniform1fv nullglUniform1fv
+#undef glUniform1i
+#define glUniform1i nullglUniform1i
+#undef glUniform1iv
+#define glUniform1iv nullglUniform1iv
+#undef glUniform2f
+#define glUniform2f nullglUniform2f
+#undef glUniform2fv
+#define glUniform2fv nullglUniform2fv
+#undef glUniform3f
+#define glUniform3f nullglUniform3f
+#undef glUniform3fv
+#define glUniform3fv nullglUniform3fv
+#undef glUniform4f
+#define glUniform4f nullglUniform4f
+#undef glUniform4fv
+#define glUniform4fv nullglUniform4fv
+#undef glUniformMatrix4fv
+#define glUniformMatrix4fv nullglUniformMatrix4fv
+#undef glUnmapBuffer
+#define glUnmapBuffer nullglUnmapBuffer
+#undef glUseProgram
+#define glUseProgram nullglUseProgram
+#undef glVertexAttrib4fv
+#define glVertexAttrib4fv nullglVertexAttrib4fv
+#undef glVertexAttribDivisor
+#define glVertexAttribDivisor nullglVertexAttribDivisor
+#undef glVertexAttribPointer
+#define glVertexAttribPointer nullglVertexAttribPointer
+#undef glViewport
+#define glViewport nullglViewport
+
+void nullglActiveTexture(GLenum texture);
+void nullglAttachShader(GLuint program, GLuint shader);
+void nullglBindAttribLocation(GLuint program, GLuint index, const GLchar* name);
+void nullglBindBuffer(GLenum target, GLuint buffer);
+void nullglBindFramebuffer(GLenum target, GLuint framebuffer);
+void nullglBindRenderbuffer(GLenum target, GLuint renderbuffer);
+void nullglBindTexture(GLenum target, GLuint texture);
+void nullglBindVertexArray(GLuint array);
+void nullglBlendFunc(GLenum sfactor, GLenum dfactor);
+void nullglBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+void nullglBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+GLenum nullglCheckFramebufferStatus(GLenum target);
+void nullglClear(GLbitfield mask);
+void nullglClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+void nullglClearDepth(GLclampd depth);
+void nullglClearStencil(GLint s);
+void nullglCompileShader(GLuint shader);
+void nullglCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data);
+GLuint nullglCreateProgram();
+GLuint nullglCreateShader(GLenum type);
+void nullglCullFace(GLenum mode);
+void nullglDeleteBuffers(GLsizei n, const GLuint* buffers);
+void nullglDeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+void nullglDeleteProgram(GLuint program);
+void nullglDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
+void nullglDeleteShader(GLuint shader);
+void nullglDeleteTextures(GLsizei n, const GLuint* textures);
+void nullglDeleteVertexArrays(GLsizei n, const GLuint* arrays);
+void nullglDepthFunc(GLenum func);
+void nullglDepthMask(GLboolean flag);
+void nullglDisable(GLenum cap);
+void nullglDisableVertexAttribArray(GLuint index);
+void nullglDrawArrays(GLenum mode, GLint first, GLsizei count);
+void nullglDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei primcount);
+void nullglDrawBuffer(GLenum mode);
+void nullglDrawBuffers(GLsizei n, const GLenum* bufs);
+void nullglDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+void nullglDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount);
+void nullglEnable(GLenum cap);
+void nullglEnableVertexAttribArray(GLuint index);
+void nullglFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+void nullglFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+void nullglFrontFace(GLenum mode);
+void nullglGenBuffers(GLsizei n, GLuint* buffers);
+void nullglGenFramebuffers(GLsizei n, GLuint* framebuffers);
+void nullglGenRenderbuffers(GLsizei n, GLuint* renderbuffers);
+void nullglGenTextures(GLsizei n, GLuint* textures);
+void nullglGenVertexArrays(GLsizei n, GLuint* arrays);
+void nullglGenerateMipmap(GLenum target);
+void nullglGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+void nullglGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+GLint nullglGetAttribLocation(GLuint program, const GLchar* name);
+GLenum nullglGetError();
+void nullglGetIntegerv(GLenum pname, GLint* params);
+void nullglGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+void nullglGetProgramiv(GLuint program, GLenum pname, GLint* params);
+void nullglGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+void nullglGetShaderiv(GLuint shader, GLenum pname, GLint* params);
+const GLubyte* nullglGetString(GLenum name);
+GLint nullglGetUniformLocation(GLuint program, const GLchar* name);
+void nullglHint(GLenum target, GLenum mode);
+GLboolean nullglIsTexture(GLuint texture);
+GLboolean nullglIsVertexArray(GLuint array);
+void nullglLinkProgram(GLuint program);
+void* nullglMapBuffer(GLenum target, GLenum access);
+void nullglPixelStorei(GLenum pname, GLint param);
+void nullglReadBuffer(GLenum mode);
+void nullglReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels);
+void nullglRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+void nullglShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+void nullglStencilFunc(GLenum func, GLint ref, GLuint mask);
+void nullglStencilMask(GLuint mask);
+void nullglStencilOp(GLenum fail, GLenum zfail, GLenum zpass);
+void nullglTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels);
+void nullglTexParameteri(GLenum target, GLenum pname, GLint param);
+void nullglTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels);
+void nullglUniform1f(GLint location, GLfloat v0);
+void nullglUniform1fv(GLint location, GLsizei count, const GLfloat* value);
+void nullglUniform1i(GLint location, GLint v0);
+void nullglUniform1iv(GLint location, GLsizei count, const GLint* value);
+void nullglUniform2f(GLint location, GLfloat v0, GLfloat v1);
+void nullglUniform2fv(GLint location, GLsizei count, const GLfloat* value);
+void nullglUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+void nullglUniform3fv(GLint location, GLsizei count, const GLfloat* value);
+void nullglUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+void nullglUniform4fv(GLint location, GLsizei count, const GLfloat* value);
+void nullglUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+GLboolean nullglUnmapBuffer(GLenum target);
+void nullglUseProgram(GLuint program);
+void nullglVertexAttrib4fv(GLuint index, const GLfloat* v);
+void nullglVertexAttribDivisor(GLuint index, GLuint divisor);
+void nullglVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+void nullglViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+#endif
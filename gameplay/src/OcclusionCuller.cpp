@@ -0,0 +1,593 @@
+#include "Base.h"
+#include "OcclusionCuller.h"
+#include "Bundle.h"
+#include "Camera.h"
+#include "Game.h"
+#include "Node.h"
+#include "Scene.h"
+
+// Number of rows of the depth buffer rasterized by a single job.
+#define OCCLUSION_ROWS_PER_BAND 8
+
+// Number of occluders transformed and set up by a single job.
+#define OCCLUSION_OCCLUDERS_PER_JOB 16
+
+namespace gameplay
+{
+
+#if defined(GP_SIMD_NEON)
+static inline bool anyLane(uint32x4_t mask)
+{
+    uint32x2_t lanes = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+    lanes = vpmax_u32(lanes, lanes);
+    return vget_lane_u32(lanes, 0) != 0;
+}
+#endif
+
+static unsigned int getIndex(Mesh::IndexFormat indexFormat, const unsigned char* indexData, unsigned int i)
+{
+    if (indexData == NULL)
+        return i;
+
+    switch (indexFormat)
+    {
+    case Mesh::INDEX8:
+        return indexData[i];
+    case Mesh::INDEX16:
+        return ((const unsigned short*)indexData)[i];
+    default:
+        return ((const unsigned int*)indexData)[i];
+    }
+}
+
+// Appends the triangles of a triangle list or strip as a triangle list, with the winding of the list.
+static void appendTriangles(Mesh::PrimitiveType primitiveType, Mesh::IndexFormat indexFormat, const unsigned char* indexData,
+                            unsigned int indexCount, unsigned int vertexCount, std::vector<unsigned int>& indices)
+{
+    if (primitiveType != Mesh::TRIANGLES && primitiveType != Mesh::TRIANGLE_STRIP)
+        return;
+
+    const bool strip = primitiveType == Mesh::TRIANGLE_STRIP;
+    for (unsigned int i = strip ? 2 : 0; i + (strip ? 0 : 2) < indexCount; i += strip ? 1 : 3)
+    {
+        unsigned int i0 = strip ? i - 2 : i;
+        unsigned int i1 = strip ? i - 1 : i + 1;
+        if (strip && (i & 1))
+            std::swap(i0, i1);
+        const unsigned int a = getIndex(indexFormat, indexData, i0);
+        const unsigned int b = getIndex(indexFormat, indexData, i1);
+        const unsigned int c = getIndex(indexFormat, indexData, strip ? i : i + 2);
+        if (a == b || b == c || c == a || a >= vertexCount || b >= vertexCount || c >= vertexCount)
+            continue;
+        indices.push_back(a);
+        indices.push_back(b);
+        indices.push_back(c);
+    }
+}
+
+OcclusionCuller::OcclusionCuller(unsigned int width, unsigned int height)
+    : _width(width), _height(height), _rendered(false)
+{
+    _depthBuffer.resize(_width * _height, 1.0f);
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    removeAllOccluders();
+}
+
+OcclusionCuller* OcclusionCuller::create(unsigned int width, unsigned int height)
+{
+    GP_ASSERT(width > 0 && height > 0);
+
+    // Rows are rasterized four pixels at a time.
+    return new OcclusionCuller((width + 3) & ~3, height);
+}
+
+bool OcclusionCuller::addOccluder(Node* node, const char* meshUrl)
+{
+    GP_ASSERT(node);
+
+    const char* url = meshUrl;
+    if (url == NULL || strlen(url) == 0)
+    {
+        Model* model = dynamic_cast<Model*>(node->getDrawable());
+        url = model && model->getMesh() ? model->getMesh()->getUrl() : NULL;
+    }
+    if (url == NULL || strlen(url) == 0)
+    {
+        GP_WARN("Node '%s' has no occluder mesh loaded from a bundle.", node->getId());
+        return false;
+    }
+
+    OccluderMesh* mesh = loadMesh(url);
+    if (mesh == NULL)
+        return false;
+
+    Occluder occluder;
+    occluder.node = node;
+    occluder.mesh = mesh;
+    occluder.enabled = false;
+    occluder.firstTriangle = 0;
+    _occluders.push_back(occluder);
+    node->addRef();
+    return true;
+}
+
+unsigned int OcclusionCuller::addOccluders(Scene* scene)
+{
+    GP_ASSERT(scene);
+
+    unsigned int count = 0;
+    std::vector<Node*> nodes;
+    for (Node* node = scene->getFirstNode(); node != NULL; node = node->getNextSibling())
+    {
+        nodes.push_back(node);
+    }
+    while (!nodes.empty())
+    {
+        Node* node = nodes.back();
+        nodes.pop_back();
+        if (node->hasTag("occluder") && addOccluder(node, node->getTag("occluder")))
+            ++count;
+        for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+        {
+            nodes.push_back(child);
+        }
+    }
+    return count;
+}
+
+void OcclusionCuller::removeOccluder(Node* node)
+{
+    for (size_t i = 0; i < _occluders.size();)
+    {
+        if (_occluders[i].node == node)
+        {
+            releaseMesh(_occluders[i].mesh);
+            SAFE_RELEASE(_occluders[i].node);
+            _occluders.erase(_occluders.begin() + i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void OcclusionCuller::removeAllOccluders()
+{
+    for (size_t i = 0, count = _occluders.size(); i < count; ++i)
+    {
+        releaseMesh(_occluders[i].mesh);
+        SAFE_RELEASE(_occluders[i].node);
+    }
+    _occluders.clear();
+}
+
+unsigned int OcclusionCuller::getOccluderCount() const
+{
+    return (unsigned int)_occluders.size();
+}
+
+OcclusionCuller::OccluderMesh* OcclusionCuller::loadMesh(const char* url)
+{
+    std::map<std::string, OccluderMesh*>::iterator itr = _meshes.find(url);
+    if (itr != _meshes.end())
+    {
+        ++itr->second->refCount;
+        return itr->second;
+    }
+
+    // The vertex buffers of meshes are write only, read the triangles back from the bundle.
+    Bundle::MeshData* meshData = Bundle::readMeshData(url);
+    if (meshData == NULL)
+    {
+        GP_WARN("Failed to load occluder mesh '%s'.", url);
+        return NULL;
+    }
+
+    const VertexFormat& vertexFormat = meshData->vertexFormat;
+    int positionOffset = -1;
+    unsigned int offset = 0;
+    for (unsigned int i = 0, count = vertexFormat.getElementCount(); i < count; ++i)
+    {
+        const VertexFormat::Element& element = vertexFormat.getElement(i);
+        if (element.usage == VertexFormat::POSITION && element.size >= 3)
+            positionOffset = offset;
+        offset += element.size;
+    }
+    if (positionOffset < 0)
+    {
+        GP_WARN("Occluder mesh '%s' has no 3D positions.", url);
+        SAFE_DELETE(meshData);
+        return NULL;
+    }
+
+    OccluderMesh* mesh = new OccluderMesh();
+    mesh->url = url;
+    mesh->refCount = 1;
+    mesh->positions.resize(meshData->vertexCount);
+    const unsigned int stride = vertexFormat.getVertexSize() / sizeof(float);
+    const float* vertex = (const float*)meshData->vertexData + positionOffset;
+    for (unsigned int i = 0; i < meshData->vertexCount; ++i, vertex += stride)
+    {
+        mesh->positions[i].set(vertex[0], vertex[1], vertex[2]);
+    }
+    if (meshData->parts.empty())
+    {
+        appendTriangles(meshData->primitiveType, Mesh::INDEX32, NULL, meshData->vertexCount, meshData->vertexCount, mesh->indices);
+    }
+    for (size_t i = 0, count = meshData->parts.size(); i < count; ++i)
+    {
+        const Bundle::MeshPartData* part = meshData->parts[i];
+        appendTriangles(part->primitiveType, part->indexFormat, part->indexData, part->indexCount, meshData->vertexCount, mesh->indices);
+    }
+    SAFE_DELETE(meshData);
+
+    _meshes[mesh->url] = mesh;
+    return mesh;
+}
+
+void OcclusionCuller::releaseMesh(OccluderMesh* mesh)
+{
+    GP_ASSERT(mesh && mesh->refCount > 0);
+
+    if (--mesh->refCount == 0)
+    {
+        _meshes.erase(mesh->url);
+        SAFE_DELETE(mesh);
+    }
+}
+
+void OcclusionCuller::render(Camera* camera)
+{
+    GP_ASSERT(camera);
+
+    _viewProjection = camera->getViewProjectionMatrix();
+
+    // Resolve the transforms on this thread, the world matrices of nodes are computed lazily.
+    unsigned int triangleCount = 0;
+    for (size_t i = 0, count = _occluders.size(); i < count; ++i)
+    {
+        Occluder& occluder = _occluders[i];
+        occluder.enabled = occluder.node->isEnabledInHierarchy();
+        if (occluder.enabled)
+            Matrix::multiply(_viewProjection, occluder.node->getWorldMatrix(), &occluder.worldViewProjection);
+        occluder.firstTriangle = triangleCount;
+        triangleCount += 2 * ((unsigned int)occluder.mesh->indices.size() / 3);
+    }
+    _triangles.resize(triangleCount);
+    std::fill(_depthBuffer.begin(), _depthBuffer.end(), 1.0f);
+
+    const unsigned int occluderCount = (unsigned int)_occluders.size();
+    const unsigned int bandCount = (_height + OCCLUSION_ROWS_PER_BAND - 1) / OCCLUSION_ROWS_PER_BAND;
+    JobScheduler* scheduler = Game::getInstance()->getJobScheduler();
+    if (scheduler)
+    {
+        scheduler->parallelFor(occluderCount, [this](unsigned int begin, unsigned int end)
+        {
+            setupTriangles(begin, end);
+        }, OCCLUSION_OCCLUDERS_PER_JOB);
+
+        // Each job owns its rows of the depth buffer, so the bands need no synchronization.
+        scheduler->parallelFor(bandCount, [this](unsigned int begin, unsigned int end)
+        {
+            rasterize(begin, end);
+        });
+    }
+    else
+    {
+        setupTriangles(0, occluderCount);
+        rasterize(0, bandCount);
+    }
+
+    _statistics.trianglesRasterized = 0;
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+        if (_triangles[i].minY < _triangles[i].maxY)
+            ++_statistics.trianglesRasterized;
+    }
+    _statistics.boxesTested = 0;
+    _statistics.boxesOccluded = 0;
+    _rendered = true;
+}
+
+void OcclusionCuller::setupTriangles(unsigned int begin, unsigned int end)
+{
+    for (unsigned int i = begin; i < end; ++i)
+    {
+        const Occluder& occluder = _occluders[i];
+        const std::vector<Vector3>& positions = occluder.mesh->positions;
+        const std::vector<unsigned int>& indices = occluder.mesh->indices;
+        Triangle* slots = indices.empty() ? NULL : &_triangles[occluder.firstTriangle];
+        for (size_t j = 0, count = indices.size(); j < count; j += 3, slots += 2)
+        {
+            if (!occluder.enabled)
+            {
+                slots[0].minY = slots[0].maxY = 0;
+                slots[1].minY = slots[1].maxY = 0;
+                continue;
+            }
+
+            Vector4 v[3];
+            for (unsigned int k = 0; k < 3; ++k)
+            {
+                const Vector3& position = positions[indices[j + k]];
+                occluder.worldViewProjection.transformVector(Vector4(position.x, position.y, position.z, 1.0f), &v[k]);
+            }
+            setupTriangle(v[0], v[1], v[2], slots);
+        }
+    }
+}
+
+void OcclusionCuller::setupTriangle(const Vector4& v0, const Vector4& v1, const Vector4& v2, Triangle* slots) const
+{
+    slots[0].minY = slots[0].maxY = 0;
+    slots[1].minY = slots[1].maxY = 0;
+
+    // Skip the triangles outside one of the side planes of the frustum.
+    if ((v0.x > v0.w && v1.x > v1.w && v2.x > v2.w) || (v0.x < -v0.w && v1.x < -v1.w && v2.x < -v2.w) ||
+        (v0.y > v0.w && v1.y > v1.w && v2.y > v2.w) || (v0.y < -v0.w && v1.y < -v1.w && v2.y < -v2.w))
+        return;
+
+    // Clip against the near plane, which gives a triangle or a quad.
+    const Vector4* vertices[3] = { &v0, &v1, &v2 };
+    Vector4 polygon[4];
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const Vector4& a = *vertices[i];
+        const Vector4& b = *vertices[(i + 1) % 3];
+        const float da = a.z + a.w;
+        const float db = b.z + b.w;
+        if (da >= 0.0f)
+            polygon[count++] = a;
+        if ((da >= 0.0f) != (db >= 0.0f))
+            polygon[count++] = a + (b - a) * (da / (da - db));
+    }
+    if (count < 3)
+        return;
+
+    Vector3 ndc[4];
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (polygon[i].w <= MATH_EPSILON)
+            return;
+        const float invW = 1.0f / polygon[i].w;
+        ndc[i].set(polygon[i].x * invW, polygon[i].y * invW, polygon[i].z * invW);
+    }
+    setupTriangle(ndc[0], ndc[1], ndc[2], &slots[0]);
+    if (count == 4)
+        setupTriangle(ndc[0], ndc[2], ndc[3], &slots[1]);
+}
+
+void OcclusionCuller::setupTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, Triangle* slot) const
+{
+    // Set up in double precision, the vertices of clipped triangles can be far outside the depth buffer.
+    const double x[3] = { (v0.x * 0.5 + 0.5) * _width, (v1.x * 0.5 + 0.5) * _width, (v2.x * 0.5 + 0.5) * _width };
+    const double y[3] = { (v0.y * 0.5 + 0.5) * _height, (v1.y * 0.5 + 0.5) * _height, (v2.y * 0.5 + 0.5) * _height };
+    const double z[3] = { v0.z, v1.z, v2.z };
+
+    // Counter clockwise triangles face the camera, the others are back facing or degenerate.
+    const double area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (area <= 0.0)
+        return;
+
+    const double minX = std::max(floor(std::min(x[0], std::min(x[1], x[2]))), 0.0);
+    const double maxX = std::min(ceil(std::max(x[0], std::max(x[1], x[2]))), (double)_width);
+    const double minY = std::max(floor(std::min(y[0], std::min(y[1], y[2]))), 0.0);
+    const double maxY = std::min(ceil(std::max(y[0], std::max(y[1], y[2]))), (double)_height);
+    if (minX >= maxX || minY >= maxY)
+        return;
+
+    slot->minX = (int)minX & ~3;
+    slot->maxX = (int)maxX;
+    slot->minY = (int)minY;
+    slot->maxY = (int)maxY;
+
+    // Pixels are sampled at their center.
+    const double originX = slot->minX + 0.5;
+    const double originY = slot->minY + 0.5;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const unsigned int j = (i + 1) % 3;
+        const double a = y[i] - y[j];
+        const double b = x[j] - x[i];
+        slot->edge[i] = (float)(a * (originX - x[i]) + b * (originY - y[i]));
+        slot->edgeDx[i] = (float)a;
+        slot->edgeDy[i] = (float)b;
+    }
+    const double depthDx = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+    const double depthDy = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+    slot->depth = (float)(z[0] + depthDx * (originX - x[0]) + depthDy * (originY - y[0]));
+    slot->depthDx = (float)depthDx;
+    slot->depthDy = (float)depthDy;
+}
+
+void OcclusionCuller::rasterize(unsigned int beginBand, unsigned int endBand)
+{
+    const int rowBegin = beginBand * OCCLUSION_ROWS_PER_BAND;
+    const int rowEnd = std::min(endBand * OCCLUSION_ROWS_PER_BAND, _height);
+    for (size_t i = 0, count = _triangles.size(); i < count; ++i)
+    {
+        const Triangle& t = _triangles[i];
+        const int y0 = std::max(t.minY, rowBegin);
+        const int y1 = std::min(t.maxY, rowEnd);
+        for (int y = y0; y < y1; ++y)
+        {
+            const float dy = (float)(y - t.minY);
+            const float e0 = t.edge[0] + t.edgeDy[0] * dy;
+            const float e1 = t.edge[1] + t.edgeDy[1] * dy;
+            const float e2 = t.edge[2] + t.edgeDy[2] * dy;
+            const float z = t.depth + t.depthDy * dy;
+            float* row = &_depthBuffer[y * _width];
+
+#if defined(GP_SIMD_SSE)
+            const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+            const __m128 zero = _mm_setzero_ps();
+            __m128 edge0 = _mm_add_ps(_mm_set1_ps(e0), _mm_mul_ps(lane, _mm_set1_ps(t.edgeDx[0])));
+            __m128 edge1 = _mm_add_ps(_mm_set1_ps(e1), _mm_mul_ps(lane, _mm_set1_ps(t.edgeDx[1])));
+            __m128 edge2 = _mm_add_ps(_mm_set1_ps(e2), _mm_mul_ps(lane, _mm_set1_ps(t.edgeDx[2])));
+            __m128 depth = _mm_add_ps(_mm_set1_ps(z), _mm_mul_ps(lane, _mm_set1_ps(t.depthDx)));
+            const __m128 step0 = _mm_set1_ps(4.0f * t.edgeDx[0]);
+            const __m128 step1 = _mm_set1_ps(4.0f * t.edgeDx[1]);
+            const __m128 step2 = _mm_set1_ps(4.0f * t.edgeDx[2]);
+            const __m128 depthStep = _mm_set1_ps(4.0f * t.depthDx);
+            for (int x = t.minX; x < t.maxX; x += 4)
+            {
+                const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)), _mm_cmpge_ps(edge2, zero));
+                if (_mm_movemask_ps(inside))
+                {
+                    const __m128 d = _mm_loadu_ps(row + x);
+                    _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, _mm_min_ps(d, depth)), _mm_andnot_ps(inside, d)));
+                }
+                edge0 = _mm_add_ps(edge0, step0);
+                edge1 = _mm_add_ps(edge1, step1);
+                edge2 = _mm_add_ps(edge2, step2);
+                depth = _mm_add_ps(depth, depthStep);
+            }
+#elif defined(GP_SIMD_NEON)
+            static const float lanes[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+            const float32x4_t lane = vld1q_f32(lanes);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            float32x4_t edge0 = vmlaq_f32(vdupq_n_f32(e0), lane, vdupq_n_f32(t.edgeDx[0]));
+            float32x4_t edge1 = vmlaq_f32(vdupq_n_f32(e1), lane, vdupq_n_f32(t.edgeDx[1]));
+            float32x4_t edge2 = vmlaq_f32(vdupq_n_f32(e2), lane, vdupq_n_f32(t.edgeDx[2]));
+            float32x4_t depth = vmlaq_f32(vdupq_n_f32(z), lane, vdupq_n_f32(t.depthDx));
+            const float32x4_t step0 = vdupq_n_f32(4.0f * t.edgeDx[0]);
+            const float32x4_t step1 = vdupq_n_f32(4.0f * t.edgeDx[1]);
+            const float32x4_t step2 = vdupq_n_f32(4.0f * t.edgeDx[2]);
+            const float32x4_t depthStep = vdupq_n_f32(4.0f * t.depthDx);
+            for (int x = t.minX; x < t.maxX; x += 4)
+            {
+                const uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(edge0, zero), vcgeq_f32(edge1, zero)), vcgeq_f32(edge2, zero));
+                if (anyLane(inside))
+                {
+                    const float32x4_t d = vld1q_f32(row + x);
+                    vst1q_f32(row + x, vbslq_f32(inside, vminq_f32(d, depth), d));
+                }
+                edge0 = vaddq_f32(edge0, step0);
+                edge1 = vaddq_f32(edge1, step1);
+                edge2 = vaddq_f32(edge2, step2);
+                depth = vaddq_f32(depth, depthStep);
+            }
+#else
+            for (int x = t.minX; x < t.maxX; ++x)
+            {
+                const float dx = (float)(x - t.minX);
+                if (e0 + t.edgeDx[0] * dx >= 0.0f && e1 + t.edgeDx[1] * dx >= 0.0f && e2 + t.edgeDx[2] * dx >= 0.0f)
+                    row[x] = std::min(row[x], z + t.depthDx * dx);
+            }
+#endif
+        }
+    }
+}
+
+bool OcclusionCuller::isVisible(const BoundingBox& box) const
+{
+    if (!_rendered || _occluders.empty())
+        return true;
+
+    ++_statistics.boxesTested;
+
+    // Find the screen rectangle and the nearest depth of the box.
+    Vector3 corners[8];
+    box.getCorners(corners);
+    float minX = FLT_MAX, minY = FLT_MAX, minZ = FLT_MAX;
+    float maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (unsigned int i = 0; i < 8; ++i)
+    {
+        Vector4 v;
+        _viewProjection.transformVector(Vector4(corners[i].x, corners[i].y, corners[i].z, 1.0f), &v);
+        if (v.z + v.w < 0.0f || v.w <= MATH_EPSILON)
+        {
+            // The box crosses the near plane.
+            return true;
+        }
+        const float invW = 1.0f / v.w;
+        minX = std::min(minX, v.x * invW);
+        maxX = std::max(maxX, v.x * invW);
+        minY = std::min(minY, v.y * invW);
+        maxY = std::max(maxY, v.y * invW);
+        minZ = std::min(minZ, v.z * invW);
+    }
+
+    // Grow the rectangle by a pixel, since occluders only cover the pixels whose center they cover.
+    const int x0 = std::max((int)floorf((minX * 0.5f + 0.5f) * _width) - 1, 0);
+    const int x1 = std::min((int)floorf((maxX * 0.5f + 0.5f) * _width) + 1, (int)_width - 1);
+    const int y0 = std::max((int)floorf((minY * 0.5f + 0.5f) * _height) - 1, 0);
+    const int y1 = std::min((int)floorf((maxY * 0.5f + 0.5f) * _height) + 1, (int)_height - 1);
+    if (x0 > x1 || y0 > y1)
+        return true;
+
+    // The box is hidden if every pixel of the rectangle is covered by an occluder in front of it.
+    for (int y = y0; y <= y1; ++y)
+    {
+        const float* row = &_depthBuffer[y * _width];
+        int x = x0;
+#if defined(GP_SIMD_SSE)
+        const __m128 depth = _mm_set1_ps(minZ);
+        for (; x + 3 <= x1; x += 4)
+        {
+            if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), depth)))
+                return true;
+        }
+#elif defined(GP_SIMD_NEON)
+        const float32x4_t depth = vdupq_n_f32(minZ);
+        for (; x + 3 <= x1; x += 4)
+        {
+            if (anyLane(vcgeq_f32(vld1q_f32(row + x), depth)))
+                return true;
+        }
+#endif
+        for (; x <= x1; ++x)
+        {
+            if (row[x] >= minZ)
+                return true;
+        }
+    }
+
+    ++_statistics.boxesOccluded;
+    return false;
+}
+
+bool OcclusionCuller::isVisible(Node* node) const
+{
+    GP_ASSERT(node);
+
+    Model* model = dynamic_cast<Model*>(node->getDrawable());
+    if (model && model->getMesh() && model->getSkin() == NULL)
+    {
+        BoundingBox box(model->getMesh()->getBoundingBox());
+        box.transform(node->getWorldMatrix());
+        return isVisible(box);
+    }
+
+    const BoundingSphere& sphere = node->getBoundingSphere();
+    const Vector3 radius(sphere.radius, sphere.radius, sphere.radius);
+    return isVisible(BoundingBox(sphere.center - radius, sphere.center + radius));
+}
+
+unsigned int OcclusionCuller::getWidth() const
+{
+    return _width;
+}
+
+unsigned int OcclusionCuller::getHeight() const
+{
+    return _height;
+}
+
+const float* OcclusionCuller::getDepthBuffer() const
+{
+    return &_depthBuffer[0];
+}
+
+const OcclusionCuller::Statistics& OcclusionCuller::getStatistics() const
+{
+    return _statistics;
+}
+
+}
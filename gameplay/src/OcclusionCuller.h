@@ -0,0 +1,268 @@
+#ifndef OCCLUSIONCULLER_H_
+#define OCCLUSIONCULLER_H_
+
+#include "BoundingBox.h"
+#include "Matrix.h"
+
+namespace gameplay
+{
+
+class Camera;
+class Node;
+class Scene;
+
+/**
+ * Defines a software occlusion culler, which rasterizes occluder meshes into a low resolution
+ * depth buffer on the CPU and tests bounding boxes against it.
+ *
+ * Occluders are nodes whose mesh, or a simpler mesh standing for it, is solid and hides what
+ * is behind it, such as buildings, walls and terrain. The triangles of the occluders are read
+ * back from the bundles they were loaded from, so occluder meshes must come from bundles.
+ * Occluder meshes are expected to be closed, back facing triangles are not rasterized.
+ *
+ * Each frame, render() transforms the occluders with the view projection of the camera and
+ * rasterizes them into the depth buffer, using SIMD and splitting the buffer into bands of
+ * rows rasterized in parallel by the job scheduler of the game. isVisible() then tests the
+ * screen rectangle and nearest depth of a bounding box against the depth buffer.
+ *
+ * The test is conservative: a box is reported hidden only when the occluders cover its whole
+ * screen rectangle, grown by a pixel of the depth buffer, in front of it. Boxes that cross
+ * the near plane of the camera are always visible.
+ *
+ * @script{ignore}
+ */
+class OcclusionCuller
+{
+public:
+
+    /**
+     * Counters of the last rendered frame and the tests made since.
+     */
+    struct Statistics
+    {
+        /** Number of occluder triangles rasterized, after clipping and back face culling. */
+        unsigned int trianglesRasterized;
+        /** Number of boxes tested. */
+        unsigned int boxesTested;
+        /** Number of boxes found hidden. */
+        unsigned int boxesOccluded;
+    };
+
+    /**
+     * Creates an occlusion culler.
+     *
+     * @param width The width of the depth buffer, rounded up to a multiple of 4.
+     * @param height The height of the depth buffer.
+     *
+     * @return The new occlusion culler.
+     */
+    static OcclusionCuller* create(unsigned int width = 256, unsigned int height = 128);
+
+    /**
+     * Destructor.
+     */
+    ~OcclusionCuller();
+
+    /**
+     * Adds an occluder.
+     *
+     * @param node The node of the occluder.
+     * @param meshUrl The URL of the occluder mesh in a bundle, such as "res/city.gpb#block",
+     *      in the space of the node. If NULL, the mesh of the model of the node is used.
+     *
+     * @return true if the occluder was added, false if its triangles could not be loaded.
+     */
+    bool addOccluder(Node* node, const char* meshUrl = NULL);
+
+    /**
+     * Adds the nodes of a scene that have the "occluder" tag as occluders.
+     *
+     * The value of the tag is the URL of the occluder mesh of the node, or empty to use the mesh
+     * of the model of the node.
+     *
+     * @param scene The scene.
+     *
+     * @return The number of occluders added.
+     */
+    unsigned int addOccluders(Scene* scene);
+
+    /**
+     * Removes the occluders of a node.
+     *
+     * @param node The node.
+     */
+    void removeOccluder(Node* node);
+
+    /**
+     * Removes all the occluders.
+     */
+    void removeAllOccluders();
+
+    /**
+     * Gets the number of occluders.
+     *
+     * @return The number of occluders.
+     */
+    unsigned int getOccluderCount() const;
+
+    /**
+     * Rasterizes the enabled occluders as seen by a camera into the depth buffer.
+     *
+     * @param camera The camera.
+     */
+    void render(Camera* camera);
+
+    /**
+     * Tests whether a box may be visible, after the last call to render().
+     *
+     * @param box The box, in world space.
+     *
+     * @return false if the box is hidden by the occluders, true otherwise.
+     */
+    bool isVisible(const BoundingBox& box) const;
+
+    /**
+     * Tests whether the drawable of a node may be visible, after the last call to render().
+     *
+     * The box of the mesh is tested for models, the box of the bounding sphere of the node
+     * for other drawables.
+     *
+     * @param node The node.
+     *
+     * @return false if the drawable is hidden by the occluders, true otherwise.
+     */
+    bool isVisible(Node* node) const;
+
+    /**
+     * Gets the width of the depth buffer.
+     *
+     * @return The width, in pixels.
+     */
+    unsigned int getWidth() const;
+
+    /**
+     * Gets the height of the depth buffer.
+     *
+     * @return The height, in pixels.
+     */
+    unsigned int getHeight() const;
+
+    /**
+     * Gets the depth buffer, row by row from the bottom of the screen.
+     *
+     * Depths are normalized device coordinates, 1 where no occluder was rasterized.
+     *
+     * @return The depth buffer.
+     */
+    const float* getDepthBuffer() const;
+
+    /**
+     * Gets the counters of the last call to render() and the tests made since.
+     *
+     * @return The statistics.
+     */
+    const Statistics& getStatistics() const;
+
+private:
+
+    /**
+     * The triangles of an occluder mesh, shared by the occluders that use it.
+     */
+    struct OccluderMesh
+    {
+        std::string url;
+        std::vector<Vector3> positions;
+        std::vector<unsigned int> indices;
+        unsigned int refCount;
+    };
+
+    /**
+     * A node rasterized with an occluder mesh.
+     */
+    struct Occluder
+    {
+        Node* node;
+        OccluderMesh* mesh;
+        Matrix worldViewProjection;
+        bool enabled;
+        unsigned int firstTriangle;     // First of the two triangle slots per mesh triangle.
+    };
+
+    /**
+     * A clipped triangle in screen space, set up for rasterization.
+     */
+    struct Triangle
+    {
+        float edge[3];                  // Edge functions at the center of pixel (minX, minY).
+        float edgeDx[3];
+        float edgeDy[3];
+        float depth;                    // Depth at the center of pixel (minX, minY).
+        float depthDx;
+        float depthDy;
+        int minX;
+        int maxX;
+        int minY;
+        int maxY;                       // Exclusive, minY >= maxY for empty slots.
+    };
+
+    /**
+     * Constructor.
+     */
+    OcclusionCuller(unsigned int width, unsigned int height);
+
+    /**
+     * Hidden copy constructor.
+     */
+    OcclusionCuller(const OcclusionCuller& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    OcclusionCuller& operator=(const OcclusionCuller&);
+
+    /**
+     * Gets an occluder mesh, loading it on the first use.
+     */
+    OccluderMesh* loadMesh(const char* url);
+
+    /**
+     * Releases an occluder mesh.
+     */
+    void releaseMesh(OccluderMesh* mesh);
+
+    /**
+     * Transforms, clips and sets up the triangles of a range of occluders.
+     */
+    void setupTriangles(unsigned int begin, unsigned int end);
+
+    /**
+     * Clips a triangle given in clip space against the near plane and sets up the one or two
+     * resulting triangles in two slots.
+     */
+    void setupTriangle(const Vector4& v0, const Vector4& v1, const Vector4& v2, Triangle* slots) const;
+
+    /**
+     * Sets up a triangle given in normalized device coordinates, leaving the slot empty if the
+     * triangle is back facing or outside the depth buffer.
+     */
+    void setupTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, Triangle* slot) const;
+
+    /**
+     * Rasterizes the triangles into a range of bands of rows.
+     */
+    void rasterize(unsigned int beginBand, unsigned int endBand);
+
+    unsigned int _width;
+    unsigned int _height;
+    std::vector<float> _depthBuffer;
+    std::vector<Occluder> _occluders;
+    std::map<std::string, OccluderMesh*> _meshes;
+    std::vector<Triangle> _triangles;
+    Matrix _viewProjection;
+    bool _rendered;
+    mutable Statistics _statistics;
+};
+
+}
+
+#endif
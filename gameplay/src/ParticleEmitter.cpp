@@ -10,12 +10,93 @@
 #define PARTICLE_EMISSION_RATE                   10
 #define PARTICLE_EMISSION_RATE_TIME_INTERVAL     1000.0f / (float)PARTICLE_EMISSION_RATE
 #define PARTICLE_UPDATE_RATE_MAX                 8
+#define PARTICLE_UPDATE_EMITTERS_PER_JOB         4
 
 namespace gameplay
 {
 
+ParticleEmitter::ParticlePool::ParticlePool()
+    : capacity(0), positionX(NULL), positionY(NULL), positionZ(NULL), velocityX(NULL), velocityY(NULL), velocityZ(NULL),
+      accelerationX(NULL), accelerationY(NULL), accelerationZ(NULL),
+      colorStartR(NULL), colorStartG(NULL), colorStartB(NULL), colorStartA(NULL),
+      colorEndR(NULL), colorEndG(NULL), colorEndB(NULL), colorEndA(NULL),
+      colorR(NULL), colorG(NULL), colorB(NULL), colorA(NULL),
+      rotationPerParticleSpeed(NULL), rotationAxisX(NULL), rotationAxisY(NULL), rotationAxisZ(NULL),
+      rotationSpeed(NULL), angle(NULL), energyStart(NULL), energy(NULL), sizeStart(NULL), sizeEnd(NULL), size(NULL),
+      timeOnCurrentFrame(NULL), frame(NULL), _data(NULL)
+{
+}
+
+ParticleEmitter::ParticlePool::~ParticlePool()
+{
+    SAFE_DELETE_ARRAY(_data);
+}
+
+void ParticleEmitter::ParticlePool::resize(unsigned int newCapacity, unsigned int preserveCount)
+{
+    GP_ASSERT(preserveCount <= newCapacity);
+
+    // Streams are padded to a multiple of four elements, so every stream in the block stays 16 bytes aligned.
+    newCapacity = (newCapacity + 3) & ~3u;
+
+    float** streams[] =
+    {
+        &positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ,
+        &accelerationX, &accelerationY, &accelerationZ,
+        &colorStartR, &colorStartG, &colorStartB, &colorStartA,
+        &colorEndR, &colorEndG, &colorEndB, &colorEndA,
+        &colorR, &colorG, &colorB, &colorA,
+        &rotationPerParticleSpeed, &rotationAxisX, &rotationAxisY, &rotationAxisZ,
+        &rotationSpeed, &angle, &energyStart, &energy, &sizeStart, &sizeEnd, &size,
+        &timeOnCurrentFrame
+    };
+    const unsigned int streamCount = sizeof(streams) / sizeof(streams[0]);
+
+    // One extra stream holds the frame indices, three extra floats are used for alignment.
+    float* data = new float[(streamCount + 1) * newCapacity + 3];
+    memset(data, 0, sizeof(float) * ((streamCount + 1) * newCapacity + 3));
+    float* aligned = (float*)(((size_t)data + 15) & ~(size_t)15);
+
+    for (unsigned int i = 0; i < streamCount; i++)
+    {
+        float* stream = aligned + i * newCapacity;
+        if (preserveCount)
+            memcpy(stream, *streams[i], sizeof(float) * preserveCount);
+        *streams[i] = stream;
+    }
+
+    unsigned int* frames = (unsigned int*)(aligned + streamCount * newCapacity);
+    if (preserveCount)
+        memcpy(frames, frame, sizeof(unsigned int) * preserveCount);
+    frame = frames;
+
+    SAFE_DELETE_ARRAY(_data);
+    _data = data;
+    capacity = newCapacity;
+}
+
+void ParticleEmitter::ParticlePool::move(unsigned int dst, unsigned int src)
+{
+    GP_ASSERT(dst < capacity && src < capacity);
+
+    float* streams[] =
+    {
+        positionX, positionY, positionZ, velocityX, velocityY, velocityZ,
+        accelerationX, accelerationY, accelerationZ,
+        colorStartR, colorStartG, colorStartB, colorStartA,
+        colorEndR, colorEndG, colorEndB, colorEndA,
+        colorR, colorG, colorB, colorA,
+        rotationPerParticleSpeed, rotationAxisX, rotationAxisY, rotationAxisZ,
+        rotationSpeed, angle, energyStart, energy, sizeStart, sizeEnd, size,
+        timeOnCurrentFrame
+    };
+    for (unsigned int i = 0; i < sizeof(streams) / sizeof(streams[0]); i++)
+        streams[i][dst] = streams[i][src];
+    frame[dst] = frame[src];
+}
+
 ParticleEmitter::ParticleEmitter(unsigned int particleCountMax) : Drawable(),
-    _particleCountMax(particleCountMax), _particleCount(0), _particles(NULL),
+    _particleCountMax(particleCountMax), _particleCount(0),
     _emissionRate(PARTICLE_EMISSION_RATE), _started(false), _ellipsoid(false),
     _sizeStartMin(1.0f), _sizeStartMax(1.0f), _sizeEndMin(1.0f), _sizeEndMax(1.0f),
     _energyMin(1000L), _energyMax(1000L),
@@ -25,20 +106,19 @@ ParticleEmitter::ParticleEmitter(unsigned int particleCountMax) : Drawable(),
     _acceleration(Vector3::zero()), _accelerationVar(Vector3::zero()),
     _rotationPerParticleSpeedMin(0.0f), _rotationPerParticleSpeedMax(0.0f),
     _rotationSpeedMin(0.0f), _rotationSpeedMax(0.0f),
-    _rotationAxis(Vector3::zero()), _rotation(Matrix::identity()),
+    _rotationAxis(Vector3::zero()),
     _spriteBatch(NULL), _spriteBlendMode(BLEND_ALPHA),  _spriteTextureWidth(0), _spriteTextureHeight(0), _spriteTextureWidthRatio(0), _spriteTextureHeightRatio(0), _spriteTextureCoords(NULL),
     _spriteAnimated(false),  _spriteLooped(false), _spriteFrameCount(1), _spriteFrameRandomOffset(0),_spriteFrameDuration(0L), _spriteFrameDurationSecs(0.0f), _spritePercentPerFrame(0.0f),
     _orbitPosition(false), _orbitVelocity(false), _orbitAcceleration(false),
-    _timePerEmission(PARTICLE_EMISSION_RATE_TIME_INTERVAL), _emitTime(0), _lastUpdated(0)
+    _timePerEmission(PARTICLE_EMISSION_RATE_TIME_INTERVAL), _emitTime(0), _runningTime(0)
 {
     GP_ASSERT(particleCountMax);
-    _particles = new Particle[particleCountMax];
+    _particles.resize(particleCountMax, 0);
 }
 
 ParticleEmitter::~ParticleEmitter()
 {
     SAFE_DELETE(_spriteBatch);
-    SAFE_DELETE_ARRAY(_particles);
     SAFE_DELETE_ARRAY(_spriteTextureCoords);
 }
 
@@ -250,7 +330,11 @@ Texture* ParticleEmitter::getTexture() const
 
 void ParticleEmitter::setParticleCountMax(unsigned int max)
 {
+    GP_ASSERT(max);
+
     _particleCountMax = max;
+    _particleCount = std::min(_particleCount, max);
+    _particles.resize(max, _particleCount);
 }
 
 unsigned int ParticleEmitter::getParticleCountMax() const
@@ -273,7 +357,7 @@ void ParticleEmitter::setEmissionRate(unsigned int rate)
 void ParticleEmitter::start()
 {
     _started = true;
-    _lastUpdated = 0;
+    _runningTime = 0;
 }
 
 void ParticleEmitter::stop()
@@ -300,7 +384,6 @@ bool ParticleEmitter::isActive() const
 void ParticleEmitter::emitOnce(unsigned int particleCount)
 {
     GP_ASSERT(_node);
-    GP_ASSERT(_particles);
 
     // Limit particleCount so as not to go over _particleCountMax.
     if (particleCount + _particleCount > _particleCountMax)
@@ -318,63 +401,95 @@ void ParticleEmitter::emitOnce(unsigned int particleCount)
     world.m[14] = 0.0f;
 
     // Emit the new particles.
+    Vector4 colorStart;
+    Vector4 colorEnd;
+    Vector3 position;
+    Vector3 velocity;
+    Vector3 acceleration;
+    Vector3 rotationAxis;
     for (unsigned int i = 0; i < particleCount; i++)
     {
-        Particle* p = &_particles[_particleCount];
+        const unsigned int index = _particleCount;
 
-        generateColor(_colorStart, _colorStartVar, &p->_colorStart);
-        generateColor(_colorEnd, _colorEndVar, &p->_colorEnd);
-        p->_color.set(p->_colorStart);
+        generateColor(_colorStart, _colorStartVar, &colorStart);
+        generateColor(_colorEnd, _colorEndVar, &colorEnd);
 
-        p->_energy = p->_energyStart = generateScalar(_energyMin, _energyMax);
-        p->_size = p->_sizeStart = generateScalar(_sizeStartMin, _sizeStartMax);
-        p->_sizeEnd = generateScalar(_sizeEndMin, _sizeEndMax);
-        p->_rotationPerParticleSpeed = generateScalar(_rotationPerParticleSpeedMin, _rotationPerParticleSpeedMax);
-        p->_angle = generateScalar(0.0f, p->_rotationPerParticleSpeed);
-        p->_rotationSpeed = generateScalar(_rotationSpeedMin, _rotationSpeedMax);
+        const long energy = (long)generateScalar(_energyMin, _energyMax);
+        const float sizeStart = generateScalar(_sizeStartMin, _sizeStartMax);
+        const float sizeEnd = generateScalar(_sizeEndMin, _sizeEndMax);
+        const float rotationPerParticleSpeed = generateScalar(_rotationPerParticleSpeedMin, _rotationPerParticleSpeedMax);
+        const float angle = generateScalar(0.0f, rotationPerParticleSpeed);
+        const float rotationSpeed = generateScalar(_rotationSpeedMin, _rotationSpeedMax);
 
         // Only initial position can be generated within an ellipsoidal domain.
-        generateVector(_position, _positionVar, &p->_position, _ellipsoid);
-        generateVector(_velocity, _velocityVar, &p->_velocity, false);
-        generateVector(_acceleration, _accelerationVar, &p->_acceleration, false);
-        generateVector(_rotationAxis, _rotationAxisVar, &p->_rotationAxis, false);
+        generateVector(_position, _positionVar, &position, _ellipsoid);
+        generateVector(_velocity, _velocityVar, &velocity, false);
+        generateVector(_acceleration, _accelerationVar, &acceleration, false);
+        generateVector(_rotationAxis, _rotationAxisVar, &rotationAxis, false);
 
         // Initial position, velocity and acceleration can all be relative to the emitter's transform.
         // Rotate specified properties by the node's rotation.
         if (_orbitPosition)
         {
-            world.transformPoint(p->_position, &p->_position);
+            world.transformPoint(position, &position);
         }
 
         if (_orbitVelocity)
         {
-            world.transformPoint(p->_velocity, &p->_velocity);
+            world.transformPoint(velocity, &velocity);
         }
 
         if (_orbitAcceleration)
         {
-            world.transformPoint(p->_acceleration, &p->_acceleration);
+            world.transformPoint(acceleration, &acceleration);
         }
 
         // The rotation axis always orbits the node.
-        if (p->_rotationSpeed != 0.0f && !p->_rotationAxis.isZero())
+        if (rotationSpeed != 0.0f && !rotationAxis.isZero())
         {
-            world.transformPoint(p->_rotationAxis, &p->_rotationAxis);
+            world.transformPoint(rotationAxis, &rotationAxis);
         }
 
         // Translate position relative to the node's world space.
-        p->_position.add(translation);
+        position.add(translation);
+
+        _particles.positionX[index] = position.x;
+        _particles.positionY[index] = position.y;
+        _particles.positionZ[index] = position.z;
+        _particles.velocityX[index] = velocity.x;
+        _particles.velocityY[index] = velocity.y;
+        _particles.velocityZ[index] = velocity.z;
+        _particles.accelerationX[index] = acceleration.x;
+        _particles.accelerationY[index] = acceleration.y;
+        _particles.accelerationZ[index] = acceleration.z;
+        _particles.colorStartR[index] = _particles.colorR[index] = colorStart.x;
+        _particles.colorStartG[index] = _particles.colorG[index] = colorStart.y;
+        _particles.colorStartB[index] = _particles.colorB[index] = colorStart.z;
+        _particles.colorStartA[index] = _particles.colorA[index] = colorStart.w;
+        _particles.colorEndR[index] = colorEnd.x;
+        _particles.colorEndG[index] = colorEnd.y;
+        _particles.colorEndB[index] = colorEnd.z;
+        _particles.colorEndA[index] = colorEnd.w;
+        _particles.rotationPerParticleSpeed[index] = rotationPerParticleSpeed;
+        _particles.rotationAxisX[index] = rotationAxis.x;
+        _particles.rotationAxisY[index] = rotationAxis.y;
+        _particles.rotationAxisZ[index] = rotationAxis.z;
+        _particles.rotationSpeed[index] = rotationSpeed;
+        _particles.angle[index] = angle;
+        _particles.energyStart[index] = _particles.energy[index] = (float)energy;
+        _particles.sizeStart[index] = _particles.size[index] = sizeStart;
+        _particles.sizeEnd[index] = sizeEnd;
 
         // Initial sprite frame.
         if (_spriteFrameRandomOffset > 0)
         {
-            p->_frame = rand() % _spriteFrameRandomOffset;
+            _particles.frame[index] = rand() % _spriteFrameRandomOffset;
         }
         else
         {
-            p->_frame = 0;
+            _particles.frame[index] = 0;
         }
-        p->_timeOnCurrentFrame = 0.0f;
+        _particles.timeOnCurrentFrame[index] = 0.0f;
 
         ++_particleCount;
     }
@@ -858,26 +973,64 @@ ParticleEmitter::BlendMode ParticleEmitter::getBlendModeFromString(const char* s
 
 void ParticleEmitter::update(float elapsedTime)
 {
-    if (!isActive())
+    float elapsedMs;
+    if (updateEmission(elapsedTime, &elapsedMs))
+        updateParticles(elapsedMs);
+}
+
+void ParticleEmitter::updateEmitters(ParticleEmitter* const* emitters, unsigned int count, float elapsedTime)
+{
+    // Emission reads node transforms and the shared random generator, so it runs on the calling thread.
+    std::vector<std::pair<ParticleEmitter*, float> > pending;
+    pending.reserve(count);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        GP_ASSERT(emitters[i]);
+        float elapsedMs;
+        if (emitters[i]->updateEmission(elapsedTime, &elapsedMs))
+            pending.push_back(std::make_pair(emitters[i], elapsedMs));
+    }
+
+    if (pending.empty())
+        return;
+
+    // Particle simulation only touches the emitter's own particles and runs on the worker threads.
+    JobScheduler* scheduler = Game::getInstance()->getJobScheduler();
+    if (!scheduler)
+    {
+        for (size_t i = 0, pendingCount = pending.size(); i < pendingCount; i++)
+            pending[i].first->updateParticles(pending[i].second);
         return;
+    }
+
+    scheduler->parallelFor((unsigned int)pending.size(), [&pending](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int i = begin; i < end; i++)
+            pending[i].first->updateParticles(pending[i].second);
+    }, PARTICLE_UPDATE_EMITTERS_PER_JOB);
+}
+
+bool ParticleEmitter::updateEmission(float elapsedTime, float* elapsedMs)
+{
+    GP_ASSERT(elapsedMs);
+
+    if (!isActive())
+        return false;
 
     // Cap particle updates at a maximum rate. This saves processing
     // and also improves precision since updating with very small
     // time increments is more lossy.
-    static double runningTime = 0;
-    runningTime += elapsedTime;
-    if (runningTime < PARTICLE_UPDATE_RATE_MAX)
-        return;    
-
-    float elapsedMs = runningTime;
-    runningTime = 0;
+    _runningTime += elapsedTime;
+    if (_runningTime < PARTICLE_UPDATE_RATE_MAX)
+        return false;
 
-    float elapsedSecs = elapsedMs * 0.001f;
+    *elapsedMs = (float)_runningTime;
+    _runningTime = 0;
 
     if (_started && _emissionRate)
     {
         // Calculate how much time has passed since we last emitted particles.
-        _emitTime += elapsedMs; //+= elapsedTime;
+        _emitTime += *elapsedMs;
 
         // How many particles should we emit this frame?
         GP_ASSERT(_timePerEmission);
@@ -893,92 +1046,285 @@ void ParticleEmitter::update(float elapsedTime)
         }
     }
 
-    // Now update all currently living particles.
-    GP_ASSERT(_particles);
-    for (unsigned int particlesIndex = 0; particlesIndex < _particleCount; ++particlesIndex)
-    {
-        Particle* p = &_particles[particlesIndex];
-        p->_energy -= elapsedMs;
+    return true;
+}
 
-        if (p->_energy > 0L)
+void ParticleEmitter::updateParticles(float elapsedMs)
+{
+    const float elapsedSecs = elapsedMs * 0.001f;
+
+    // Age the particles. A dead particle is replaced by the particle furthest from the start
+    // of the array, and the slot at the end of the list of living particles is re-used.
+    unsigned int particlesIndex = 0;
+    while (particlesIndex < _particleCount)
+    {
+        const float energy = _particles.energy[particlesIndex] - elapsedMs;
+        if (energy > 0.0f)
         {
-            if (p->_rotationSpeed != 0.0f && !p->_rotationAxis.isZero())
-            {
-                Matrix::createRotation(p->_rotationAxis, p->_rotationSpeed * elapsedSecs, &_rotation);
+            _particles.energy[particlesIndex++] = energy;
+        }
+        else
+        {
+            --_particleCount;
+            if (particlesIndex != _particleCount)
+                _particles.move(particlesIndex, _particleCount);
+        }
+    }
 
-                _rotation.transformPoint(p->_velocity, &p->_velocity);
-                _rotation.transformPoint(p->_acceleration, &p->_acceleration);
-            }
+    // Now update all currently living particles.
+    rotateParticles(0, _particleCount, elapsedSecs);
+    integrateParticles(0, _particleCount, elapsedSecs);
+}
 
-            // Particle is still alive.
-            p->_velocity.x += p->_acceleration.x * elapsedSecs;
-            p->_velocity.y += p->_acceleration.y * elapsedSecs;
-            p->_velocity.z += p->_acceleration.z * elapsedSecs;
+void ParticleEmitter::rotateParticles(unsigned int begin, unsigned int end, float elapsedSecs)
+{
+    Matrix rotation;
+    Vector3 v;
+    for (unsigned int i = begin; i < end; i++)
+    {
+        const float rotationSpeed = _particles.rotationSpeed[i];
+        if (rotationSpeed == 0.0f)
+            continue;
+
+        const Vector3 axis(_particles.rotationAxisX[i], _particles.rotationAxisY[i], _particles.rotationAxisZ[i]);
+        if (axis.isZero())
+            continue;
+
+        Matrix::createRotation(axis, rotationSpeed * elapsedSecs, &rotation);
+
+        v.set(_particles.velocityX[i], _particles.velocityY[i], _particles.velocityZ[i]);
+        rotation.transformPoint(&v);
+        _particles.velocityX[i] = v.x;
+        _particles.velocityY[i] = v.y;
+        _particles.velocityZ[i] = v.z;
+
+        v.set(_particles.accelerationX[i], _particles.accelerationY[i], _particles.accelerationZ[i]);
+        rotation.transformPoint(&v);
+        _particles.accelerationX[i] = v.x;
+        _particles.accelerationY[i] = v.y;
+        _particles.accelerationZ[i] = v.z;
+    }
+}
+
+void ParticleEmitter::integrateParticlesScalar(unsigned int begin, unsigned int end, float elapsedSecs)
+{
+    ParticlePool& p = _particles;
+    for (unsigned int i = begin; i < end; i++)
+    {
+        p.velocityX[i] = p.velocityX[i] + p.accelerationX[i] * elapsedSecs;
+        p.velocityY[i] = p.velocityY[i] + p.accelerationY[i] * elapsedSecs;
+        p.velocityZ[i] = p.velocityZ[i] + p.accelerationZ[i] * elapsedSecs;
 
-            p->_position.x += p->_velocity.x * elapsedSecs;
-            p->_position.y += p->_velocity.y * elapsedSecs;
-            p->_position.z += p->_velocity.z * elapsedSecs;
+        p.positionX[i] = p.positionX[i] + p.velocityX[i] * elapsedSecs;
+        p.positionY[i] = p.positionY[i] + p.velocityY[i] * elapsedSecs;
+        p.positionZ[i] = p.positionZ[i] + p.velocityZ[i] * elapsedSecs;
 
-            p->_angle += p->_rotationPerParticleSpeed * elapsedSecs;
+        p.angle[i] = p.angle[i] + p.rotationPerParticleSpeed[i] * elapsedSecs;
 
-            // Simple linear interpolation of color and size.
-            float percent = 1.0f - ((float)p->_energy / (float)p->_energyStart);
+        // Simple linear interpolation of color and size.
+        const float percent = 1.0f - p.energy[i] / p.energyStart[i];
 
-            p->_color.x = p->_colorStart.x + (p->_colorEnd.x - p->_colorStart.x) * percent;
-            p->_color.y = p->_colorStart.y + (p->_colorEnd.y - p->_colorStart.y) * percent;
-            p->_color.z = p->_colorStart.z + (p->_colorEnd.z - p->_colorStart.z) * percent;
-            p->_color.w = p->_colorStart.w + (p->_colorEnd.w - p->_colorStart.w) * percent;
+        p.colorR[i] = p.colorStartR[i] + (p.colorEndR[i] - p.colorStartR[i]) * percent;
+        p.colorG[i] = p.colorStartG[i] + (p.colorEndG[i] - p.colorStartG[i]) * percent;
+        p.colorB[i] = p.colorStartB[i] + (p.colorEndB[i] - p.colorStartB[i]) * percent;
+        p.colorA[i] = p.colorStartA[i] + (p.colorEndA[i] - p.colorStartA[i]) * percent;
 
-            p->_size = p->_sizeStart + (p->_sizeEnd - p->_sizeStart) * percent;
+        p.size[i] = p.sizeStart[i] + (p.sizeEnd[i] - p.sizeStart[i]) * percent;
 
-            // Handle sprite animations.
-            if (_spriteAnimated)
+        // Handle sprite animations.
+        if (_spriteAnimated)
+        {
+            if (!_spriteLooped)
             {
-                if (!_spriteLooped)
+                // The last frame should finish exactly when the particle dies.
+                const float timeOnCurrentFrame = percent - (float)p.frame[i] * _spritePercentPerFrame;
+                if (p.frame[i] < _spriteFrameCount - 1 && timeOnCurrentFrame >= _spritePercentPerFrame)
                 {
-                    // The last frame should finish exactly when the particle dies.
-                    float percentSpent = 0.0f;
-                    for (unsigned int i = 0; i < p->_frame; i++)
-                    {
-                        percentSpent += _spritePercentPerFrame;
-                    }
-                    p->_timeOnCurrentFrame = percent - percentSpent;
-                    if (p->_frame < _spriteFrameCount - 1 &&
-                        p->_timeOnCurrentFrame >= _spritePercentPerFrame)
-                    {
-                        ++p->_frame;
-                    }
+                    ++p.frame[i];
                 }
-                else
+                p.timeOnCurrentFrame[i] = timeOnCurrentFrame;
+            }
+            else
+            {
+                // _spriteFrameDurationSecs is an absolute time measured in seconds,
+                // and the animation repeats indefinitely.
+                p.timeOnCurrentFrame[i] = p.timeOnCurrentFrame[i] + elapsedSecs;
+                if (p.timeOnCurrentFrame[i] >= _spriteFrameDurationSecs)
                 {
-                    // _spriteFrameDurationSecs is an absolute time measured in seconds,
-                    // and the animation repeats indefinitely.
-                    p->_timeOnCurrentFrame += elapsedSecs;
-                    if (p->_timeOnCurrentFrame >= _spriteFrameDurationSecs)
+                    p.timeOnCurrentFrame[i] = p.timeOnCurrentFrame[i] - _spriteFrameDurationSecs;
+                    ++p.frame[i];
+                    if (p.frame[i] == _spriteFrameCount)
                     {
-                        p->_timeOnCurrentFrame -= _spriteFrameDurationSecs;
-                        ++p->_frame;
-                        if (p->_frame == _spriteFrameCount)
-                        {
-                            p->_frame = 0;
-                        }
+                        p.frame[i] = 0;
                     }
                 }
             }
         }
-        else
+    }
+}
+
+#if defined(GP_SIMD_SSE)
+
+void ParticleEmitter::integrateParticles(unsigned int begin, unsigned int end, float elapsedSecs)
+{
+    // Process unaligned head and the tail with the scalar kernel.
+    const unsigned int alignedBegin = std::min((begin + 3) & ~3u, end);
+    const unsigned int alignedEnd = alignedBegin + ((end - alignedBegin) & ~3u);
+    integrateParticlesScalar(begin, alignedBegin, elapsedSecs);
+
+    ParticlePool& p = _particles;
+    const __m128 dt = _mm_set1_ps(elapsedSecs);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 percentPerFrame = _mm_set1_ps(_spritePercentPerFrame);
+    const __m128 frameDuration = _mm_set1_ps(_spriteFrameDurationSecs);
+    const __m128i frameCount = _mm_set1_epi32((int)_spriteFrameCount);
+    const __m128i lastFrame = _mm_set1_epi32((int)_spriteFrameCount - 1);
+
+    for (unsigned int i = alignedBegin; i < alignedEnd; i += 4)
+    {
+        __m128 vx = _mm_add_ps(_mm_load_ps(p.velocityX + i), _mm_mul_ps(_mm_load_ps(p.accelerationX + i), dt));
+        __m128 vy = _mm_add_ps(_mm_load_ps(p.velocityY + i), _mm_mul_ps(_mm_load_ps(p.accelerationY + i), dt));
+        __m128 vz = _mm_add_ps(_mm_load_ps(p.velocityZ + i), _mm_mul_ps(_mm_load_ps(p.accelerationZ + i), dt));
+        _mm_store_ps(p.velocityX + i, vx);
+        _mm_store_ps(p.velocityY + i, vy);
+        _mm_store_ps(p.velocityZ + i, vz);
+
+        _mm_store_ps(p.positionX + i, _mm_add_ps(_mm_load_ps(p.positionX + i), _mm_mul_ps(vx, dt)));
+        _mm_store_ps(p.positionY + i, _mm_add_ps(_mm_load_ps(p.positionY + i), _mm_mul_ps(vy, dt)));
+        _mm_store_ps(p.positionZ + i, _mm_add_ps(_mm_load_ps(p.positionZ + i), _mm_mul_ps(vz, dt)));
+
+        _mm_store_ps(p.angle + i, _mm_add_ps(_mm_load_ps(p.angle + i), _mm_mul_ps(_mm_load_ps(p.rotationPerParticleSpeed + i), dt)));
+
+        const __m128 percent = _mm_sub_ps(one, _mm_div_ps(_mm_load_ps(p.energy + i), _mm_load_ps(p.energyStart + i)));
+
+        #define PARTICLE_LERP_SSE(dst, start, end) \
+            { \
+                const __m128 s = _mm_load_ps(start + i); \
+                _mm_store_ps(dst + i, _mm_add_ps(s, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(end + i), s), percent))); \
+            }
+        PARTICLE_LERP_SSE(p.colorR, p.colorStartR, p.colorEndR);
+        PARTICLE_LERP_SSE(p.colorG, p.colorStartG, p.colorEndG);
+        PARTICLE_LERP_SSE(p.colorB, p.colorStartB, p.colorEndB);
+        PARTICLE_LERP_SSE(p.colorA, p.colorStartA, p.colorEndA);
+        PARTICLE_LERP_SSE(p.size, p.sizeStart, p.sizeEnd);
+        #undef PARTICLE_LERP_SSE
+
+        if (_spriteAnimated)
         {
-            // Particle is dead.  Move the particle furthest from the start of the array
-            // down to take its place, and re-use the slot at the end of the list of living particles.
-            if (particlesIndex != _particleCount - 1)
+            __m128i frame = _mm_load_si128((const __m128i*)(p.frame + i));
+            if (!_spriteLooped)
             {
-                _particles[particlesIndex] = _particles[_particleCount - 1];
+                const __m128 time = _mm_sub_ps(percent, _mm_mul_ps(_mm_cvtepi32_ps(frame), percentPerFrame));
+                const __m128i advance = _mm_and_si128(_mm_cmplt_epi32(frame, lastFrame), _mm_castps_si128(_mm_cmpge_ps(time, percentPerFrame)));
+                frame = _mm_sub_epi32(frame, advance);
+                _mm_store_ps(p.timeOnCurrentFrame + i, time);
             }
-            --_particleCount;
+            else
+            {
+                __m128 time = _mm_add_ps(_mm_load_ps(p.timeOnCurrentFrame + i), dt);
+                const __m128 advance = _mm_cmpge_ps(time, frameDuration);
+                time = _mm_sub_ps(time, _mm_and_ps(advance, frameDuration));
+                frame = _mm_sub_epi32(frame, _mm_castps_si128(advance));
+                frame = _mm_andnot_si128(_mm_cmpeq_epi32(frame, frameCount), frame);
+                _mm_store_ps(p.timeOnCurrentFrame + i, time);
+            }
+            _mm_store_si128((__m128i*)(p.frame + i), frame);
         }
     }
+
+    integrateParticlesScalar(alignedEnd, end, elapsedSecs);
 }
 
+#elif defined(GP_SIMD_NEON)
+
+void ParticleEmitter::integrateParticles(unsigned int begin, unsigned int end, float elapsedSecs)
+{
+    // Process unaligned head and the tail with the scalar kernel.
+    const unsigned int alignedBegin = std::min((begin + 3) & ~3u, end);
+    const unsigned int alignedEnd = alignedBegin + ((end - alignedBegin) & ~3u);
+    integrateParticlesScalar(begin, alignedBegin, elapsedSecs);
+
+    ParticlePool& p = _particles;
+    const float32x4_t dt = vdupq_n_f32(elapsedSecs);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t percentPerFrame = vdupq_n_f32(_spritePercentPerFrame);
+    const float32x4_t frameDuration = vdupq_n_f32(_spriteFrameDurationSecs);
+    const uint32x4_t frameCount = vdupq_n_u32(_spriteFrameCount);
+    const uint32x4_t lastFrame = vdupq_n_u32(_spriteFrameCount - 1);
+
+    for (unsigned int i = alignedBegin; i < alignedEnd; i += 4)
+    {
+        float32x4_t vx = vaddq_f32(vld1q_f32(p.velocityX + i), vmulq_f32(vld1q_f32(p.accelerationX + i), dt));
+        float32x4_t vy = vaddq_f32(vld1q_f32(p.velocityY + i), vmulq_f32(vld1q_f32(p.accelerationY + i), dt));
+        float32x4_t vz = vaddq_f32(vld1q_f32(p.velocityZ + i), vmulq_f32(vld1q_f32(p.accelerationZ + i), dt));
+        vst1q_f32(p.velocityX + i, vx);
+        vst1q_f32(p.velocityY + i, vy);
+        vst1q_f32(p.velocityZ + i, vz);
+
+        vst1q_f32(p.positionX + i, vaddq_f32(vld1q_f32(p.positionX + i), vmulq_f32(vx, dt)));
+        vst1q_f32(p.positionY + i, vaddq_f32(vld1q_f32(p.positionY + i), vmulq_f32(vy, dt)));
+        vst1q_f32(p.positionZ + i, vaddq_f32(vld1q_f32(p.positionZ + i), vmulq_f32(vz, dt)));
+
+        vst1q_f32(p.angle + i, vaddq_f32(vld1q_f32(p.angle + i), vmulq_f32(vld1q_f32(p.rotationPerParticleSpeed + i), dt)));
+
+#if defined(__aarch64__)
+        const float32x4_t ratio = vdivq_f32(vld1q_f32(p.energy + i), vld1q_f32(p.energyStart + i));
+#else
+        // ARMv7 NEON has no exact division, divide per lane to stay identical to the scalar kernel.
+        float r[4];
+        for (unsigned int j = 0; j < 4; j++)
+            r[j] = p.energy[i + j] / p.energyStart[i + j];
+        const float32x4_t ratio = vld1q_f32(r);
+#endif
+        const float32x4_t percent = vsubq_f32(one, ratio);
+
+        #define PARTICLE_LERP_NEON(dst, start, end) \
+            { \
+                const float32x4_t s = vld1q_f32(start + i); \
+                vst1q_f32(dst + i, vaddq_f32(s, vmulq_f32(vsubq_f32(vld1q_f32(end + i), s), percent))); \
+            }
+        PARTICLE_LERP_NEON(p.colorR, p.colorStartR, p.colorEndR);
+        PARTICLE_LERP_NEON(p.colorG, p.colorStartG, p.colorEndG);
+        PARTICLE_LERP_NEON(p.colorB, p.colorStartB, p.colorEndB);
+        PARTICLE_LERP_NEON(p.colorA, p.colorStartA, p.colorEndA);
+        PARTICLE_LERP_NEON(p.size, p.sizeStart, p.sizeEnd);
+        #undef PARTICLE_LERP_NEON
+
+        if (_spriteAnimated)
+        {
+            uint32x4_t frame = vld1q_u32(p.frame + i);
+            if (!_spriteLooped)
+            {
+                const float32x4_t time = vsubq_f32(percent, vmulq_f32(vcvtq_f32_u32(frame), percentPerFrame));
+                const uint32x4_t advance = vandq_u32(vcltq_u32(frame, lastFrame), vcgeq_f32(time, percentPerFrame));
+                frame = vsubq_u32(frame, advance);
+                vst1q_f32(p.timeOnCurrentFrame + i, time);
+            }
+            else
+            {
+                float32x4_t time = vaddq_f32(vld1q_f32(p.timeOnCurrentFrame + i), dt);
+                const uint32x4_t advance = vcgeq_f32(time, frameDuration);
+                time = vsubq_f32(time, vreinterpretq_f32_u32(vandq_u32(advance, vreinterpretq_u32_f32(frameDuration))));
+                frame = vsubq_u32(frame, advance);
+                frame = vbicq_u32(frame, vceqq_u32(frame, frameCount));
+                vst1q_f32(p.timeOnCurrentFrame + i, time);
+            }
+            vst1q_u32(p.frame + i, frame);
+        }
+    }
+
+    integrateParticlesScalar(alignedEnd, end, elapsedSecs);
+}
+
+#else
+
+void ParticleEmitter::integrateParticles(unsigned int begin, unsigned int end, float elapsedSecs)
+{
+    integrateParticlesScalar(begin, end, elapsedSecs);
+}
+
+#endif
+
 unsigned int ParticleEmitter::draw(bool wireframe) const
 {
     if (!isActive())
@@ -987,7 +1333,6 @@ unsigned int ParticleEmitter::draw(bool wireframe) const
     if (_particleCount > 0)
     {
         GP_ASSERT(_spriteBatch);
-        GP_ASSERT(_particles);
         GP_ASSERT(_spriteTextureCoords);
 
         // Set our node's view projection matrix to this emitter's effect.
@@ -1013,11 +1358,14 @@ unsigned int ParticleEmitter::draw(bool wireframe) const
 
         for (unsigned int i = 0; i < _particleCount; i++)
         {
-            Particle* p = &_particles[i];
-
-            _spriteBatch->draw(p->_position, right, up, p->_size, p->_size,
-                                _spriteTextureCoords[p->_frame * 4], _spriteTextureCoords[p->_frame * 4 + 1], _spriteTextureCoords[p->_frame * 4 + 2], _spriteTextureCoords[p->_frame * 4 + 3],
-                                p->_color, pivot, p->_angle);
+            const Vector3 position(_particles.positionX[i], _particles.positionY[i], _particles.positionZ[i]);
+            const Vector4 color(_particles.colorR[i], _particles.colorG[i], _particles.colorB[i], _particles.colorA[i]);
+            const float size = _particles.size[i];
+            const float* texCoords = &_spriteTextureCoords[_particles.frame[i] * 4];
+
+            _spriteBatch->draw(position, right, up, size, size,
+                                texCoords[0], texCoords[1], texCoords[2], texCoords[3],
+                                color, pivot, _particles.angle[i]);
         }
 
         // Render.
@@ -707,6 +707,21 @@ public:
      */
     void update(float elapsedTime);
 
+    /**
+     * Updates a batch of particle emitters.
+     *
+     * Particle emission is done on the calling thread, particle simulation of the emitters
+     * is spread over the worker threads of the game's job scheduler. The result is the same
+     * as calling update() on each emitter.
+     *
+     * @param emitters The emitters to update.
+     * @param count The number of emitters.
+     * @param elapsedTime The amount of time that has passed since the last update, in milliseconds.
+     *
+     * @script{ignore}
+     */
+    static void updateEmitters(ParticleEmitter* const* emitters, unsigned int count, float elapsedTime);
+
     /**
      * @see Drawable::draw
      *
@@ -766,34 +781,90 @@ private:
     static ParticleEmitter::BlendMode getBlendModeFromString(const char* src);
 
     /**
-     * Defines the data for a single particle in the system.
+     * Structure-of-arrays storage of the emitter particles.
+     *
+     * Every stream holds one particle attribute. Streams are padded to a multiple of
+     * four elements and aligned to 16 bytes so the update kernels can process four
+     * particles at once.
      */
-    class Particle
+    class ParticlePool
     {
-
     public:
-        Vector3 _position;
-        Vector3 _velocity;
-        Vector3 _acceleration;
-        Vector4 _colorStart;
-        Vector4 _colorEnd;
-        Vector4 _color;
-        float _rotationPerParticleSpeed;
-        Vector3 _rotationAxis;
-        float _rotationSpeed;
-        float _angle;
-        long _energyStart;
-        long _energy;
-        float _sizeStart;
-        float _sizeEnd;
-        float _size;
-        unsigned int _frame;
-        float _timeOnCurrentFrame;
+
+        ParticlePool();
+
+        ~ParticlePool();
+
+        // Reallocates the streams, keeping the first preserveCount particles.
+        void resize(unsigned int capacity, unsigned int preserveCount);
+
+        // Copies the particle at index src over the particle at index dst.
+        void move(unsigned int dst, unsigned int src);
+
+        unsigned int capacity;
+        float* positionX;
+        float* positionY;
+        float* positionZ;
+        float* velocityX;
+        float* velocityY;
+        float* velocityZ;
+        float* accelerationX;
+        float* accelerationY;
+        float* accelerationZ;
+        float* colorStartR;
+        float* colorStartG;
+        float* colorStartB;
+        float* colorStartA;
+        float* colorEndR;
+        float* colorEndG;
+        float* colorEndB;
+        float* colorEndA;
+        float* colorR;
+        float* colorG;
+        float* colorB;
+        float* colorA;
+        float* rotationPerParticleSpeed;
+        float* rotationAxisX;
+        float* rotationAxisY;
+        float* rotationAxisZ;
+        float* rotationSpeed;
+        float* angle;
+        float* energyStart;
+        float* energy;
+        float* sizeStart;
+        float* sizeEnd;
+        float* size;
+        float* timeOnCurrentFrame;
+        unsigned int* frame;
+
+    private:
+
+        ParticlePool(const ParticlePool&);
+
+        ParticlePool& operator=(const ParticlePool&);
+
+        float* _data;
     };
 
+    // Advances the emitter's update timer and emits new particles. Returns true and the time step
+    // in milliseconds when the particles are due for an update.
+    bool updateEmission(float elapsedTime, float* elapsedMs);
+
+    // Ages, moves and animates the living particles.
+    void updateParticles(float elapsedMs);
+
+    // Rotates the velocity and acceleration of the particles in range [begin, end) that have a rotation speed.
+    void rotateParticles(unsigned int begin, unsigned int end, float elapsedSecs);
+
+    // Integrates motion, interpolates color and size and advances sprite frames of the particles in range [begin, end).
+    void integrateParticles(unsigned int begin, unsigned int end, float elapsedSecs);
+
+    // Scalar version of integrateParticles(). Gives bit-identical results to the SIMD kernels.
+    void integrateParticlesScalar(unsigned int begin, unsigned int end, float elapsedSecs);
+
     unsigned int _particleCountMax;
     unsigned int _particleCount;
-    Particle* _particles;
+    ParticlePool _particles;
     unsigned int _emissionRate;
     bool _started;
     bool _ellipsoid;
@@ -819,7 +890,6 @@ private:
     float _rotationSpeedMax;
     Vector3 _rotationAxis;
     Vector3 _rotationAxisVar;
-    Matrix _rotation;
     SpriteBatch* _spriteBatch;
     BlendMode _spriteBlendMode;
     float _spriteTextureWidth;
@@ -839,7 +909,7 @@ private:
     bool _orbitAcceleration;
     float _timePerEmission;
     float _emitTime;
-    double _lastUpdated;
+    double _runningTime;
 };
 
 }
@@ -569,6 +569,7 @@ Platform* Platform::create(Game* game)
     FileSystem::setResourcePath("./");
     Platform* platform = new Platform(game);
 
+#ifndef GP_NULL_GL
     // Get the display and initialize
     __display = XOpenDisplay(NULL);
     if (__display == NULL)
@@ -576,6 +577,7 @@ Platform* Platform::create(Game* game)
         perror("XOpenDisplay");
         return NULL;
     }
+#endif
 
     // Get the window configuration values
     const char *title = NULL;
@@ -597,7 +599,7 @@ Platform* Platform::create(Game* game)
             int samples = config->getInt("samples");
             fullscreen = config->getBool("fullscreen");
 
-            if (fullscreen && width == 0 && height == 0)
+            if (fullscreen && width == 0 && height == 0 && __display)
             {
                 // Use the screen resolution if fullscreen is true but width and height were not set in the config
                 int screen_num = DefaultScreen(__display);
@@ -612,6 +614,12 @@ Platform* Platform::create(Game* game)
         }
     }
 
+#ifdef GP_NULL_GL
+    // The null GL backend records the GL calls without a window or a GL context.
+    __windowSize[0] = __width;
+    __windowSize[1] = __height;
+    printf("GL version: null\n");
+#else
     // GLX version
     GLint majorGLX, minorGLX = 0;
     glXQueryVersion(__display, &majorGLX, &minorGLX);
@@ -736,12 +744,14 @@ Platform* Platform::create(Game* game)
         glXSwapIntervalEXT(__display, __window, __vsync ? 1 : 0);
     else if(glXSwapIntervalMESA)
         glXSwapIntervalMESA(__vsync ? 1 : 0);
+#endif
 
     return platform;
 }
 
 void cleanupX11()
 {
+#ifndef GP_NULL_GL
     if (__display)
     {
         glXMakeCurrent(__display, None, NULL);
@@ -753,6 +763,7 @@ void cleanupX11()
 
         XCloseDisplay(__display);
     }
+#endif
 }
 
 double timespec2millis(struct timespec *a)
@@ -763,12 +774,14 @@ double timespec2millis(struct timespec *a)
 
 void updateWindowSize()
 {
+#ifndef GP_NULL_GL
     GP_ASSERT(__display);
     GP_ASSERT(__window);
     XWindowAttributes windowAttrs;
     XGetWindowAttributes(__display, __window, &windowAttrs);
     __windowSize[0] = windowAttrs.width;
     __windowSize[1] = windowAttrs.height;
+#endif
 }
 
 
@@ -1136,6 +1149,14 @@ int Platform::enterMessagePump()
     // Run the game.
     _game->run();
 
+#ifdef GP_NULL_GL
+    // Without a window there are no events to handle, only frames to run.
+    while (_game->getState() != Game::UNINITIALIZED)
+    {
+        _game->frame();
+    }
+    return 0;
+#else
     // Setup select for message handling (to allow non-blocking)
     int x11_fd = ConnectionNumber(__display);
 
@@ -1341,6 +1362,7 @@ int Platform::enterMessagePump()
     cleanupX11();
 
     return 0;
+#endif
 }
 
 void Platform::signalShutdown()
@@ -1386,15 +1408,19 @@ void Platform::setVsync(bool enable)
 {
     __vsync = enable;
 
+#ifndef GP_NULL_GL
     if (glXSwapIntervalEXT)
         glXSwapIntervalEXT(__display, __window, __vsync ? 1 : 0);
     else if(glXSwapIntervalMESA)
         glXSwapIntervalMESA(__vsync ? 1 : 0);
+#endif
 }
 
 void Platform::swapBuffers()
 {
+#ifndef GP_NULL_GL
     glXSwapBuffers(__display, __window);
+#endif
 }
 
 void Platform::sleep(long ms)
@@ -1490,7 +1516,7 @@ bool Platform::hasMouse()
 
 void Platform::setMouseCaptured(bool captured)
 {
-    if (captured != __mouseCaptured)
+    if (captured != __mouseCaptured && __display)
     {
         if (captured)
         {
@@ -1519,7 +1545,7 @@ bool Platform::isMouseCaptured()
 
 void Platform::setCursorVisible(bool visible)
 {
-    if (visible != __cursorVisible)
+    if (visible != __cursorVisible && __display)
     {
         if (visible==false)
         {
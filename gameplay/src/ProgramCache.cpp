@@ -0,0 +1,295 @@
+#include "Base.h"
+#include "ProgramCache.h"
+#include "FileSystem.h"
+#include "Game.h"
+#include "Effect.h"
+
+// Identifies the program binary files, and their version to change with their layout
+#define PROGRAM_CACHE_MAGIC "GPPB"
+#define PROGRAM_CACHE_VERSION 1
+
+namespace gameplay
+{
+
+/**
+ * The header of a program binary file, followed by the binary.
+ */
+struct ProgramBinaryHeader
+{
+    char magic[4];
+    unsigned int version;
+    unsigned long long key;
+    unsigned int format;
+    unsigned int length;
+};
+
+static std::string __directory;
+static std::string __driver;
+static bool __supportChecked = false;
+static bool __supported = false;
+static std::set<std::string> __effectIds;
+static std::vector<Effect*> __prewarmedEffects;
+
+/**
+ * Hashes bytes with 64-bit FNV-1a, continuing from a previous hash.
+ */
+static unsigned long long hash(const void* data, size_t size, unsigned long long h)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; ++i)
+    {
+        h ^= bytes[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static unsigned long long hash(const std::string& str, unsigned long long h)
+{
+    // Include the terminator, so that the strings hashed in a row are delimited.
+    return hash(str.c_str(), str.length() + 1, h);
+}
+
+static std::string getBinaryPath(unsigned long long key)
+{
+    char name[32];
+    sprintf(name, "%016llx.bin", key);
+    return __directory + '/' + name;
+}
+
+void ProgramCache::setDirectory(const char* path)
+{
+    __directory = path ? path : "";
+
+    // Drop the trailing separator, the file names are appended after one.
+    while (!__directory.empty() && (__directory[__directory.length() - 1] == '/' || __directory[__directory.length() - 1] == '\\'))
+        __directory.erase(__directory.length() - 1);
+}
+
+const char* ProgramCache::getDirectory()
+{
+    return __directory.c_str();
+}
+
+bool ProgramCache::isSupported()
+{
+    if (!__supportChecked)
+    {
+        __supportChecked = true;
+#ifdef GP_USE_PROGRAM_BINARY
+        // The entry points are only loaded when the driver has the extension.
+        if (glGetProgramBinary && glProgramBinary)
+        {
+            GLint formatCount = 0;
+            GL_ASSERT( glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount) );
+            __supported = formatCount > 0;
+        }
+        if (__supported)
+        {
+            // Binaries are only valid for the driver that retrieved them.
+            const GLenum names[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                const GLubyte* str;
+                GL_ASSERT( str = glGetString(names[i]) );
+                __driver += str ? (const char*)str : "";
+                __driver += '\n';
+            }
+        }
+#endif
+    }
+    return __supported;
+}
+
+void ProgramCache::prewarm(const char* manifestPath)
+{
+    GP_ASSERT(manifestPath);
+
+    ResourceLoader* loader = Game::getInstance()->getResourceLoader();
+    GP_ASSERT(loader);
+
+    char* manifest = FileSystem::readAll(manifestPath);
+    if (manifest == NULL)
+    {
+        GP_WARN("Failed to read program cache manifest '%s'.", manifestPath);
+        return;
+    }
+
+    // Load the effect of each line, skipping empty lines and comments.
+    std::istringstream stream(manifest);
+    SAFE_DELETE_ARRAY(manifest);
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        if (!line.empty() && line[line.length() - 1] == '\r')
+            line.erase(line.length() - 1);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        // The defines are separated by semicolons too, so only the paths are split.
+        size_t vshEnd = line.find(';');
+        size_t fshEnd = vshEnd == std::string::npos ? std::string::npos : line.find(';', vshEnd + 1);
+        if (fshEnd == std::string::npos)
+        {
+            GP_WARN("Invalid effect id '%s' in program cache manifest '%s'.", line.c_str(), manifestPath);
+            continue;
+        }
+        std::string vshPath = line.substr(0, vshEnd);
+        std::string fshPath = line.substr(vshEnd + 1, fshEnd - vshEnd - 1);
+        std::string defines = line.substr(fshEnd + 1);
+        loader->loadEffect(vshPath.c_str(), fshPath.c_str(), defines.empty() ? NULL : defines.c_str(), [](Effect* effect)
+        {
+            // Hold the effect, the resource cache could destroy it before it is used.
+            if (effect)
+            {
+                effect->addRef();
+                __prewarmedEffects.push_back(effect);
+            }
+        });
+    }
+}
+
+void ProgramCache::releaseEffects()
+{
+    for (size_t i = 0, count = __prewarmedEffects.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(__prewarmedEffects[i]);
+    }
+    __prewarmedEffects.clear();
+}
+
+bool ProgramCache::saveManifest(const char* manifestPath)
+{
+    GP_ASSERT(manifestPath);
+
+    std::unique_ptr<Stream> stream(FileSystem::open(manifestPath, FileSystem::WRITE));
+    if (stream.get() == NULL || !stream->canWrite())
+    {
+        GP_WARN("Failed to write program cache manifest '%s'.", manifestPath);
+        return false;
+    }
+
+    for (std::set<std::string>::const_iterator itr = __effectIds.begin(); itr != __effectIds.end(); ++itr)
+    {
+        stream->write(itr->c_str(), 1, itr->length());
+        stream->write("\n", 1, 1);
+    }
+    return true;
+}
+
+bool ProgramCache::isEnabled()
+{
+    return !__directory.empty() && isSupported();
+}
+
+unsigned long long ProgramCache::getKey(const std::string& defines, const std::string& vshSource, const std::string& fshSource)
+{
+    unsigned long long h = 14695981039346656037ULL;
+    h = hash(__driver, h);
+    h = hash(defines, h);
+    h = hash(vshSource, h);
+    h = hash(fshSource, h);
+    return h;
+}
+
+bool ProgramCache::read(unsigned long long key, Binary* binary)
+{
+    GP_ASSERT(binary);
+
+    std::string path = getBinaryPath(key);
+    if (!FileSystem::fileExists(path.c_str()))
+        return false;
+    std::unique_ptr<Stream> stream(FileSystem::open(path.c_str()));
+    if (stream.get() == NULL)
+        return false;
+
+    // Ignore files from other versions, of other programs or truncated.
+    ProgramBinaryHeader header;
+    if (stream->read(&header, sizeof(header), 1) != 1 ||
+        memcmp(header.magic, PROGRAM_CACHE_MAGIC, 4) != 0 ||
+        header.version != PROGRAM_CACHE_VERSION ||
+        header.key != key ||
+        header.length == 0 ||
+        stream->length() != sizeof(header) + header.length)
+    {
+        GP_WARN("Ignoring invalid program binary '%s'.", path.c_str());
+        return false;
+    }
+
+    binary->format = (GLenum)header.format;
+    binary->data.resize(header.length);
+    return stream->read(&binary->data[0], 1, header.length) == header.length;
+}
+
+GLuint ProgramCache::load(const Binary& binary)
+{
+#ifdef GP_USE_PROGRAM_BINARY
+    GP_ASSERT(!binary.data.empty());
+
+    GLuint program;
+    GL_ASSERT( program = glCreateProgram() );
+
+    // A binary of another driver fails with an error or a link status, which is not asserted.
+    glProgramBinary(program, binary.format, &binary.data[0], (GLsizei)binary.data.size());
+    GLenum error = glGetError();
+    GLint success = GL_FALSE;
+    if (error == GL_NO_ERROR)
+        GL_ASSERT( glGetProgramiv(program, GL_LINK_STATUS, &success) );
+    if (success != GL_TRUE)
+    {
+        GL_ASSERT( glDeleteProgram(program) );
+        return 0;
+    }
+    return program;
+#else
+    return 0;
+#endif
+}
+
+GLuint ProgramCache::load(unsigned long long key)
+{
+    Binary binary;
+    if (!read(key, &binary))
+        return 0;
+    return load(binary);
+}
+
+void ProgramCache::save(unsigned long long key, GLuint program)
+{
+#ifdef GP_USE_PROGRAM_BINARY
+    GLint length = 0;
+    GL_ASSERT( glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length) );
+    if (length <= 0)
+        return;
+
+    std::vector<unsigned char> data(length);
+    GLsizei written = 0;
+    GLenum format = 0;
+    GL_ASSERT( glGetProgramBinary(program, length, &written, &format, &data[0]) );
+    if (written <= 0)
+        return;
+
+    ProgramBinaryHeader header;
+    memcpy(header.magic, PROGRAM_CACHE_MAGIC, 4);
+    header.version = PROGRAM_CACHE_VERSION;
+    header.key = key;
+    header.format = (unsigned int)format;
+    header.length = (unsigned int)written;
+
+    std::string path = getBinaryPath(key);
+    std::unique_ptr<Stream> stream(FileSystem::open(path.c_str(), FileSystem::WRITE));
+    if (stream.get() == NULL || !stream->canWrite() ||
+        stream->write(&header, sizeof(header), 1) != 1 ||
+        stream->write(&data[0], 1, written) != (size_t)written)
+    {
+        GP_WARN("Failed to write program binary '%s'.", path.c_str());
+    }
+#endif
+}
+
+void ProgramCache::addEffect(const std::string& id)
+{
+    __effectIds.insert(id);
+}
+
+}
@@ -0,0 +1,142 @@
+#ifndef PROGRAMCACHE_H_
+#define PROGRAMCACHE_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a cache of linked shader programs on disk, which spares effects the compilation
+ * and linking of their shaders when the game runs again.
+ *
+ * When an effect created from files links its program, the binary of the program is retrieved
+ * from the driver and saved to a file named after a hash of the preprocessed shader sources
+ * and of the driver vendor, renderer and version. An effect created from the same sources
+ * then loads the binary instead of compiling its shaders. A binary that the driver rejects,
+ * such as after a driver update, is compiled again and replaced.
+ *
+ * The cache is only used when the driver supports program binaries (OpenGL 4.1,
+ * GL_ARB_get_program_binary or GL_OES_get_program_binary) and a directory is set, by the
+ * "programCachePath" property of the "graphics" game config namespace or setDirectory().
+ * The directory must exist and be writable. The null GL backend does not support the cache.
+ *
+ * The effects of a game can be listed in a manifest, one effect id (vertex shader path,
+ * fragment shader path and defines separated by semicolons, as returned by Effect::getId())
+ * per line, which saveManifest() writes from the effects created so far. prewarm() loads the
+ * effects of a manifest with the resource loader, which reads and preprocesses the shaders
+ * and reads the program binaries on its threads. The "programCacheManifest" property of the
+ * "graphics" namespace prewarms a manifest when the game starts. The prewarmed effects are
+ * held by the program cache, whatever the resource cache budget, until releaseEffects() is
+ * called or the game shuts down.
+ *
+ * @script{ignore}
+ */
+class ProgramCache
+{
+    friend class Effect;
+    friend class ResourceLoader;
+
+public:
+
+    /**
+     * Sets the directory of the program binary files.
+     *
+     * @param path The path of the directory, or NULL or empty to disable the cache.
+     */
+    static void setDirectory(const char* path);
+
+    /**
+     * Gets the directory of the program binary files.
+     *
+     * @return The path of the directory, empty if the cache is disabled.
+     */
+    static const char* getDirectory();
+
+    /**
+     * Checks whether the driver can save and load program binaries.
+     *
+     * @return true if program binaries are supported, false otherwise.
+     */
+    static bool isSupported();
+
+    /**
+     * Loads the effects listed in a manifest in the background and holds them, so that
+     * creating them again finds them loaded.
+     *
+     * @param manifestPath The path of the manifest.
+     */
+    static void prewarm(const char* manifestPath);
+
+    /**
+     * Releases the effects held since they were prewarmed, which are destroyed when they are
+     * not used anymore and evicted from the resource cache.
+     */
+    static void releaseEffects();
+
+    /**
+     * Writes the ids of the effects created from files so far to a manifest.
+     *
+     * @param manifestPath The path of the manifest.
+     *
+     * @return true if the manifest was written, false otherwise.
+     */
+    static bool saveManifest(const char* manifestPath);
+
+private:
+
+    /**
+     * The binary of a linked program.
+     */
+    struct Binary
+    {
+        GLenum format;
+        std::vector<unsigned char> data;
+    };
+
+    /**
+     * Constructor.
+     */
+    ProgramCache();
+
+    /**
+     * Checks whether the cache is used, which must first be called on the main thread.
+     */
+    static bool isEnabled();
+
+    /**
+     * Hashes the preprocessed sources of a program with the driver id.
+     */
+    static unsigned long long getKey(const std::string& defines, const std::string& vshSource, const std::string& fshSource);
+
+    /**
+     * Reads the binary file of a program, which is safe on a loader thread.
+     */
+    static bool read(unsigned long long key, Binary* binary);
+
+    /**
+     * Creates a program from a binary.
+     *
+     * @return The linked program, or 0 if the driver rejected the binary.
+     */
+    static GLuint load(const Binary& binary);
+
+    /**
+     * Creates a program from its binary file.
+     *
+     * @return The linked program, or 0 if there is no usable binary file.
+     */
+    static GLuint load(unsigned long long key);
+
+    /**
+     * Writes the binary file of a linked program.
+     */
+    static void save(unsigned long long key, GLuint program);
+
+    /**
+     * Records the id of an effect created from files, for saveManifest().
+     */
+    static void addEffect(const std::string& id);
+};
+
+}
+
+#endif
@@ -0,0 +1,331 @@
+#include "Base.h"
+#include "RenderQueue.h"
+#include "Model.h"
+#include "MeshPart.h"
+#include "Material.h"
+#include "Technique.h"
+#include "Pass.h"
+#include "Node.h"
+#include "Scene.h"
+#include "Camera.h"
+
+// Widths of the fields of the sort keys, in bits. Ids that do not fit share the last value.
+#define SORT_KEY_ID_BITS 12
+#define SORT_KEY_BINDING_BITS 10
+#define SORT_KEY_OPAQUE_DEPTH_BITS 15
+#define SORT_KEY_TRANSLUCENT_DEPTH_BITS 16
+
+namespace gameplay
+{
+
+static RenderQueue* __activeQueue = NULL;
+
+template <class T>
+static unsigned int getSortId(std::unordered_map<T, unsigned int>& ids, const T& object, unsigned int bits)
+{
+    // Ids are assigned in the order objects are first seen in a frame, so they stay small.
+    typename std::unordered_map<T, unsigned int>::iterator itr = ids.find(object);
+    unsigned int id;
+    if (itr == ids.end())
+    {
+        id = (unsigned int)ids.size();
+        ids[object] = id;
+    }
+    else
+    {
+        id = itr->second;
+    }
+    const unsigned int max = (1u << bits) - 1;
+    return id < max ? id : max;
+}
+
+static unsigned long long quantizeDepth(float depth, unsigned int bits)
+{
+    const unsigned int max = (1u << bits) - 1;
+    if (depth <= 0.0f)
+        return 0;
+    if (depth >= 1.0f)
+        return max;
+    return (unsigned long long)(depth * max);
+}
+
+RenderQueue::RenderQueue()
+    : _camera(NULL), _mergeDuplicates(false)
+{
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+RenderQueue::~RenderQueue()
+{
+    if (__activeQueue == this)
+    {
+        __activeQueue = NULL;
+    }
+}
+
+RenderQueue* RenderQueue::create()
+{
+    return new RenderQueue();
+}
+
+void RenderQueue::begin(Camera* camera)
+{
+    GP_ASSERT(__activeQueue == NULL);
+
+    _camera = camera;
+    _items.clear();
+    __activeQueue = this;
+}
+
+unsigned int RenderQueue::end()
+{
+    GP_ASSERT(__activeQueue == this);
+    __activeQueue = NULL;
+
+    memset(&_statistics, 0, sizeof(_statistics));
+
+    std::sort(_items.begin(), _items.end(), [](const Item& a, const Item& b)
+    {
+        if (a.key != b.key)
+            return a.key < b.key;
+
+        // Order equal keys by draw call so the duplicates of an item end up next to each other.
+        if (a.model != b.model)
+            return a.model < b.model;
+        if (a.part != b.part)
+            return a.part < b.part;
+        if (a.pass != b.pass)
+            return a.pass < b.pass;
+        return a.wireframe < b.wireframe;
+    });
+
+    Effect* currentEffect = NULL;
+    Pass* currentPass = NULL;
+    const Model* currentModel = NULL;
+    VertexAttributeBinding* currentBinding = NULL;
+    IndexBufferHandle currentIndexBuffer = 0;
+    bool indexBufferBound = false;
+
+    for (size_t i = 0, count = _items.size(); i < count; ++i)
+    {
+        const Item& item = _items[i];
+        if (_mergeDuplicates && i > 0)
+        {
+            const Item& previous = _items[i - 1];
+            if (item.model == previous.model && item.part == previous.part && item.pass == previous.pass && item.wireframe == previous.wireframe)
+            {
+                ++_statistics.drawsAvoided;
+                continue;
+            }
+        }
+
+        Pass* pass = item.pass;
+        Effect* effect = pass->getEffect();
+        GP_ASSERT(effect);
+        if (effect != currentEffect)
+        {
+            effect->bind();
+            currentEffect = effect;
+            ++_statistics.effectBinds;
+        }
+        else
+        {
+            ++_statistics.effectBindsAvoided;
+        }
+
+        // The parameters of a pass are bound for the node of the model being drawn.
+        if (pass != currentPass || item.model != currentModel)
+        {
+            pass->RenderState::bind(pass);
+            ++_statistics.stateBinds;
+        }
+        else
+        {
+            ++_statistics.stateBindsAvoided;
+        }
+
+        if (item.model != currentModel)
+        {
+            item.model->bindSoftwareSkin();
+        }
+        currentPass = pass;
+        currentModel = item.model;
+
+        VertexAttributeBinding* binding = pass->getVertexAttributeBinding();
+        if (binding != currentBinding)
+        {
+            if (currentBinding)
+            {
+                currentBinding->unbind();
+            }
+            if (binding)
+            {
+                binding->bind();
+            }
+            currentBinding = binding;
+            ++_statistics.vertexBindings;
+
+            // The element array buffer binding is part of the vertex array object state.
+            indexBufferBound = false;
+        }
+        else
+        {
+            ++_statistics.vertexBindingsAvoided;
+        }
+
+        IndexBufferHandle indexBuffer = item.part ? item.part->getIndexBuffer() : 0;
+        if (!indexBufferBound || indexBuffer != currentIndexBuffer)
+        {
+            GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer) );
+            currentIndexBuffer = indexBuffer;
+            indexBufferBound = true;
+        }
+        else
+        {
+            ++_statistics.indexBufferBindsAvoided;
+        }
+
+        item.model->drawGeometry(item.part, item.wireframe);
+        ++_statistics.drawCalls;
+    }
+
+    if (currentBinding)
+    {
+        currentBinding->unbind();
+    }
+
+    _items.clear();
+    _effectIds.clear();
+    _stateIds.clear();
+    _textureIds.clear();
+    _bindingIds.clear();
+    _camera = NULL;
+
+    return _statistics.drawCalls;
+}
+
+void RenderQueue::setMergeDuplicates(bool merge)
+{
+    _mergeDuplicates = merge;
+}
+
+bool RenderQueue::isMergingDuplicates() const
+{
+    return _mergeDuplicates;
+}
+
+const RenderQueue::Statistics& RenderQueue::getStatistics() const
+{
+    return _statistics;
+}
+
+RenderQueue* RenderQueue::getActive()
+{
+    return __activeQueue;
+}
+
+void RenderQueue::add(const Model* model, bool wireframe)
+{
+    GP_ASSERT(model);
+    Mesh* mesh = model->getMesh();
+    GP_ASSERT(mesh);
+
+    // Depth of the model along the view direction, in [0, 1] between the camera and its far plane.
+    float depth = 0.0f;
+    Node* node = model->getNode();
+    if (node)
+    {
+        Camera* camera = _camera;
+        if (camera == NULL && node->getScene())
+        {
+            camera = node->getScene()->getActiveCamera();
+        }
+        if (camera && camera->getNode() && camera->getFarPlane() > 0.0f)
+        {
+            Node* cameraNode = camera->getNode();
+            Vector3 offset = node->getBoundingSphere().center - cameraNode->getTranslationWorld();
+            depth = offset.dot(cameraNode->getForwardVectorWorld()) / camera->getFarPlane();
+        }
+    }
+
+    unsigned int partCount = mesh->getPartCount();
+    if (partCount == 0)
+    {
+        const Material* material = model->getMaterial();
+        if (material)
+        {
+            Technique* technique = material->getTechnique();
+            GP_ASSERT(technique);
+            for (unsigned int i = 0, passCount = technique->getPassCount(); i < passCount; ++i)
+            {
+                add(model, NULL, technique->getPassByIndex(i), i, depth, wireframe);
+            }
+        }
+    }
+    else
+    {
+        for (unsigned int i = 0; i < partCount; ++i)
+        {
+            MeshPart* part = mesh->getPart(i);
+            GP_ASSERT(part);
+            const Material* material = model->getMaterial(i);
+            if (material)
+            {
+                Technique* technique = material->getTechnique();
+                GP_ASSERT(technique);
+                for (unsigned int j = 0, passCount = technique->getPassCount(); j < passCount; ++j)
+                {
+                    add(model, part, technique->getPassByIndex(j), j, depth, wireframe);
+                }
+            }
+        }
+    }
+}
+
+void RenderQueue::add(const Model* model, MeshPart* part, Pass* pass, unsigned int passIndex, float depth, bool wireframe)
+{
+    GP_ASSERT(pass);
+
+    unsigned int stateHash;
+    bool translucent;
+    const Texture* texture;
+    pass->getSortInfo(&stateHash, &translucent, &texture);
+
+    unsigned long long effectId = getSortId<const void*>(_effectIds, pass->getEffect(), SORT_KEY_ID_BITS);
+    unsigned long long stateId = getSortId<unsigned int>(_stateIds, stateHash, SORT_KEY_ID_BITS);
+    unsigned long long textureId = getSortId<const void*>(_textureIds, texture, SORT_KEY_ID_BITS);
+    unsigned long long bindingId = getSortId<const void*>(_bindingIds, pass->getVertexAttributeBinding(), SORT_KEY_BINDING_BITS);
+
+    // Passes are drawn in order, then opaque items before translucent ones.
+    unsigned long long key = (unsigned long long)(passIndex < 3 ? passIndex : 3) << 62;
+    if (translucent)
+    {
+        // Back to front first, then by state for the items at the same depth.
+        unsigned long long depthBits = ((1ull << SORT_KEY_TRANSLUCENT_DEPTH_BITS) - 1) - quantizeDepth(depth, SORT_KEY_TRANSLUCENT_DEPTH_BITS);
+        key |= 1ull << 61;
+        key |= depthBits << 45;
+        key |= effectId << 33;
+        key |= stateId << 21;
+        key |= textureId << 9;
+        key |= bindingId & ((1ull << 9) - 1);
+    }
+    else
+    {
+        // By state first, then front to back within the items that share it.
+        key |= effectId << 49;
+        key |= stateId << 37;
+        key |= textureId << 25;
+        key |= bindingId << 15;
+        key |= quantizeDepth(depth, SORT_KEY_OPAQUE_DEPTH_BITS);
+    }
+
+    Item item;
+    item.key = key;
+    item.model = model;
+    item.part = part;
+    item.pass = pass;
+    item.wireframe = wireframe;
+    _items.push_back(item);
+}
+
+}
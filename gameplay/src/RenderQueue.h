@@ -0,0 +1,170 @@
+#ifndef RENDERQUEUE_H_
+#define RENDERQUEUE_H_
+
+namespace gameplay
+{
+
+class Camera;
+class Model;
+class MeshPart;
+class Pass;
+
+/**
+ * Defines a queue that collects the draw calls of a frame, sorts them and issues them
+ * with as few state changes as possible.
+ *
+ * While a queue is recording, between begin() and end(), Model::draw() adds one draw item
+ * per mesh part and pass to the queue instead of drawing. end() sorts the items by a 64-bit
+ * key made of the pass index, the translucency, the effect, the render states, the texture,
+ * the vertex attribute binding and the depth of the item, then issues them, skipping the
+ * binds that the previous item already made.
+ *
+ * Opaque items are grouped by state and drawn front to back within a group. Translucent
+ * items, which are the ones with blending enabled, are drawn after them from back to front.
+ * Drawables other than models are not queued and draw immediately.
+ *
+ * A model drawn more than once while recording is drawn as many times, since each draw can
+ * matter, such as with blending. setMergeDuplicates() opts in to drawing the repeated draw
+ * calls of a model, mesh part and pass only once.
+ *
+ * @script{ignore}
+ */
+class RenderQueue
+{
+    friend class Model;
+
+public:
+
+    /**
+     * Counters of the last submitted frame.
+     */
+    struct Statistics
+    {
+        /** Number of draw calls issued. */
+        unsigned int drawCalls;
+        /** Number of items that were queued more than once and only drawn once, when duplicates are merged. */
+        unsigned int drawsAvoided;
+        /** Number of effect binds. */
+        unsigned int effectBinds;
+        /** Number of effect binds skipped because the effect was already bound. */
+        unsigned int effectBindsAvoided;
+        /** Number of render state binds. */
+        unsigned int stateBinds;
+        /** Number of render state binds skipped because the pass was already bound for the model. */
+        unsigned int stateBindsAvoided;
+        /** Number of vertex attribute binding binds. */
+        unsigned int vertexBindings;
+        /** Number of vertex attribute binding binds skipped because it was already bound. */
+        unsigned int vertexBindingsAvoided;
+        /** Number of index buffer binds skipped because it was already bound. */
+        unsigned int indexBufferBindsAvoided;
+    };
+
+    /**
+     * Creates a render queue.
+     *
+     * @return The new render queue.
+     */
+    static RenderQueue* create();
+
+    /**
+     * Destructor.
+     */
+    ~RenderQueue();
+
+    /**
+     * Starts recording the draw calls of models.
+     *
+     * @param camera The camera the items are sorted by depth for. If NULL, the active camera
+     *      of the scene of each model is used.
+     */
+    void begin(Camera* camera = NULL);
+
+    /**
+     * Stops recording, sorts the recorded items and draws them.
+     *
+     * @return The number of draw calls issued.
+     */
+    unsigned int end();
+
+    /**
+     * Sets whether the draw calls queued more than once with the same model, mesh part, pass
+     * and fill mode are only drawn once. False by default.
+     *
+     * @param merge true to draw the duplicates once, false to draw every queued item.
+     */
+    void setMergeDuplicates(bool merge);
+
+    /**
+     * Checks whether the duplicated draw calls are only drawn once.
+     *
+     * @return true if duplicates are merged, false otherwise.
+     */
+    bool isMergingDuplicates() const;
+
+    /**
+     * Gets the counters of the last call to end().
+     *
+     * @return The statistics.
+     */
+    const Statistics& getStatistics() const;
+
+    /**
+     * Gets the queue that is recording, if any.
+     *
+     * @return The recording queue, or NULL.
+     */
+    static RenderQueue* getActive();
+
+private:
+
+    /**
+     * A draw call of a mesh part with a pass.
+     */
+    struct Item
+    {
+        unsigned long long key;
+        const Model* model;
+        MeshPart* part;                 // NULL to draw the mesh without an index buffer.
+        Pass* pass;
+        bool wireframe;
+    };
+
+    /**
+     * Constructor.
+     */
+    RenderQueue();
+
+    /**
+     * Hidden copy constructor.
+     */
+    RenderQueue(const RenderQueue& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    RenderQueue& operator=(const RenderQueue&);
+
+    /**
+     * Queues the draw calls of a model.
+     */
+    void add(const Model* model, bool wireframe);
+
+    /**
+     * Queues a draw call.
+     */
+    void add(const Model* model, MeshPart* part, Pass* pass, unsigned int passIndex, float depth, bool wireframe);
+
+    std::vector<Item> _items;
+    Camera* _camera;
+    bool _mergeDuplicates;
+    std::unordered_map<const void*, unsigned int> _effectIds;
+    std::unordered_map<unsigned int, unsigned int> _stateIds;    // Keyed by the hash of the render states.
+    std::unordered_map<const void*, unsigned int> _textureIds;
+    std::unordered_map<const void*, unsigned int> _bindingIds;
+    Statistics _statistics;
+};
+
+}
+
+#endif
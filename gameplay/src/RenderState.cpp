@@ -28,8 +28,11 @@ namespace gameplay
 RenderState::StateBlock* RenderState::StateBlock::_defaultState = NULL;
 std::vector<RenderState::AutoBindingResolver*> RenderState::_customAutoBindingResolvers;
 
+// Revision of the RenderState hierarchies, incremented when one of them changes.
+static unsigned int __bindingRevision = 1;
+
 RenderState::RenderState()
-    : _nodeBinding(NULL), _state(NULL), _parent(NULL)
+    : _nodeBinding(NULL), _state(NULL), _parent(NULL), _bindingRevision(0)
 {
 }
 
@@ -42,6 +45,8 @@ RenderState::~RenderState()
     {
         SAFE_RELEASE(_parameters[i]);
     }
+
+    invalidateBindings();
 }
 
 void RenderState::initialize()
@@ -76,6 +81,7 @@ MaterialParameter* RenderState::getParameter(const char* name) const
     // Create a new parameter and store it in our list.
     param = new MaterialParameter(name);
     _parameters.push_back(param);
+    invalidateBindings();
 
     return param;
 }
@@ -94,6 +100,7 @@ void RenderState::addParameter(MaterialParameter* param)
 {
     _parameters.push_back(param);
     param->addRef();
+    invalidateBindings();
 }
 
 void RenderState::removeParameter(const char* name)
@@ -105,58 +112,52 @@ void RenderState::removeParameter(const char* name)
         {
             _parameters.erase(_parameters.begin() + i);
             SAFE_RELEASE(p);
+            invalidateBindings();
             break;
         }
     }
 }
 
+// Names of the built-in auto bindings, indexed by RenderState::AutoBinding.
+// NOTE: As new AutoBinding values are added, this table must be updated.
+static const char* __autoBindingNames[] =
+{
+    NULL,
+    "WORLD_MATRIX",
+    "VIEW_MATRIX",
+    "PROJECTION_MATRIX",
+    "WORLD_VIEW_MATRIX",
+    "VIEW_PROJECTION_MATRIX",
+    "WORLD_VIEW_PROJECTION_MATRIX",
+    "INVERSE_TRANSPOSE_WORLD_MATRIX",
+    "INVERSE_TRANSPOSE_WORLD_VIEW_MATRIX",
+    "CAMERA_WORLD_POSITION",
+    "CAMERA_VIEW_POSITION",
+    "MATRIX_PALETTE",
+    "SCENE_AMBIENT_COLOR"
+};
+
 /**
  * @script{ignore}
  */
 const char* autoBindingToString(RenderState::AutoBinding autoBinding)
 {
-    // NOTE: As new AutoBinding values are added, this switch statement must be updatd.
-    switch (autoBinding)
-    {
-    case RenderState::NONE:
-        return NULL;
-
-    case RenderState::VIEW_MATRIX:
-        return "VIEW_MATRIX";
-
-    case RenderState::PROJECTION_MATRIX:
-        return "PROJECTION_MATRIX";
-
-    case RenderState::WORLD_VIEW_MATRIX:
-        return "WORLD_VIEW_MATRIX";
-
-    case RenderState::VIEW_PROJECTION_MATRIX:
-        return "VIEW_PROJECTION_MATRIX";
-
-    case RenderState::WORLD_VIEW_PROJECTION_MATRIX:
-        return "WORLD_VIEW_PROJECTION_MATRIX";
-
-    case RenderState::INVERSE_TRANSPOSE_WORLD_MATRIX:
-        return "INVERSE_TRANSPOSE_WORLD_MATRIX";
-
-    case RenderState::INVERSE_TRANSPOSE_WORLD_VIEW_MATRIX:
-        return "INVERSE_TRANSPOSE_WORLD_VIEW_MATRIX";
-
-    case RenderState::CAMERA_WORLD_POSITION:
-        return "CAMERA_WORLD_POSITION";
-
-    case RenderState::CAMERA_VIEW_POSITION:
-        return "CAMERA_VIEW_POSITION";
-
-    case RenderState::MATRIX_PALETTE:
-        return "MATRIX_PALETTE";
-
-    case RenderState::SCENE_AMBIENT_COLOR:
-        return "SCENE_AMBIENT_COLOR";
-
-    default:
+    if (autoBinding < 0 || autoBinding > RenderState::SCENE_AMBIENT_COLOR)
         return "";
+    return __autoBindingNames[autoBinding];
+}
+
+/**
+ * Gets the built-in auto binding with a name, or NONE.
+ */
+static RenderState::AutoBinding autoBindingFromString(const char* autoBinding)
+{
+    for (int i = RenderState::NONE + 1; i <= RenderState::SCENE_AMBIENT_COLOR; ++i)
+    {
+        if (strcmp(autoBinding, __autoBindingNames[i]) == 0)
+            return (RenderState::AutoBinding)i;
     }
+    return RenderState::NONE;
 }
 
 void RenderState::setParameterAutoBinding(const char* name, AutoBinding autoBinding)
@@ -198,6 +199,8 @@ void RenderState::setStateBlock(StateBlock* state)
         {
             _state->addRef();
         }
+
+        invalidateBindings();
     }
 }
 
@@ -206,6 +209,7 @@ RenderState::StateBlock* RenderState::getStateBlock() const
     if (_state == NULL)
     {
         _state = StateBlock::create();
+        invalidateBindings();
     }
 
     return _state;
@@ -253,58 +257,48 @@ void RenderState::applyAutoBinding(const char* uniformName, const char* autoBind
     {
         bound = true;
 
-        if (strcmp(autoBinding, "WORLD_MATRIX") == 0)
+        switch (autoBindingFromString(autoBinding))
         {
+        case WORLD_MATRIX:
             param->bindValue(this, &RenderState::autoBindingGetWorldMatrix);
-        }
-        else if (strcmp(autoBinding, "VIEW_MATRIX") == 0)
-        {
+            break;
+        case VIEW_MATRIX:
             param->bindValue(this, &RenderState::autoBindingGetViewMatrix);
-        }
-        else if (strcmp(autoBinding, "PROJECTION_MATRIX") == 0)
-        {
+            break;
+        case PROJECTION_MATRIX:
             param->bindValue(this, &RenderState::autoBindingGetProjectionMatrix);
-        }
-        else if (strcmp(autoBinding, "WORLD_VIEW_MATRIX") == 0)
-        {
+            break;
+        case WORLD_VIEW_MATRIX:
             param->bindValue(this, &RenderState::autoBindingGetWorldViewMatrix);
-        }
-        else if (strcmp(autoBinding, "VIEW_PROJECTION_MATRIX") == 0)
-        {
+            break;
+        case VIEW_PROJECTION_MATRIX:
             param->bindValue(this, &RenderState::autoBindingGetViewProjectionMatrix);
-        }
-        else if (strcmp(autoBinding, "WORLD_VIEW_PROJECTION_MATRIX") == 0)
-        {
+            break;
+        case WORLD_VIEW_PROJECTION_MATRIX:
             param->bindValue(this, &RenderState::autoBindingGetWorldViewProjectionMatrix);
-        }
-        else if (strcmp(autoBinding, "INVERSE_TRANSPOSE_WORLD_MATRIX") == 0)
-        {
+            break;
+        case INVERSE_TRANSPOSE_WORLD_MATRIX:
             param->bindValue(this, &RenderState::autoBindingGetInverseTransposeWorldMatrix);
-        }
-        else if (strcmp(autoBinding, "INVERSE_TRANSPOSE_WORLD_VIEW_MATRIX") == 0)
-        {
+            break;
+        case INVERSE_TRANSPOSE_WORLD_VIEW_MATRIX:
             param->bindValue(this, &RenderState::autoBindingGetInverseTransposeWorldViewMatrix);
-        }
-        else if (strcmp(autoBinding, "CAMERA_WORLD_POSITION") == 0)
-        {
+            break;
+        case CAMERA_WORLD_POSITION:
             param->bindValue(this, &RenderState::autoBindingGetCameraWorldPosition);
-        }
-        else if (strcmp(autoBinding, "CAMERA_VIEW_POSITION") == 0)
-        {
+            break;
+        case CAMERA_VIEW_POSITION:
             param->bindValue(this, &RenderState::autoBindingGetCameraViewPosition);
-        }
-        else if (strcmp(autoBinding, "MATRIX_PALETTE") == 0)
-        {
+            break;
+        case MATRIX_PALETTE:
             param->bindValue(this, &RenderState::autoBindingGetMatrixPalette, &RenderState::autoBindingGetMatrixPaletteSize);
-        }
-        else if (strcmp(autoBinding, "SCENE_AMBIENT_COLOR") == 0)
-        {
+            break;
+        case SCENE_AMBIENT_COLOR:
             param->bindValue(this, &RenderState::autoBindingGetAmbientColor);
-        }
-        else
-        {
+            break;
+        default:
             bound = false;
             GP_WARN("Unsupported auto binding type (%s).", autoBinding);
+            break;
         }
     }
 
@@ -400,35 +394,96 @@ void RenderState::bind(Pass* pass)
 {
     GP_ASSERT(pass);
 
-    // Get the combined modified state bits for our RenderState hierarchy.
-    long stateOverrideBits = _state ? _state->_bits : 0;
-    RenderState* rs = _parent;
-    while (rs)
+    if (_bindingRevision != __bindingRevision)
     {
-        if (rs->_state)
-        {
-            stateOverrideBits |= rs->_state->_bits;
-        }
-        rs = rs->_parent;
+        updateBindings();
+    }
+
+    // Get the combined modified state bits for our RenderState hierarchy. The bits of a
+    // state block change when its states are set, so they are combined on each bind.
+    long stateOverrideBits = 0;
+    for (size_t i = 0, count = _bindingStates.size(); i < count; ++i)
+    {
+        stateOverrideBits |= _bindingStates[i]->_bits;
     }
 
     // Restore renderer state to its default, except for explicitly specified states
     StateBlock::restore(stateOverrideBits);
 
     // Apply parameter bindings and renderer state for the entire hierarchy, top-down.
-    rs = NULL;
     Effect* effect = pass->getEffect();
+    for (size_t i = 0, count = _bindingParameters.size(); i < count; ++i)
+    {
+        _bindingParameters[i]->bind(effect);
+    }
+    for (size_t i = 0, count = _bindingStates.size(); i < count; ++i)
+    {
+        _bindingStates[i]->bindNoRestore();
+    }
+}
+
+void RenderState::updateBindings()
+{
+    _bindingParameters.clear();
+    _bindingStates.clear();
+
+    RenderState* rs = NULL;
     while ((rs = getTopmost(rs)))
     {
         for (size_t i = 0, count = rs->_parameters.size(); i < count; ++i)
         {
             GP_ASSERT(rs->_parameters[i]);
-            rs->_parameters[i]->bind(effect);
+            _bindingParameters.push_back(rs->_parameters[i]);
         }
 
         if (rs->_state)
         {
-            rs->_state->bindNoRestore();
+            _bindingStates.push_back(rs->_state);
+        }
+    }
+
+    _bindingRevision = __bindingRevision;
+}
+
+void RenderState::invalidateBindings()
+{
+    if (++__bindingRevision == 0)
+    {
+        // 0 is kept for bindings that were never built.
+        __bindingRevision = 1;
+    }
+}
+
+void RenderState::getSortInfo(unsigned int* stateHash, bool* blendEnabled, const Texture** texture) const
+{
+    GP_ASSERT(stateHash);
+    GP_ASSERT(blendEnabled);
+    GP_ASSERT(texture);
+
+    *stateHash = 0;
+    *blendEnabled = false;
+    *texture = NULL;
+
+    // Walk up from this RenderState, the closest one that sets a state wins.
+    bool blendSet = false;
+    for (const RenderState* rs = this; rs; rs = rs->_parent)
+    {
+        if (rs->_state)
+        {
+            *stateHash = (*stateHash * 31) ^ rs->_state->getHash();
+            if (!blendSet && (rs->_state->_bits & RS_BLEND))
+            {
+                *blendEnabled = rs->_state->_blendEnabled;
+                blendSet = true;
+            }
+        }
+
+        for (size_t i = 0, count = rs->_parameters.size(); i < count && *texture == NULL; ++i)
+        {
+            const MaterialParameter* parameter = rs->_parameters[i];
+            GP_ASSERT(parameter);
+            if (parameter->_type == MaterialParameter::SAMPLER && parameter->_value.samplerValue)
+                *texture = parameter->_value.samplerValue->getTexture();
         }
     }
 }
@@ -478,6 +533,7 @@ void RenderState::cloneInto(RenderState* renderState, NodeCloneContext& context)
         param->cloneInto(paramCopy);
 
         renderState->_parameters.push_back(paramCopy);
+        invalidateBindings();
     }
 
     // Clone our state block
@@ -621,8 +677,9 @@ void RenderState::StateBlock::restore(long stateOverrideBits)
 {
     GP_ASSERT(_defaultState);
 
-    // If there is no state to restore (i.e. no non-default state), do nothing.
-    if (_defaultState->_bits == 0)
+    // If there is no state to restore (i.e. no non-default state that is not overridden), do nothing.
+    // This is the case when the override bits match the ones of the previous bind.
+    if ((_defaultState->_bits & ~stateOverrideBits) == 0)
     {
         return;
     }
@@ -722,6 +779,38 @@ void RenderState::StateBlock::enableDepthWrite()
     }
 }
 
+unsigned int RenderState::StateBlock::getHash() const
+{
+    // Only the states that are set take part in the hash, so blocks that override the same
+    // states with the same values hash to the same value.
+    unsigned int hash = (unsigned int)_bits;
+    if (_bits & RS_BLEND)
+        hash = hash * 31 + _blendEnabled;
+    if (_bits & RS_BLEND_FUNC)
+        hash = (hash * 31 + _blendSrc) * 31 + _blendDst;
+    if (_bits & RS_CULL_FACE)
+        hash = hash * 31 + _cullFaceEnabled;
+    if (_bits & RS_CULL_FACE_SIDE)
+        hash = hash * 31 + _cullFaceSide;
+    if (_bits & RS_FRONT_FACE)
+        hash = hash * 31 + _frontFace;
+    if (_bits & RS_DEPTH_TEST)
+        hash = hash * 31 + _depthTestEnabled;
+    if (_bits & RS_DEPTH_WRITE)
+        hash = hash * 31 + _depthWriteEnabled;
+    if (_bits & RS_DEPTH_FUNC)
+        hash = hash * 31 + _depthFunction;
+    if (_bits & RS_STENCIL_TEST)
+        hash = hash * 31 + _stencilTestEnabled;
+    if (_bits & RS_STENCIL_WRITE)
+        hash = hash * 31 + _stencilWrite;
+    if (_bits & RS_STENCIL_FUNC)
+        hash = ((hash * 31 + _stencilFunction) * 31 + _stencilFunctionRef) * 31 + _stencilFunctionMask;
+    if (_bits & RS_STENCIL_OP)
+        hash = ((hash * 31 + _stencilOpSfail) * 31 + _stencilOpDpfail) * 31 + _stencilOpDppass;
+    return hash;
+}
+
 void RenderState::StateBlock::cloneInto(StateBlock* state)
 {
     GP_ASSERT(state);
@@ -12,6 +12,7 @@ class MaterialParameter;
 class Node;
 class NodeCloneContext;
 class Pass;
+class Texture;
 
 /**
  * Defines the rendering state of the graphics device.
@@ -23,6 +24,8 @@ class RenderState : public Ref
     friend class Technique;
     friend class Pass;
     friend class Model;
+    friend class RenderQueue;
+    friend class InstancedModel;
 
 public:
 
@@ -438,6 +441,11 @@ public:
 
         static void restore(long stateOverrideBits);
 
+        /**
+         * Gets a hash of the states that are set in this block.
+         */
+        unsigned int getHash() const;
+
         static void enableDepthWrite();
 
         void cloneInto(StateBlock* state);
@@ -612,6 +620,28 @@ protected:
      */
     RenderState* getTopmost(RenderState* below);
 
+    /**
+     * Rebuilds the flattened parameters and state blocks of this RenderState and its parents.
+     */
+    void updateBindings();
+
+    /**
+     * Invalidates the flattened bindings of all RenderStates.
+     *
+     * Called whenever the parameters or the state block of a RenderState change, which only
+     * happens while materials are set up.
+     */
+    static void invalidateBindings();
+
+    /**
+     * Gets the values used to sort the draw calls made with this RenderState and its parents.
+     *
+     * @param stateHash Set to a hash of the render states set in the hierarchy.
+     * @param blendEnabled Set to true if blending is enabled for the hierarchy.
+     * @param texture Set to the texture of the first sampler parameter in the hierarchy, or NULL.
+     */
+    void getSortInfo(unsigned int* stateHash, bool* blendEnabled, const Texture** texture) const;
+
     /**
      * Copies the data from this RenderState into the given RenderState.
      * 
@@ -676,6 +706,21 @@ protected:
      */
     RenderState* _parent;
 
+    /**
+     * The parameters of the hierarchy in binding order, top-down, used by bind().
+     */
+    std::vector<MaterialParameter*> _bindingParameters;
+
+    /**
+     * The state blocks of the hierarchy in binding order, top-down, used by bind().
+     */
+    std::vector<StateBlock*> _bindingStates;
+
+    /**
+     * The revision of the hierarchies the bindings were built for, 0 if never built.
+     */
+    unsigned int _bindingRevision;
+
     /**
      * Map of custom auto binding resolvers.
      */
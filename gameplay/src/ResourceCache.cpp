@@ -0,0 +1,185 @@
+#include "Base.h"
+#include "ResourceCache.h"
+
+namespace gameplay
+{
+
+/**
+ * A cached resource.
+ */
+struct ResourceCacheEntry
+{
+    ResourceCache::Type type;
+    std::string key;
+    Ref* resource;
+    size_t cpuBytes;
+    size_t gpuBytes;
+    std::list<ResourceCacheEntry*>::iterator lruItr;
+};
+
+// Resources of each type by key.
+static std::unordered_map<std::string, ResourceCacheEntry*> __resources[ResourceCache::TYPE_COUNT];
+// Resources of all types, from the most to the least recently used.
+static std::list<ResourceCacheEntry*> __lru;
+static ResourceCache::Statistics __statistics[ResourceCache::TYPE_COUNT];
+static size_t __bytes = 0;
+static size_t __budget = 0;
+
+/**
+ * Removes an entry from its cache and releases its resource.
+ */
+static void evict(ResourceCacheEntry* entry)
+{
+    GP_ASSERT(entry);
+
+    ResourceCache::Statistics& statistics = __statistics[entry->type];
+    --statistics.count;
+    statistics.cpuBytes -= entry->cpuBytes;
+    statistics.gpuBytes -= entry->gpuBytes;
+    __bytes -= entry->cpuBytes + entry->gpuBytes;
+
+    __resources[entry->type].erase(entry->key);
+    __lru.erase(entry->lruItr);
+
+    // The release can destroy the resource, which can release other cached resources.
+    Ref* resource = entry->resource;
+    SAFE_DELETE(entry);
+    SAFE_RELEASE(resource);
+}
+
+Ref* ResourceCache::find(Type type, const char* key)
+{
+    GP_ASSERT(type < TYPE_COUNT);
+    GP_ASSERT(key);
+
+    std::unordered_map<std::string, ResourceCacheEntry*>::const_iterator itr = __resources[type].find(key);
+    if (itr == __resources[type].end())
+    {
+        ++__statistics[type].misses;
+        return NULL;
+    }
+
+    ResourceCacheEntry* entry = itr->second;
+    __lru.splice(__lru.begin(), __lru, entry->lruItr);
+    ++__statistics[type].hits;
+    entry->resource->addRef();
+    return entry->resource;
+}
+
+void ResourceCache::add(Type type, const char* key, Ref* resource, size_t cpuBytes, size_t gpuBytes)
+{
+    GP_ASSERT(type < TYPE_COUNT);
+    GP_ASSERT(key);
+    GP_ASSERT(resource);
+
+    ResourceCacheEntry*& entry = __resources[type][key];
+    if (entry)
+    {
+        GP_WARN("Resource '%s' is already cached.", key);
+        return;
+    }
+
+    entry = new ResourceCacheEntry();
+    entry->type = type;
+    entry->key = key;
+    entry->resource = resource;
+    entry->cpuBytes = cpuBytes;
+    entry->gpuBytes = gpuBytes;
+    __lru.push_front(entry);
+    entry->lruItr = __lru.begin();
+    resource->addRef();
+
+    Statistics& statistics = __statistics[type];
+    ++statistics.count;
+    statistics.cpuBytes += cpuBytes;
+    statistics.gpuBytes += gpuBytes;
+    __bytes += cpuBytes + gpuBytes;
+
+    // The new resource is referenced by the caller, so it is not evicted.
+    trim();
+}
+
+void ResourceCache::setBudget(size_t bytes)
+{
+    __budget = bytes;
+    trim();
+}
+
+size_t ResourceCache::getBudget()
+{
+    return __budget;
+}
+
+void ResourceCache::trim()
+{
+    // Walk from the least recently used resource, skipping the ones that are still used.
+    // A budget of 0 evicts all the unused resources, including those of unknown size.
+    // Evicted resources can release others walked past, such as the texture of a font,
+    // so the walk is repeated until it evicts nothing.
+    bool evicted = true;
+    while (evicted)
+    {
+        evicted = false;
+        std::list<ResourceCacheEntry*>::iterator itr = __lru.end();
+        while ((__bytes > __budget || __budget == 0) && itr != __lru.begin())
+        {
+            --itr;
+            ResourceCacheEntry* entry = *itr;
+            if (entry->resource->getRefCount() == 1)
+            {
+                ++itr;
+                ++__statistics[entry->type].evictions;
+                evict(entry);
+                evicted = true;
+            }
+        }
+    }
+}
+
+void ResourceCache::clear()
+{
+    while (!__lru.empty())
+    {
+        evict(__lru.back());
+    }
+}
+
+ResourceCache::Statistics ResourceCache::getStatistics(Type type)
+{
+    GP_ASSERT(type < TYPE_COUNT);
+
+    Statistics statistics = __statistics[type];
+    statistics.unused = 0;
+    statistics.unusedBytes = 0;
+    for (std::unordered_map<std::string, ResourceCacheEntry*>::const_iterator itr = __resources[type].begin(); itr != __resources[type].end(); ++itr)
+    {
+        ResourceCacheEntry* entry = itr->second;
+        if (entry->resource->getRefCount() == 1)
+        {
+            ++statistics.unused;
+            statistics.unusedBytes += entry->cpuBytes + entry->gpuBytes;
+        }
+    }
+    return statistics;
+}
+
+ResourceCache::Statistics ResourceCache::getStatistics()
+{
+    Statistics total;
+    memset(&total, 0, sizeof(total));
+    for (unsigned int i = 0; i < TYPE_COUNT; ++i)
+    {
+        Statistics statistics = getStatistics((Type)i);
+        total.count += statistics.count;
+        total.unused += statistics.unused;
+        total.cpuBytes += statistics.cpuBytes;
+        total.gpuBytes += statistics.gpuBytes;
+        total.unusedBytes += statistics.unusedBytes;
+        total.hits += statistics.hits;
+        total.misses += statistics.misses;
+        total.evictions += statistics.evictions;
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,138 @@
+#ifndef RESOURCECACHE_H_
+#define RESOURCECACHE_H_
+
+#include "Ref.h"
+
+namespace gameplay
+{
+
+/**
+ * Defines the caches of the resources loaded from files: textures, effects, fonts and bundles.
+ *
+ * Each cache finds its resources by a key, such as their path, in a hash map and holds a
+ * reference to them. A resource released by all its users stays loaded, so that the next load
+ * of the same file finds it instead of reading it again.
+ *
+ * The memory used by the cached resources is estimated in bytes of CPU and GPU memory. When it
+ * exceeds the budget shared by all the caches, the resources only referenced by the caches are
+ * evicted, least recently used first. Resources that are still used are never evicted, so the
+ * memory can exceed the budget while they are.
+ *
+ * The caches are trimmed to the budget when a resource is added and once per frame. The budget
+ * is set by the "resourceCacheBudget" game config property, in megabytes. It is 0 by default,
+ * which destroys the resources at the end of the frame in which they are last released.
+ *
+ * @script{ignore}
+ */
+class ResourceCache
+{
+public:
+
+    /**
+     * The types of cached resources, each with its own cache.
+     */
+    enum Type
+    {
+        TEXTURE,
+        EFFECT,
+        FONT,
+        BUNDLE,
+        TYPE_COUNT
+    };
+
+    /**
+     * Counters of a cache, or of all the caches.
+     */
+    struct Statistics
+    {
+        /** Number of cached resources. */
+        unsigned int count;
+        /** Number of cached resources only referenced by the cache, which can be evicted. */
+        unsigned int unused;
+        /** Estimated CPU memory used by the cached resources, in bytes. */
+        size_t cpuBytes;
+        /** Estimated GPU memory used by the cached resources, in bytes. */
+        size_t gpuBytes;
+        /** Estimated memory used by the cached resources that can be evicted, in bytes. */
+        size_t unusedBytes;
+        /** Number of lookups that found a cached resource. */
+        unsigned int hits;
+        /** Number of lookups that did not find a cached resource. */
+        unsigned int misses;
+        /** Number of resources evicted to stay within the budget. */
+        unsigned int evictions;
+    };
+
+    /**
+     * Finds a cached resource and marks it as the most recently used.
+     *
+     * @param type The type of the resource.
+     * @param key The key of the resource.
+     *
+     * @return The resource, with a reference added for the caller, or NULL if it is not cached.
+     */
+    static Ref* find(Type type, const char* key);
+
+    /**
+     * Adds a resource to a cache, which holds a reference to it, then trims the caches.
+     *
+     * @param type The type of the resource.
+     * @param key The key of the resource, which must not be cached yet.
+     * @param resource The resource.
+     * @param cpuBytes The estimated CPU memory used by the resource, in bytes.
+     * @param gpuBytes The estimated GPU memory used by the resource, in bytes.
+     */
+    static void add(Type type, const char* key, Ref* resource, size_t cpuBytes, size_t gpuBytes);
+
+    /**
+     * Sets the memory budget of the caches.
+     *
+     * @param bytes The budget, in bytes.
+     */
+    static void setBudget(size_t bytes);
+
+    /**
+     * Gets the memory budget of the caches.
+     *
+     * @return The budget, in bytes.
+     */
+    static size_t getBudget();
+
+    /**
+     * Evicts the least recently used resources that are only referenced by the caches,
+     * until the memory they use is within the budget.
+     */
+    static void trim();
+
+    /**
+     * Releases all the cached resources, destroying those that are not used anymore.
+     */
+    static void clear();
+
+    /**
+     * Gets the counters of a cache.
+     *
+     * @param type The type of the resources of the cache.
+     *
+     * @return The statistics of the cache.
+     */
+    static Statistics getStatistics(Type type);
+
+    /**
+     * Gets the counters of all the caches.
+     *
+     * @return The statistics of the caches.
+     */
+    static Statistics getStatistics();
+
+private:
+
+    /**
+     * Constructor.
+     */
+    ResourceCache();
+};
+
+}
+
+#endif
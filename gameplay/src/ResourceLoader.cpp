@@ -0,0 +1,393 @@
+#include "Base.h"
+#include "ResourceLoader.h"
+#include "Game.h"
+#include "FileSystem.h"
+#include "Properties.h"
+#include "Image.h"
+#include "Texture.h"
+#include "Effect.h"
+#include "ProgramCache.h"
+#include "Scene.h"
+
+namespace gameplay
+{
+
+/**
+ * An image decoded by a request, released with the request.
+ */
+struct LoadedImage
+{
+    LoadedImage() : image(NULL), generateMipmaps(false) {}
+
+    ~LoadedImage()
+    {
+        SAFE_RELEASE(image);
+    }
+
+    std::string path;
+    Image* image;
+    bool generateMipmaps;
+};
+
+/**
+ * The textures of a scene loaded by a request, released with the request once the scene holds them.
+ */
+struct LoadedScene
+{
+    LoadedScene() : next(0) {}
+
+    ~LoadedScene()
+    {
+        for (size_t i = 0, count = images.size(); i < count; ++i)
+        {
+            SAFE_DELETE(images[i]);
+        }
+        for (size_t i = 0, count = textures.size(); i < count; ++i)
+        {
+            SAFE_RELEASE(textures[i]);
+        }
+    }
+
+    std::string url;
+    std::vector<LoadedImage*> images;
+    std::vector<Texture*> textures;
+    size_t next;
+};
+
+/**
+ * Checks whether a path is that of an image that Image::create decodes.
+ */
+static bool isImagePath(const char* path)
+{
+    std::string ext = FileSystem::getExtension(path);
+    return ext == ".PNG" || ext == ".JPG";
+}
+
+/**
+ * Collects the texture samplers of a properties namespace and its children, and the material
+ * files they reference.
+ */
+static void findTextures(Properties* properties, std::set<std::string>& materialFiles, std::map<std::string, bool>& textures)
+{
+    if (strcmp(properties->getNamespace(), "sampler") == 0)
+    {
+        std::string path;
+        if (properties->getPath("path", &path))
+        {
+            bool& generateMipmaps = textures[path];
+            generateMipmaps = generateMipmaps || properties->getBool("mipmap");
+        }
+    }
+
+    const char* name;
+    while ((name = properties->getNextProperty()) != NULL)
+    {
+        if (strncmp(name, "material", 8) == 0)
+        {
+            std::string url = properties->getString();
+            materialFiles.insert(url.substr(0, url.find('#')));
+        }
+    }
+
+    Properties* child;
+    while ((child = properties->getNextNamespace()) != NULL)
+    {
+        findTextures(child, materialFiles, textures);
+    }
+}
+
+ResourceLoader::ResourceLoader(unsigned int threadCount, float frameBudget)
+    : _working(0), _completing(NULL), _frameBudget(frameBudget), _running(true)
+{
+    for (unsigned int i = 0; i < std::max(threadCount, 1u); ++i)
+    {
+        _threads.push_back(new std::thread(&ResourceLoader::threadProc, this));
+    }
+}
+
+ResourceLoader::~ResourceLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _workCondition.notify_all();
+    for (size_t i = 0, count = _threads.size(); i < count; ++i)
+    {
+        _threads[i]->join();
+        SAFE_DELETE(_threads[i]);
+    }
+
+    // Drop the requests that were not completed, releasing what they loaded.
+    for (size_t i = 0, count = _queued.size(); i < count; ++i)
+    {
+        SAFE_DELETE(_queued[i]);
+    }
+    for (size_t i = 0, count = _done.size(); i < count; ++i)
+    {
+        SAFE_DELETE(_done[i]);
+    }
+    SAFE_DELETE(_completing);
+}
+
+void ResourceLoader::load(const WorkFunction& work, const CompleteFunction& complete)
+{
+    Request* request = new Request();
+    request->work = work;
+    request->complete = complete;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queued.push_back(request);
+    }
+    _workCondition.notify_one();
+}
+
+void ResourceLoader::loadImage(const char* path, const std::function<void(Image*)>& callback)
+{
+    GP_ASSERT(path);
+
+    std::shared_ptr<LoadedImage> loaded(new LoadedImage());
+    loaded->path = path;
+
+    load([loaded]()
+    {
+        if (FileSystem::fileExists(loaded->path.c_str()))
+            loaded->image = Image::create(loaded->path.c_str());
+        else
+            GP_WARN("Failed to load image '%s': file not found.", loaded->path.c_str());
+    },
+    [loaded, callback]()
+    {
+        if (callback)
+            callback(loaded->image);
+        return true;
+    });
+}
+
+void ResourceLoader::loadTexture(const char* path, bool generateMipmaps, const std::function<void(Texture*)>& callback)
+{
+    GP_ASSERT(path);
+
+    std::shared_ptr<LoadedImage> loaded(new LoadedImage());
+    loaded->path = path;
+    loaded->generateMipmaps = generateMipmaps;
+
+    load([loaded]()
+    {
+        // Decode images here, compressed textures are read on the main thread.
+        if (isImagePath(loaded->path.c_str()))
+        {
+            if (FileSystem::fileExists(loaded->path.c_str()))
+                loaded->image = Image::create(loaded->path.c_str());
+            else
+                GP_WARN("Failed to load texture '%s': file not found.", loaded->path.c_str());
+        }
+    },
+    [loaded, callback]()
+    {
+        Texture* texture = NULL;
+        if (loaded->image)
+            texture = Texture::create(loaded->path.c_str(), loaded->image, loaded->generateMipmaps);
+        else if (!isImagePath(loaded->path.c_str()))
+            texture = Texture::create(loaded->path.c_str(), loaded->generateMipmaps);
+        if (callback)
+            callback(texture);
+        SAFE_RELEASE(texture);
+        return true;
+    });
+}
+
+void ResourceLoader::loadEffect(const char* vshPath, const char* fshPath, const char* defines, const std::function<void(Effect*)>& callback)
+{
+    GP_ASSERT(vshPath);
+    GP_ASSERT(fshPath);
+
+    std::string vsh = vshPath;
+    std::string fsh = fshPath;
+    std::string defs = defines ? defines : "";
+    bool hasDefines = defines != NULL;
+
+    // The defines are built from the game config, and the program cache checks the driver,
+    // on the main thread.
+    std::shared_ptr<Effect::Source> source(new Effect::Source());
+    Effect::replaceDefines(defines, source->defines);
+    bool cacheEnabled = ProgramCache::isEnabled();
+
+    load([vsh, fsh, source, cacheEnabled]()
+    {
+        // Read and preprocess the shaders, and the binary of their program from the program cache.
+        if (Effect::readSource(vsh.c_str(), fsh.c_str(), source.get()) && cacheEnabled)
+            ProgramCache::read(ProgramCache::getKey(source->defines, source->vsh, source->fsh), &source->binary);
+    },
+    [vsh, fsh, defs, hasDefines, source, callback]()
+    {
+        Effect* effect = Effect::createFromFile(vsh.c_str(), fsh.c_str(), hasDefines ? defs.c_str() : NULL, source.get());
+        if (callback)
+            callback(effect);
+        SAFE_RELEASE(effect);
+        return true;
+    });
+}
+
+void ResourceLoader::loadScene(const char* url, const std::function<void(Scene*)>& callback)
+{
+    GP_ASSERT(url);
+
+    std::shared_ptr<LoadedScene> loaded(new LoadedScene());
+    loaded->url = url;
+
+    load([loaded]()
+    {
+        // Only scene files reference materials, bundles are loaded on the main thread.
+        std::string path = loaded->url.substr(0, loaded->url.find('#'));
+        if (FileSystem::getExtension(path.c_str()) != ".SCENE")
+            return;
+
+        Properties* properties = Properties::create(loaded->url.c_str());
+        if (properties == NULL)
+            return;
+
+        std::set<std::string> materialFiles;
+        std::map<std::string, bool> textures;
+        findTextures(properties, materialFiles, textures);
+        SAFE_DELETE(properties);
+
+        for (std::set<std::string>::const_iterator itr = materialFiles.begin(); itr != materialFiles.end(); ++itr)
+        {
+            properties = Properties::create(itr->c_str());
+            if (properties)
+            {
+                std::set<std::string> unused;
+                findTextures(properties, unused, textures);
+                SAFE_DELETE(properties);
+            }
+        }
+
+        // Decode the images, compressed textures and missing files are left to Scene::load.
+        for (std::map<std::string, bool>::const_iterator itr = textures.begin(); itr != textures.end(); ++itr)
+        {
+            if (!isImagePath(itr->first.c_str()) || !FileSystem::fileExists(itr->first.c_str()))
+                continue;
+
+            Image* image = Image::create(itr->first.c_str());
+            if (image)
+            {
+                LoadedImage* loadedImage = new LoadedImage();
+                loadedImage->path = itr->first;
+                loadedImage->image = image;
+                loadedImage->generateMipmaps = itr->second;
+                loaded->images.push_back(loadedImage);
+            }
+        }
+    },
+    [loaded, callback]()
+    {
+        // Upload one texture per step, releasing its image.
+        if (loaded->next < loaded->images.size())
+        {
+            LoadedImage*& loadedImage = loaded->images[loaded->next++];
+            Texture* texture = Texture::create(loadedImage->path.c_str(), loadedImage->image, loadedImage->generateMipmaps);
+            if (texture)
+                loaded->textures.push_back(texture);
+            SAFE_DELETE(loadedImage);
+            return false;
+        }
+
+        Scene* scene = Scene::load(loaded->url.c_str());
+        if (callback)
+            callback(scene);
+        SAFE_RELEASE(scene);
+        return true;
+    });
+}
+
+unsigned int ResourceLoader::getPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (unsigned int)(_queued.size() + _working + _done.size()) + (_completing ? 1 : 0);
+}
+
+void ResourceLoader::flush()
+{
+    while (true)
+    {
+        Request* request = _completing;
+        if (request == NULL)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _doneCondition.wait(lock, [this]() { return !_done.empty() || (_queued.empty() && _working == 0); });
+            if (_done.empty())
+                break;
+            request = _done.front();
+            _done.pop_front();
+        }
+
+        _completing = request;
+        while (request->complete && !request->complete())
+            ;
+        _completing = NULL;
+        SAFE_DELETE(request);
+    }
+}
+
+void ResourceLoader::setFrameBudget(float milliseconds)
+{
+    _frameBudget = milliseconds;
+}
+
+float ResourceLoader::getFrameBudget() const
+{
+    return _frameBudget;
+}
+
+void ResourceLoader::update()
+{
+    double start = Game::getPlatformTime();
+    do
+    {
+        Request* request = _completing;
+        if (request == NULL)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_done.empty())
+                break;
+            request = _done.front();
+            _done.pop_front();
+        }
+
+        // Make one step of the request, resuming it in the next step if it is not complete.
+        _completing = request;
+        if (!request->complete || request->complete())
+        {
+            _completing = NULL;
+            SAFE_DELETE(request);
+        }
+    }
+    while (Game::getPlatformTime() - start < _frameBudget);
+}
+
+void ResourceLoader::threadProc()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        _workCondition.wait(lock, [this]() { return !_running || !_queued.empty(); });
+        if (!_running)
+            break;
+
+        Request* request = _queued.front();
+        _queued.pop_front();
+        ++_working;
+        lock.unlock();
+
+        if (request->work)
+            request->work();
+
+        lock.lock();
+        --_working;
+        _done.push_back(request);
+        _doneCondition.notify_all();
+    }
+}
+
+}
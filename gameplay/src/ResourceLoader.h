@@ -0,0 +1,198 @@
+#ifndef RESOURCELOADER_H_
+#define RESOURCELOADER_H_
+
+#include <condition_variable>
+#include <deque>
+
+namespace gameplay
+{
+
+class Effect;
+class Image;
+class Scene;
+class Texture;
+
+/**
+ * Defines an asynchronous resource loader, which loads resources in the background while
+ * the game keeps running.
+ *
+ * Each load request is split in two parts. The work that does not use the graphics device,
+ * such as file reads, image decoding and parsing, runs on loader threads. The rest, such as
+ * texture uploads and shader compilation, runs on the main thread in update(), which is
+ * called once per frame by the game and completes requests until its time budget for the
+ * frame is spent. A request that completes in several steps, such as a scene uploading its
+ * textures, is resumed in the following frames when it runs out of budget.
+ *
+ * The loader has its own threads, separate from the job scheduler of the game, because the
+ * scheduler runs the jobs of each frame and waits for them before the frame ends.
+ *
+ * Callbacks are called on the main thread with the loaded resource, or NULL if it could not
+ * be loaded. The resource is released after the callback returns, so the callback must add
+ * a reference to keep it.
+ *
+ * The number of loader threads is set by the "resourceLoaderThreadCount" game config property
+ * (1 by default) and the time budget by the "resourceLoaderFrameBudget" property, in
+ * milliseconds (4 by default).
+ *
+ * @script{ignore}
+ */
+class ResourceLoader
+{
+    friend class Game;
+
+public:
+
+    /**
+     * Function run on a loader thread.
+     */
+    typedef std::function<void()> WorkFunction;
+
+    /**
+     * Function run on the main thread once the work of a request is done, until it returns true.
+     */
+    typedef std::function<bool()> CompleteFunction;
+
+    /**
+     * Destructor. Waits for the requests being worked on and drops the others.
+     */
+    ~ResourceLoader();
+
+    /**
+     * Queues a request made of custom functions.
+     *
+     * @param work The function run on a loader thread, may be empty.
+     * @param complete The function called on the main thread after the work is done, until it
+     *      returns true. Each call is a step that should be short, so that the loader can stop
+     *      after it when the time budget of the frame is spent.
+     */
+    void load(const WorkFunction& work, const CompleteFunction& complete);
+
+    /**
+     * Loads an image.
+     *
+     * @param path The path of the image.
+     * @param callback The function called with the loaded image.
+     */
+    void loadImage(const char* path, const std::function<void(Image*)>& callback);
+
+    /**
+     * Loads a texture, which is then cached as Texture::create(path) would.
+     *
+     * PNG and JPEG images are decoded on a loader thread. Compressed textures are
+     * loaded on the main thread.
+     *
+     * @param path The path of the texture.
+     * @param generateMipmaps true to generate a full mipmap chain, false otherwise.
+     * @param callback The function called with the loaded texture.
+     */
+    void loadTexture(const char* path, bool generateMipmaps, const std::function<void(Texture*)>& callback);
+
+    /**
+     * Loads an effect, which is then cached as Effect::createFromFile would.
+     *
+     * The shaders are read and preprocessed on a loader thread, which also reads the binary
+     * of their program when the program cache holds it. The program is then loaded from the
+     * binary, or compiled, on the main thread.
+     *
+     * @param vshPath The path of the vertex shader.
+     * @param fshPath The path of the fragment shader.
+     * @param defines The preprocessor definitions, may be NULL.
+     * @param callback The function called with the loaded effect.
+     */
+    void loadEffect(const char* vshPath, const char* fshPath, const char* defines, const std::function<void(Effect*)>& callback);
+
+    /**
+     * Loads a scene.
+     *
+     * The scene file and the material files it references are parsed on a loader thread,
+     * which decodes the images of the texture samplers of the materials. The textures are
+     * uploaded one per step on the main thread, then the scene is loaded with Scene::load,
+     * finding its textures loaded.
+     *
+     * @param url The URL of the scene, as given to Scene::load.
+     * @param callback The function called with the loaded scene.
+     */
+    void loadScene(const char* url, const std::function<void(Scene*)>& callback);
+
+    /**
+     * Gets the number of requests that are not complete.
+     *
+     * @return The number of requests.
+     */
+    unsigned int getPendingCount() const;
+
+    /**
+     * Completes all the requests, blocking until they are done.
+     */
+    void flush();
+
+    /**
+     * Sets the time the main thread spends completing requests in each frame.
+     *
+     * At least one step is made in each frame, whatever the budget.
+     *
+     * @param milliseconds The time budget, in milliseconds.
+     */
+    void setFrameBudget(float milliseconds);
+
+    /**
+     * Gets the time the main thread spends completing requests in each frame.
+     *
+     * @return The time budget, in milliseconds.
+     */
+    float getFrameBudget() const;
+
+private:
+
+    /**
+     * A queued request.
+     */
+    struct Request
+    {
+        WorkFunction work;
+        CompleteFunction complete;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param threadCount The number of loader threads to start, at least one.
+     * @param frameBudget The time budget of each frame, in milliseconds.
+     */
+    ResourceLoader(unsigned int threadCount, float frameBudget);
+
+    /**
+     * Hidden copy constructor.
+     */
+    ResourceLoader(const ResourceLoader& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    ResourceLoader& operator=(const ResourceLoader&);
+
+    /**
+     * Completes requests on the main thread until the time budget of the frame is spent.
+     */
+    void update();
+
+    /**
+     * Loader thread entry point.
+     */
+    void threadProc();
+
+    std::vector<std::thread*> _threads;
+    mutable std::mutex _mutex;
+    std::condition_variable _workCondition;     // Signaled when requests are queued or the loader stops.
+    std::condition_variable _doneCondition;     // Signaled when the work of a request is done.
+    std::deque<Request*> _queued;               // Requests waiting for a loader thread.
+    std::deque<Request*> _done;                 // Requests whose work is done, in the order it was done.
+    unsigned int _working;                      // Requests being worked on.
+    Request* _completing;                       // Request resumed in the next step, owned by the main thread.
+    float _frameBudget;
+    bool _running;
+};
+
+}
+
+#endif
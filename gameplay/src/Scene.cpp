@@ -6,6 +6,7 @@
 #include "Joint.h"
 #include "Terrain.h"
 #include "Bundle.h"
+#include "OcclusionCuller.h"
 
 namespace gameplay
 {
@@ -61,7 +62,8 @@ static bool endsWith(const char* str, const char* suffix, bool ignoreCase)
 
 Scene::Scene()
     : _id(""), _activeCamera(NULL), _firstNode(NULL), _lastNode(NULL), _nodeCount(0), _bindAudioListenerToCamera(true), 
-      _nextItr(NULL), _nextReset(true), _ambientColor( 0.0f, 0.0f, 0.0f )
+      _nextItr(NULL), _nextReset(true), _ambientColor( 0.0f, 0.0f, 0.0f ), _nodeOrderDirty(true),
+      _drawableTree(NULL)
 {
     __sceneList.push_back(this);
 }
@@ -82,6 +84,7 @@ Scene::~Scene()
 
     // Remove all nodes from the scene
     removeAllNodes();
+    SAFE_DELETE(_drawableTree);
 
     // Remove the scene from global list
     std::vector<Scene*>::iterator itr = std::find(__sceneList.begin(), __sceneList.end(), this);
@@ -270,8 +273,11 @@ void Scene::addNode(Node* node)
     }
 
     node->_scene = this;
+    if (_drawableTree)
+        insertDrawables(node);
 
     ++_nodeCount;
+    _nodeOrderDirty = true;
 
     // If we don't have an active camera set, then check for one and set it.
     if (_activeCamera == NULL)
@@ -306,6 +312,7 @@ void Scene::removeNode(Node* node)
     SAFE_RELEASE(node);
 
     --_nodeCount;
+    _nodeOrderDirty = true;
 }
 
 void Scene::removeAllNodes()
@@ -388,6 +395,8 @@ void Scene::setAmbientColor(float red, float green, float blue)
 
 void Scene::update(float elapsedTime)
 {
+    updateWorldMatrices();
+
     for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
     {
         if (node->isEnabled())
@@ -395,6 +404,101 @@ void Scene::update(float elapsedTime)
     }
 }
 
+void Scene::updateWorldMatrices()
+{
+    if (_nodeOrderDirty)
+        updateNodeOrder();
+
+    // Parents precede their children in the list, so each node can resolve its
+    // world matrix from the already resolved world matrix of its parent.
+    for (size_t i = 0, count = _nodeOrder.size(); i < count; i++)
+    {
+        _nodeOrder[i]->updateWorldMatrix();
+    }
+}
+
+void Scene::updateNodeOrder()
+{
+    _nodeOrder.clear();
+    for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
+    {
+        _nodeOrder.push_back(node);
+    }
+    for (size_t i = 0; i < _nodeOrder.size(); i++)
+    {
+        for (Node* child = _nodeOrder[i]->_firstChild; child != NULL; child = child->_nextSibling)
+        {
+            _nodeOrder.push_back(child);
+        }
+    }
+    _nodeOrderDirty = false;
+}
+
+unsigned int Scene::findVisibleDrawables(const Frustum& frustum, std::vector<Drawable*>& drawables, const OcclusionCuller* occlusionCuller)
+{
+    updateDrawableTree();
+
+    unsigned int count = 0;
+    _drawableTreeResults.clear();
+    _drawableTree->query(frustum, _drawableTreeResults);
+    for (size_t i = 0, size = _drawableTreeResults.size(); i < size; i++)
+    {
+        Node* node = static_cast<Node*>(_drawableTreeResults[i]);
+        if (node->isEnabledInHierarchy() && (occlusionCuller == NULL || occlusionCuller->isVisible(node)))
+        {
+            drawables.push_back(node->_drawable);
+            ++count;
+        }
+    }
+    return count;
+}
+
+void Scene::insertDrawables(Node* node)
+{
+    if (node->_drawable)
+        node->queueCullingUpdate();
+
+    for (Node* child = node->_firstChild; child != NULL; child = child->_nextSibling)
+    {
+        insertDrawables(child);
+    }
+}
+
+void Scene::removeDrawables(Node* node)
+{
+    GP_ASSERT(_drawableTree);
+
+    if (node->removeCullingProxy(_drawableTree))
+    {
+        std::vector<Node*>::iterator itr = std::find(_drawableTreeUpdates.begin(), _drawableTreeUpdates.end(), node);
+        if (itr != _drawableTreeUpdates.end())
+            _drawableTreeUpdates.erase(itr);
+    }
+
+    for (Node* child = node->_firstChild; child != NULL; child = child->_nextSibling)
+    {
+        removeDrawables(child);
+    }
+}
+
+void Scene::updateDrawableTree()
+{
+    if (_drawableTree == NULL)
+    {
+        _drawableTree = new BoundingVolumeHierarchy();
+        for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
+        {
+            insertDrawables(node);
+        }
+    }
+
+    for (size_t i = 0, count = _drawableTreeUpdates.size(); i < count; i++)
+    {
+        _drawableTreeUpdates[i]->updateCullingProxy(_drawableTree);
+    }
+    _drawableTreeUpdates.clear();
+}
+
 void Scene::reset()
 {
     _nextItr = NULL;
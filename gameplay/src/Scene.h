@@ -6,10 +6,13 @@
 #include "ScriptController.h"
 #include "Light.h"
 #include "Model.h"
+#include "BoundingVolumeHierarchy.h"
 
 namespace gameplay
 {
 
+class OcclusionCuller;
+
 /**
  * Defines the root container for a hierarchy of Node objects.
  *
@@ -17,6 +20,8 @@ namespace gameplay
  */
 class Scene : public Ref
 {
+    friend class Node;
+
 public:
 
     /**
@@ -188,6 +193,19 @@ public:
      */
     void update(float elapsedTime);
 
+    /**
+     * Resolves the world matrices of all the dirty nodes in the scene.
+     *
+     * The nodes are kept in a flat, breadth-first ordered list so that parent nodes are
+     * always resolved before their children, and the whole scene is updated in a single
+     * linear pass instead of recursing through the node hierarchy. Node::getWorldMatrix()
+     * still resolves world matrices on demand, this pass only avoids the recursion.
+     *
+     * This method is called by update(float). Scenes that are not updated through
+     * update(float) can call it once per frame before they are drawn.
+     */
+    void updateWorldMatrices();
+
     /**
      * Visits each node in the scene and calls the specified method pointer.
      *
@@ -246,6 +264,26 @@ public:
      */
     inline void visit(const char* visitMethod);
 
+    /**
+     * Finds the drawables of the enabled nodes in the scene whose bounding sphere intersects a frustum.
+     *
+     * The drawables are kept in a bounding volume hierarchy, so the cost of a query grows with the
+     * number of visible drawables rather than with the number of nodes in the scene. The hierarchy is
+     * built by the first call and then updated incrementally, for the nodes that moved or changed their
+     * drawable since the previous call.
+     *
+     * If an occlusion culler is given, the drawables in the frustum are also tested against the
+     * occluders it last rendered, and the hidden ones are left out.
+     *
+     * @param frustum The frustum to test, usually the frustum of the active camera.
+     * @param drawables The vector the visible drawables are appended to.
+     * @param occlusionCuller An optional occlusion culler, rendered for the same camera.
+     *
+     * @return The number of visible drawables found.
+     * @script{ignore}
+     */
+    unsigned int findVisibleDrawables(const Frustum& frustum, std::vector<Drawable*>& drawables, const OcclusionCuller* occlusionCuller = NULL);
+
     /**
      * @see VisibleSet#getNext
      */
@@ -299,6 +337,26 @@ private:
 
     bool isNodeVisible(Node* node);
 
+    /**
+     * Rebuilds the breadth-first ordered node list used by updateWorldMatrices().
+     */
+    void updateNodeOrder();
+
+    /**
+     * Queues the drawables of a node and its children for insertion in the drawable tree.
+     */
+    void insertDrawables(Node* node);
+
+    /**
+     * Removes the drawables of a node and its children from the drawable tree.
+     */
+    void removeDrawables(Node* node);
+
+    /**
+     * Creates the drawable tree on first use and applies the queued updates to it.
+     */
+    void updateDrawableTree();
+
     std::string _id;
     Camera* _activeCamera;
     Node* _firstNode;
@@ -308,6 +366,11 @@ private:
     bool _bindAudioListenerToCamera;
     Node* _nextItr;
     bool _nextReset;
+    std::vector<Node*> _nodeOrder;
+    bool _nodeOrderDirty;
+    BoundingVolumeHierarchy* _drawableTree;
+    std::vector<Node*> _drawableTreeUpdates;
+    std::vector<void*> _drawableTreeResults;
 };
 
 template <class T>
@@ -0,0 +1,367 @@
+#include "Base.h"
+#include "SoftwareSkin.h"
+#include "Mesh.h"
+#include "Bundle.h"
+#include "Game.h"
+
+// Default number of skinned results cached per mesh.
+#define SOFTWARE_SKIN_CACHE_SIZE 8
+
+// Number of vertices skinned by a single job.
+#define SOFTWARE_SKIN_VERTICES_PER_JOB 2048
+
+namespace gameplay
+{
+
+// Software skins of the meshes.
+static std::map<Mesh*, SoftwareSkin*> __softwareSkins;
+// Current batch of prepare() calls, entries are never in batch 0.
+static unsigned int __prepareBatch = 1;
+
+SoftwareSkin::SoftwareSkin(Mesh* mesh)
+    : _mesh(mesh), _vertexCount(0), _vertexSize(0), _vertexData(NULL), _positionOffset(-1),
+      _blendWeightsOffset(-1), _blendIndicesOffset(-1), _influenceCount(0), _cacheSize(SOFTWARE_SKIN_CACHE_SIZE),
+      _useCount(0), _uploaded(NULL), _uploadedGeneration(0)
+{
+    GP_ASSERT(mesh);
+    mesh->addRef();
+}
+
+SoftwareSkin::~SoftwareSkin()
+{
+    __softwareSkins.erase(_mesh);
+
+    for (size_t i = 0, count = _entries.size(); i < count; ++i)
+    {
+        SAFE_DELETE_ARRAY(_entries[i]->vertexData);
+        SAFE_DELETE(_entries[i]);
+    }
+    SAFE_DELETE_ARRAY(_vertexData);
+    SAFE_RELEASE(_mesh);
+}
+
+SoftwareSkin* SoftwareSkin::create(Mesh* mesh, const void* vertexData)
+{
+    GP_ASSERT(mesh);
+
+    std::map<Mesh*, SoftwareSkin*>::const_iterator itr = __softwareSkins.find(mesh);
+    if (itr != __softwareSkins.end())
+    {
+        itr->second->addRef();
+        return itr->second;
+    }
+
+    const VertexFormat& vertexFormat = mesh->getVertexFormat();
+    const unsigned int vertexCount = mesh->getVertexCount();
+    const unsigned int vertexSize = vertexFormat.getVertexSize();
+
+    unsigned char* data = new unsigned char[vertexCount * vertexSize];
+    if (vertexData)
+    {
+        memcpy(data, vertexData, vertexCount * vertexSize);
+    }
+    else
+    {
+        // Read the bind pose back from the bundle, the vertex buffer of the mesh is write only.
+        Bundle::MeshData* meshData = mesh->getUrl() && strlen(mesh->getUrl()) > 0 ? Bundle::readMeshData(mesh->getUrl()) : NULL;
+        if (meshData == NULL || meshData->vertexCount != vertexCount || meshData->vertexFormat.getVertexSize() != vertexSize)
+        {
+            GP_ERROR("Failed to load the bind pose vertices of mesh '%s'.", mesh->getUrl());
+            SAFE_DELETE(meshData);
+            SAFE_DELETE_ARRAY(data);
+            return NULL;
+        }
+        memcpy(data, meshData->vertexData, vertexCount * vertexSize);
+        SAFE_DELETE(meshData);
+    }
+
+    SoftwareSkin* skin = new SoftwareSkin(mesh);
+    skin->_vertexCount = vertexCount;
+    skin->_vertexSize = vertexSize;
+    skin->_vertexData = data;
+
+    unsigned int offset = 0;
+    for (unsigned int i = 0, count = vertexFormat.getElementCount(); i < count; ++i)
+    {
+        const VertexFormat::Element& element = vertexFormat.getElement(i);
+        switch (element.usage)
+        {
+        case VertexFormat::POSITION:
+            if (element.size >= 3)
+                skin->_positionOffset = offset;
+            break;
+        case VertexFormat::NORMAL:
+        case VertexFormat::TANGENT:
+        case VertexFormat::BINORMAL:
+            if (element.size >= 3)
+                skin->_directionOffsets.push_back(offset);
+            break;
+        case VertexFormat::BLENDWEIGHTS:
+            skin->_blendWeightsOffset = offset;
+            skin->_influenceCount = element.size;
+            break;
+        case VertexFormat::BLENDINDICES:
+            skin->_blendIndicesOffset = offset;
+            skin->_influenceCount = std::min(skin->_influenceCount ? skin->_influenceCount : element.size, element.size);
+            break;
+        default:
+            break;
+        }
+        offset += element.size;
+    }
+
+    if (skin->_blendWeightsOffset < 0 || skin->_blendIndicesOffset < 0)
+    {
+        GP_ERROR("Mesh '%s' has no blend weights or blend indices.", mesh->getUrl());
+        SAFE_DELETE(skin);
+        return NULL;
+    }
+
+    // The vertex buffer is rewritten each time a different result is drawn, so its storage
+    // is created again with the dynamic usage hint.
+    mesh->_dynamic = true;
+    mesh->setVertexData(data, 0, 0);
+
+    __softwareSkins[mesh] = skin;
+    return skin;
+}
+
+Mesh* SoftwareSkin::getMesh() const
+{
+    return _mesh;
+}
+
+void SoftwareSkin::setCacheSize(unsigned int size)
+{
+    _cacheSize = std::max(size, 1u);
+
+    std::lock_guard<std::mutex> lock(_entriesMutex);
+    for (size_t i = _entries.size(); i > 0 && _entries.size() > _cacheSize; --i)
+    {
+        if (isEvictable(_entries[i - 1]))
+            deleteEntry(i - 1);
+    }
+}
+
+unsigned int SoftwareSkin::getCacheSize() const
+{
+    return _cacheSize;
+}
+
+void SoftwareSkin::beginPrepare()
+{
+    ++__prepareBatch;
+}
+
+void SoftwareSkin::prepare(const Vector4* matrixPalette, unsigned int matrixPaletteSize)
+{
+    acquire(matrixPalette, matrixPaletteSize, true);
+}
+
+void SoftwareSkin::bind(const Vector4* matrixPalette, unsigned int matrixPaletteSize)
+{
+    const Entry* entry = acquire(matrixPalette, matrixPaletteSize, false);
+    if (entry != _uploaded || entry->generation != _uploadedGeneration)
+    {
+        _mesh->setVertexData(entry->vertexData, 0, 0);
+        _uploaded = entry;
+        _uploadedGeneration = entry->generation;
+    }
+}
+
+SoftwareSkin::Entry* SoftwareSkin::acquire(const Vector4* matrixPalette, unsigned int matrixPaletteSize, bool prepared)
+{
+    GP_ASSERT(matrixPalette);
+
+    // FNV-1a over the palette bytes.
+    unsigned int hash = 2166136261u;
+    const unsigned char* bytes = (const unsigned char*)matrixPalette;
+    for (size_t i = 0, count = matrixPaletteSize * sizeof(Vector4); i < count; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+
+    std::unique_lock<std::mutex> lock(_entriesMutex);
+    ++_useCount;
+
+    Entry* entry = NULL;
+    Entry* leastUsed = NULL;
+    for (size_t i = 0, count = _entries.size(); i < count; ++i)
+    {
+        Entry* e = _entries[i];
+        if (e->hash == hash && e->matrixPalette.size() == matrixPaletteSize &&
+            memcmp(&e->matrixPalette[0], matrixPalette, matrixPaletteSize * sizeof(Vector4)) == 0)
+        {
+            entry = e;
+            break;
+        }
+        if (isEvictable(e) && (leastUsed == NULL || e->lastUsed < leastUsed->lastUsed))
+            leastUsed = e;
+    }
+
+    if (entry)
+    {
+        entry->lastUsed = _useCount;
+        if (prepared)
+            entry->preparedBatch = __prepareBatch;
+        lock.unlock();
+
+        // Another thread may still be skinning the same palette.
+        while (!entry->ready.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+        return entry;
+    }
+
+    // Entries that are being skinned or that were prepared for the current batch are never
+    // evicted, the cache grows past its size until they are done or the next batch starts.
+    if (_entries.size() < _cacheSize || leastUsed == NULL)
+    {
+        entry = new Entry();
+        entry->vertexData = new unsigned char[_vertexCount * _vertexSize];
+        memcpy(entry->vertexData, _vertexData, _vertexCount * _vertexSize);
+        entry->generation = 0;
+        _entries.push_back(entry);
+    }
+    else
+    {
+        entry = leastUsed;
+    }
+    entry->hash = hash;
+    entry->matrixPalette.assign(matrixPalette, matrixPalette + matrixPaletteSize);
+    entry->generation++;
+    entry->lastUsed = _useCount;
+    entry->preparedBatch = prepared ? __prepareBatch : 0;
+    entry->ready = false;
+
+    // Shrink the cache back to its size once the entries it grew for can be evicted.
+    for (size_t i = _entries.size(); i > 0 && _entries.size() > _cacheSize; --i)
+    {
+        if (isEvictable(_entries[i - 1]))
+            deleteEntry(i - 1);
+    }
+
+    // Skin outside of the lock so that other palettes are not held up. prepare() runs in the
+    // jobs of a batch, which must not wait for nested jobs: a thread waiting for them could run
+    // the job of another model waiting for this entry, which only this call can make ready.
+    lock.unlock();
+    JobScheduler* scheduler = prepared ? NULL : Game::getInstance()->getJobScheduler();
+    if (scheduler)
+    {
+        scheduler->parallelFor(_vertexCount, [this, entry](unsigned int begin, unsigned int end)
+        {
+            skin(&entry->matrixPalette[0], entry->vertexData, begin, end);
+        }, SOFTWARE_SKIN_VERTICES_PER_JOB);
+    }
+    else
+    {
+        skin(&entry->matrixPalette[0], entry->vertexData, 0, _vertexCount);
+    }
+    entry->ready.store(true, std::memory_order_release);
+    return entry;
+}
+
+bool SoftwareSkin::isEvictable(const Entry* entry) const
+{
+    return entry->ready && entry->preparedBatch != __prepareBatch;
+}
+
+void SoftwareSkin::deleteEntry(size_t index)
+{
+    Entry* entry = _entries[index];
+    GP_ASSERT(isEvictable(entry));
+    if (entry == _uploaded)
+        _uploaded = NULL;
+    SAFE_DELETE_ARRAY(entry->vertexData);
+    SAFE_DELETE(entry);
+    _entries.erase(_entries.begin() + index);
+}
+
+void SoftwareSkin::skin(const Vector4* matrixPalette, unsigned char* vertexData, unsigned int begin, unsigned int end) const
+{
+    const unsigned int stride = _vertexSize / sizeof(float);
+    const unsigned int directionCount = (unsigned int)_directionOffsets.size();
+    const float* src = (const float*)_vertexData + begin * stride;
+    float* dst = (float*)vertexData + begin * stride;
+
+    for (unsigned int i = begin; i < end; ++i, src += stride, dst += stride)
+    {
+        const float* weights = src + _blendWeightsOffset;
+        const float* indices = src + _blendIndicesOffset;
+
+#ifdef GP_SIMD_SSE
+        // Blend the palette rows of the influencing joints.
+        __m128 row0 = _mm_setzero_ps();
+        __m128 row1 = _mm_setzero_ps();
+        __m128 row2 = _mm_setzero_ps();
+        for (unsigned int j = 0; j < _influenceCount; ++j)
+        {
+            const float* rows = &matrixPalette[(unsigned int)indices[j] * 3].x;
+            const __m128 w = _mm_set1_ps(weights[j]);
+            row0 = _mm_add_ps(row0, _mm_mul_ps(w, _mm_loadu_ps(rows)));
+            row1 = _mm_add_ps(row1, _mm_mul_ps(w, _mm_loadu_ps(rows + 4)));
+            row2 = _mm_add_ps(row2, _mm_mul_ps(w, _mm_loadu_ps(rows + 8)));
+        }
+
+        float result[4];
+        if (_positionOffset >= 0)
+        {
+            const float* p = src + _positionOffset;
+            const __m128 v = _mm_set_ps(1.0f, p[2], p[1], p[0]);
+            __m128 x = _mm_mul_ps(row0, v);
+            __m128 y = _mm_mul_ps(row1, v);
+            __m128 z = _mm_mul_ps(row2, v);
+            __m128 w = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            _mm_storeu_ps(result, _mm_add_ps(_mm_add_ps(x, y), _mm_add_ps(z, w)));
+            memcpy(dst + _positionOffset, result, 3 * sizeof(float));
+        }
+        for (unsigned int k = 0; k < directionCount; ++k)
+        {
+            const float* d = src + _directionOffsets[k];
+            const __m128 v = _mm_set_ps(0.0f, d[2], d[1], d[0]);
+            __m128 x = _mm_mul_ps(row0, v);
+            __m128 y = _mm_mul_ps(row1, v);
+            __m128 z = _mm_mul_ps(row2, v);
+            __m128 w = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            _mm_storeu_ps(result, _mm_add_ps(_mm_add_ps(x, y), _mm_add_ps(z, w)));
+            memcpy(dst + _directionOffsets[k], result, 3 * sizeof(float));
+        }
+#else
+        // Blend the palette rows of the influencing joints.
+        float rows[12] = { 0.0f };
+        for (unsigned int j = 0; j < _influenceCount; ++j)
+        {
+            const float* joint = &matrixPalette[(unsigned int)indices[j] * 3].x;
+            const float w = weights[j];
+            for (unsigned int r = 0; r < 12; ++r)
+            {
+                rows[r] += w * joint[r];
+            }
+        }
+
+        if (_positionOffset >= 0)
+        {
+            const float* p = src + _positionOffset;
+            float* out = dst + _positionOffset;
+            for (unsigned int r = 0; r < 3; ++r)
+            {
+                out[r] = rows[r * 4] * p[0] + rows[r * 4 + 1] * p[1] + rows[r * 4 + 2] * p[2] + rows[r * 4 + 3];
+            }
+        }
+        for (unsigned int k = 0; k < directionCount; ++k)
+        {
+            const float* d = src + _directionOffsets[k];
+            float* out = dst + _directionOffsets[k];
+            for (unsigned int r = 0; r < 3; ++r)
+            {
+                out[r] = rows[r * 4] * d[0] + rows[r * 4 + 1] * d[1] + rows[r * 4 + 2] * d[2];
+            }
+        }
+#endif
+    }
+}
+
+}
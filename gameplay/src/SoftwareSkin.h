@@ -0,0 +1,178 @@
+#ifndef SOFTWARESKIN_H_
+#define SOFTWARESKIN_H_
+
+#include "Ref.h"
+#include "Vector4.h"
+
+namespace gameplay
+{
+
+class Mesh;
+
+/**
+ * Defines the CPU skinning state of a skinned Mesh.
+ *
+ * The bind pose vertices of the mesh are skinned on the CPU with the matrix palette of
+ * a MeshSkin and streamed to the vertex buffer of the mesh, which is made dynamic. This
+ * removes the limit the uniform count puts on the number of joints and moves the
+ * skinning cost off the GPU. The materials of models drawn this way must not use the
+ * SKINNING shader define.
+ *
+ * A software skin is shared by all the models of a mesh. It keeps the last skinned
+ * results in a cache keyed by the matrix palette, so models that play the same animation
+ * frame are skinned once and the vertex buffer is only updated when the result changes
+ * between two draws.
+ *
+ * Positions, normals, tangents and binormals are skinned, any other vertex attribute is
+ * copied from the bind pose.
+ *
+ * @script{ignore}
+ */
+class SoftwareSkin : public Ref
+{
+public:
+
+    /**
+     * Gets the software skin of a mesh, creating it on the first call.
+     *
+     * The bind pose vertices are read back from the bundle the mesh was loaded from,
+     * or copied from vertexData if it is not NULL.
+     *
+     * @param mesh The skinned mesh.
+     * @param vertexData Optional bind pose vertices, in the vertex format of the mesh.
+     *
+     * @return The software skin, or NULL if the bind pose could not be loaded.
+     */
+    static SoftwareSkin* create(Mesh* mesh, const void* vertexData = NULL);
+
+    /**
+     * Gets the mesh that is skinned.
+     *
+     * @return The mesh.
+     */
+    Mesh* getMesh() const;
+
+    /**
+     * Sets the number of skinned results kept in the cache.
+     *
+     * Each result takes the size of the vertex buffer of the mesh.
+     *
+     * @param size The number of cached results, at least one.
+     */
+    void setCacheSize(unsigned int size);
+
+    /**
+     * Gets the number of skinned results kept in the cache.
+     *
+     * @return The number of cached results.
+     */
+    unsigned int getCacheSize() const;
+
+    /**
+     * Starts a new batch of prepare() calls on all the software skins.
+     *
+     * The results prepared in a batch are kept in the cache until the next batch starts,
+     * even past the cache size, so that binding them does not skin them again.
+     */
+    static void beginPrepare();
+
+    /**
+     * Skins the bind pose with a matrix palette, unless the result is already cached.
+     *
+     * This method can be called from several threads at once to skin a batch of models
+     * before they are drawn. The vertices are skinned on the calling thread.
+     *
+     * @param matrixPalette The matrix palette, three rows per joint.
+     * @param matrixPaletteSize The number of rows in the matrix palette.
+     */
+    void prepare(const Vector4* matrixPalette, unsigned int matrixPaletteSize);
+
+    /**
+     * Skins the bind pose with a matrix palette and uploads the result to the vertex buffer
+     * of the mesh, unless it is already there. Must be called on the rendering thread.
+     *
+     * @param matrixPalette The matrix palette, three rows per joint.
+     * @param matrixPaletteSize The number of rows in the matrix palette.
+     */
+    void bind(const Vector4* matrixPalette, unsigned int matrixPaletteSize);
+
+private:
+
+    /**
+     * A skinned result.
+     */
+    struct Entry
+    {
+        unsigned int hash;
+        std::vector<Vector4> matrixPalette;
+        unsigned char* vertexData;
+        unsigned int generation;        // Incremented each time the vertices are skinned again.
+        unsigned int lastUsed;
+        unsigned int preparedBatch;     // Batch of prepare() calls that last used the entry.
+        std::atomic<bool> ready;
+    };
+
+    /**
+     * Constructor.
+     */
+    SoftwareSkin(Mesh* mesh);
+
+    /**
+     * Destructor.
+     */
+    ~SoftwareSkin();
+
+    /**
+     * Hidden copy constructor.
+     */
+    SoftwareSkin(const SoftwareSkin& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    SoftwareSkin& operator=(const SoftwareSkin&);
+
+    /**
+     * Finds the cached result of a palette, skinning it into the least recently used entry if needed.
+     *
+     * @param prepared true when called from prepare(), to keep the entry until the next batch.
+     *      The vertices are then skinned on the calling thread, which may be a job of the
+     *      scheduler, otherwise they are skinned by jobs.
+     */
+    Entry* acquire(const Vector4* matrixPalette, unsigned int matrixPaletteSize, bool prepared);
+
+    /**
+     * Checks whether an entry can be reused for another palette.
+     */
+    bool isEvictable(const Entry* entry) const;
+
+    /**
+     * Deletes an entry, which must be evictable.
+     */
+    void deleteEntry(size_t index);
+
+    /**
+     * Skins the range [begin, end) of vertices into an entry.
+     */
+    void skin(const Vector4* matrixPalette, unsigned char* vertexData, unsigned int begin, unsigned int end) const;
+
+    Mesh* _mesh;
+    unsigned int _vertexCount;
+    unsigned int _vertexSize;
+    unsigned char* _vertexData;                 // Bind pose vertices.
+    int _positionOffset;                        // Offsets of the attributes in a vertex, in floats, -1 if missing.
+    std::vector<int> _directionOffsets;         // Normal, tangent and binormal offsets.
+    int _blendWeightsOffset;
+    int _blendIndicesOffset;
+    unsigned int _influenceCount;
+    std::vector<Entry*> _entries;
+    unsigned int _cacheSize;
+    unsigned int _useCount;
+    std::mutex _entriesMutex;
+    const Entry* _uploaded;                     // The entry in the vertex buffer of the mesh.
+    unsigned int _uploadedGeneration;
+};
+
+}
+
+#endif
@@ -19,6 +19,9 @@
 // Factor to grow a sprite batch by when its size is exceeded
 #define SPRITE_BATCH_GROW_FACTOR 2.0f
 
+// Maximum size a sprite batch grows to, beyond which it is drawn in several parts
+#define SPRITE_BATCH_MAX_SIZE 4096
+
 // Macro for adding a sprite to the batch
 #define SPRITE_ADD_VERTEX(vtx, vx, vy, vz, vu, vv, vr, vg, vb, va) \
     vtx.x = vx; vtx.y = vy; vtx.z = vz; \
@@ -130,8 +133,8 @@ SpriteBatch* SpriteBatch::create(Texture* texture,  Effect* effect, unsigned int
     };
     VertexFormat vertexFormat(vertexElements, 3);
 
-    // Create the mesh batch
-    MeshBatch* meshBatch = MeshBatch::create(vertexFormat, Mesh::TRIANGLES, material, false, initialCapacity > 0 ? initialCapacity : SPRITE_BATCH_DEFAULT_SIZE);
+    // Create the mesh batch, with a fixed budget so its vertices are written directly to the vertex buffer
+    MeshBatch* meshBatch = MeshBatch::create(vertexFormat, Mesh::TRIANGLES, material, false, initialCapacity > 0 ? initialCapacity : SPRITE_BATCH_DEFAULT_SIZE, 0);
     material->release(); // don't call SAFE_RELEASE since material is used below
 
     // Create the batch
@@ -165,8 +168,8 @@ SpriteBatch* SpriteBatch::create(Material* material, unsigned int initialCapacit
     };
     VertexFormat vertexFormat(vertexElements, 3);
 
-    // Create the mesh batch
-    MeshBatch* meshBatch = MeshBatch::create(vertexFormat, Mesh::TRIANGLES, material, false, initialCapacity > 0 ? initialCapacity : SPRITE_BATCH_DEFAULT_SIZE);
+    // Create the mesh batch, with a fixed budget so its vertices are written directly to the vertex buffer
+    MeshBatch* meshBatch = MeshBatch::create(vertexFormat, Mesh::TRIANGLES, material, false, initialCapacity > 0 ? initialCapacity : SPRITE_BATCH_DEFAULT_SIZE, 0);
 
     // Search for the first sampler uniform in the effect.
     Uniform* samplerUniform = NULL;
@@ -282,12 +285,14 @@ void SpriteBatch::draw(float x, float y, float z, float width, float height, flo
     Vector2 downRight( downLeft + du );
 
     // Write sprite vertex data.
-    SpriteVertex * v = _batch->reserve< SpriteVertex >( 6 );
+    SpriteVertex * v = reserveVertices(6);
+    if (v == NULL)
+        return;
     SPRITE_ADD_VERTEX(v[0], downLeft.x, downLeft.y, z, u1, v1, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[1], upLeft.x, upLeft.y, z, u1, v2, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[2], downRight.x, downRight.y, z, u2, v1, color.x, color.y, color.z, color.w);
-    v[3] = v[2];
-    v[4] = v[1];
+    SPRITE_ADD_VERTEX(v[3], downRight.x, downRight.y, z, u2, v1, color.x, color.y, color.z, color.w);
+    SPRITE_ADD_VERTEX(v[4], upLeft.x, upLeft.y, z, u1, v2, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[5], upRight.x, upRight.y, z, u2, v2, color.x, color.y, color.z, color.w);
 }
 
@@ -346,12 +351,14 @@ void SpriteBatch::draw(const Vector3& position, const Vector3& right, const Vect
 
 
     // Add the sprite vertex data to the batch.
-    SpriteVertex * v = _batch->reserve< SpriteVertex >( 6 );
+    SpriteVertex * v = reserveVertices(6);
+    if (v == NULL)
+        return;
     SPRITE_ADD_VERTEX(v[0], p0.x, p0.y, p0.z, u1, v1, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[1], p1.x, p1.y, p1.z, u2, v1, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[2], p2.x, p2.y, p2.z, u1, v2, color.x, color.y, color.z, color.w);
-    v[3] = v[2];
-    v[4] = v[1];
+    SPRITE_ADD_VERTEX(v[3], p2.x, p2.y, p2.z, u1, v2, color.x, color.y, color.z, color.w);
+    SPRITE_ADD_VERTEX(v[4], p1.x, p1.y, p1.z, u2, v1, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[5], p3.x, p3.y, p3.z, u2, v2, color.x, color.y, color.z, color.w);
 }
 
@@ -410,7 +417,17 @@ void SpriteBatch::draw(SpriteBatch::SpriteVertex* vertices, unsigned int vertexC
 {
     GP_ASSERT(vertices);
 
-    _batch->add(vertices, vertexCount);
+    // Copy the vertices in parts of at most the capacity of the batch, whole triangles each.
+    while (vertexCount > 0)
+    {
+        unsigned int count = std::min(vertexCount, _batch->getCapacity() * 3);
+        SpriteVertex* v = reserveVertices(count);
+        if (v == NULL)
+            return;
+        memcpy(v, vertices, count * sizeof(SpriteVertex));
+        vertices += count;
+        vertexCount -= count;
+    }
 }
 
 void SpriteBatch::draw(float x, float y, float z, float width, float height, float u1, float v1, float u2, float v2, const Vector4& color, bool positionIsCenter)
@@ -425,15 +442,34 @@ void SpriteBatch::draw(float x, float y, float z, float width, float height, flo
     // Write sprite vertex data.
     const float x2 = x + width;
     const float y2 = y + height;
-    SpriteVertex * v = _batch->reserve< SpriteVertex >( 6 );
+    SpriteVertex * v = reserveVertices(6);
+    if (v == NULL)
+        return;
     SPRITE_ADD_VERTEX(v[0], x, y, z, u1, v1, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[1], x, y2, z, u1, v2, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[2], x2, y, z, u2, v1, color.x, color.y, color.z, color.w);
-    v[3] = v[2];
-    v[4] = v[1];
+    SPRITE_ADD_VERTEX(v[3], x2, y, z, u2, v1, color.x, color.y, color.z, color.w);
+    SPRITE_ADD_VERTEX(v[4], x, y2, z, u1, v2, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[5], x2, y2, z, u2, v2, color.x, color.y, color.z, color.w);
 }
 
+SpriteBatch::SpriteVertex* SpriteBatch::reserveVertices(unsigned int vertexCount)
+{
+    SpriteVertex* vertices = _batch->reserve<SpriteVertex>(vertexCount);
+    if (vertices == NULL)
+    {
+        // The batch is full: draw it and start it again, growing it so it is drawn in fewer parts next time.
+        _batch->finish();
+        _batch->draw();
+        unsigned int capacity = std::min((unsigned int)(_batch->getCapacity() * SPRITE_BATCH_GROW_FACTOR), (unsigned int)SPRITE_BATCH_MAX_SIZE);
+        if (capacity > _batch->getCapacity())
+            _batch->setCapacity(capacity);
+        _batch->start();
+        vertices = _batch->reserve<SpriteVertex>(vertexCount);
+    }
+    return vertices;
+}
+
 void SpriteBatch::finish()
 {
     // Finish and draw the batch
@@ -416,6 +416,15 @@ private:
 
     bool clipSprite(const Rectangle& clip, float& x, float& y, float& width, float& height, float& u1, float& v1, float& u2, float& v2);
 
+    /**
+     * Reserves vertices in the batch, drawing and restarting it first when it is full.
+     *
+     * @param vertexCount The number of vertices, at most the capacity of the batch.
+     *
+     * @return The vertices to write, or NULL if they do not fit in the batch.
+     */
+    SpriteBatch::SpriteVertex* reserveVertices(unsigned int vertexCount);
+
     MeshBatch* _batch;
     Texture::Sampler* _sampler;
     bool _customEffect;
@@ -155,6 +155,18 @@ public:
      */
     virtual bool rewind() = 0;
 
+    /**
+     * Gets the bytes of the stream, if the whole stream is mapped in memory.
+     *
+     * Mapped bytes can be used in place instead of being read into a buffer. They stay valid
+     * until the stream is closed and must not be written to.
+     *
+     * @return The first byte of the stream, or NULL if the stream is not mapped in memory.
+     *
+     * @see FileSystem::MAP
+     */
+    virtual const void* map() { return NULL; }
+
 protected:
     Stream() {};
 private:
@@ -2,6 +2,7 @@
 #include "Image.h"
 #include "Texture.h"
 #include "FileSystem.h"
+#include "ResourceCache.h"
 
 // PVRTC (GL_IMG_texture_compression_pvrtc) : Imagination based gpus
 #ifndef GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG
@@ -47,11 +48,10 @@
 namespace gameplay
 {
 
-static std::vector<Texture*> __textureCache;
 static TextureHandle __currentTextureId = 0;
 static Texture::Type __currentTextureType = Texture::TEXTURE_2D;
 
-Texture::Texture() : _handle(0), _format(UNKNOWN), _type((Texture::Type)0), _width(0), _height(0), _mipmapped(false), _cached(false), _compressed(false),
+Texture::Texture() : _handle(0), _format(UNKNOWN), _type((Texture::Type)0), _width(0), _height(0), _mipmapped(false), _cached(false), _compressed(false), _dataSize(0),
     _wrapS(Texture::REPEAT), _wrapT(Texture::REPEAT), _wrapR(Texture::REPEAT), _minFilter(Texture::NEAREST_MIPMAP_LINEAR), _magFilter(Texture::LINEAR)
 {
 }
@@ -63,16 +63,6 @@ Texture::~Texture()
         GL_ASSERT( glDeleteTextures(1, &_handle) );
         _handle = 0;
     }
-
-    // Remove ourself from the texture cache.
-    if (_cached)
-    {
-        std::vector<Texture*>::iterator itr = std::find(__textureCache.begin(), __textureCache.end(), this);
-        if (itr != __textureCache.end())
-        {
-            __textureCache.erase(itr);
-        }
-    }
 }
 
 Texture* Texture::create(const char* path, bool generateMipmaps)
@@ -80,24 +70,16 @@ Texture* Texture::create(const char* path, bool generateMipmaps)
     GP_ASSERT( path );
 
     // Search texture cache first.
-    for (size_t i = 0, count = __textureCache.size(); i < count; ++i)
+    Texture* t = static_cast<Texture*>(ResourceCache::find(ResourceCache::TEXTURE, path));
+    if (t)
     {
-        Texture* t = __textureCache[i];
-        GP_ASSERT( t );
-        if (t->_path == path)
+        // If 'generateMipmaps' is true, call Texture::generateMipamps() to force the
+        // texture to generate its mipmap chain if it hasn't already done so.
+        if (generateMipmaps)
         {
-            // If 'generateMipmaps' is true, call Texture::generateMipamps() to force the
-            // texture to generate its mipmap chain if it hasn't already done so.
-            if (generateMipmaps)
-            {
-                t->generateMipmaps();
-            }
-
-            // Found a match.
-            t->addRef();
-
-            return t;
+            t->generateMipmaps();
         }
+        return t;
     }
 
     Texture* texture = NULL;
@@ -137,7 +119,7 @@ Texture* Texture::create(const char* path, bool generateMipmaps)
         texture->_cached = true;
 
         // Add to texture cache.
-        __textureCache.push_back(texture);
+        ResourceCache::add(ResourceCache::TEXTURE, path, texture, 0, texture->getMemorySize());
 
         return texture;
     }
@@ -146,6 +128,34 @@ Texture* Texture::create(const char* path, bool generateMipmaps)
     return NULL;
 }
 
+Texture* Texture::create(const char* path, Image* image, bool generateMipmaps)
+{
+    GP_ASSERT( path );
+    GP_ASSERT( image );
+
+    // The texture may have been loaded since the image was.
+    Texture* t = static_cast<Texture*>(ResourceCache::find(ResourceCache::TEXTURE, path));
+    if (t)
+    {
+        if (generateMipmaps)
+        {
+            t->generateMipmaps();
+        }
+        return t;
+    }
+
+    Texture* texture = create(image, generateMipmaps);
+    if (texture)
+    {
+        texture->_path = path;
+        texture->_cached = true;
+
+        // Add to texture cache.
+        ResourceCache::add(ResourceCache::TEXTURE, path, texture, 0, texture->getMemorySize());
+    }
+    return texture;
+}
+
 Texture* Texture::create(Image* image, bool generateMipmaps)
 {
     GP_ASSERT( image );
@@ -386,6 +396,27 @@ void Texture::setData(const unsigned char* data)
     GL_ASSERT( glBindTexture((GLenum)__currentTextureType, __currentTextureId) );
 }
 
+void Texture::setData(const unsigned char* data, unsigned int x, unsigned int y, unsigned int width, unsigned int height)
+{
+    // Don't work with any compressed or cached textures
+    GP_ASSERT( data );
+    GP_ASSERT( (!_compressed) );
+    GP_ASSERT( (!_cached) );
+    GP_ASSERT( _type == Texture::TEXTURE_2D );
+    GP_ASSERT( x + width <= _width && y + height <= _height );
+
+    GL_ASSERT( glBindTexture(GL_TEXTURE_2D, _handle) );
+    GL_ASSERT( glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, _internalFormat, _texelType, data) );
+
+    if (_mipmapped)
+    {
+        generateMipmaps();
+    }
+
+    // Restore the texture id
+    GL_ASSERT( glBindTexture((GLenum)__currentTextureType, __currentTextureId) );
+}
+
 // Computes the size of a PVRTC data chunk for a mipmap level of the given size.
 static unsigned int computePVRTCDataSize(int width, int height, int bpp)
 {
@@ -494,6 +525,7 @@ Texture* Texture::createCompressedPVRTC(const char* path)
             // Upload data to GL.
             GL_ASSERT(glCompressedTexImage2D(faces[face], level, format, width, height, 0, dataSize, &ptr[face * dataSize]));
         }
+        texture->_dataSize += dataSize * faceCount;
 
         width = std::max(width >> 1, 1);
         height = std::max(height >> 1, 1);
@@ -1144,6 +1176,7 @@ Texture* Texture::createCompressedDDS(const char* path)
             {
                 GL_ASSERT(glTexImage2D(texImageTarget, i, internalFormat, level.width, level.height, 0, format, GL_UNSIGNED_BYTE, level.data));
             }
+            texture->_dataSize += level.size;
 
             // Clean up the texture data.
             SAFE_DELETE_ARRAY(level.data);
@@ -1216,6 +1249,20 @@ bool Texture::isCompressed() const
     return _compressed;
 }
 
+size_t Texture::getMemorySize() const
+{
+    if (_dataSize > 0)
+        return _dataSize;
+
+    // A full mipmap chain adds a third of the size of the base level.
+    size_t size = (size_t)_width * _height * getFormatBPP(_format);
+    if (_type == TEXTURE_CUBE)
+        size *= 6;
+    if (_mipmapped)
+        size += size / 3;
+    return size;
+}
+
 Texture::Sampler::Sampler(Texture* texture)
     : _texture(texture), _wrapS(Texture::REPEAT), _wrapT(Texture::REPEAT), _wrapR(Texture::REPEAT)
 {
@@ -15,6 +15,7 @@ class Image;
 class Texture : public Ref
 {
     friend class Sampler;
+    friend class ResourceLoader;
 
 public:
 
@@ -241,6 +242,20 @@ public:
      */
     void setData(const unsigned char* data);
 
+    /**
+     * Set texture data to replace a rectangle of the texture image.
+     *
+     * Only supported for uncompressed 2D textures.
+     *
+     * @param data Raw texture data of the rectangle (expected to be tightly packed).
+     * @param x The x coordinate of the rectangle, in pixels.
+     * @param y The y coordinate of the rectangle, in pixels.
+     * @param width The width of the rectangle, in pixels.
+     * @param height The height of the rectangle, in pixels.
+     * @script{ignore}
+     */
+    void setData(const unsigned char* data, unsigned int x, unsigned int y, unsigned int width, unsigned int height);
+
     /**
      * Returns the path that the texture was originally loaded from (if applicable).
      *
@@ -293,6 +308,14 @@ public:
      */
     bool isCompressed() const;
 
+    /**
+     * Gets the estimated GPU memory used by the texels of this texture, including all its faces and mipmap levels.
+     *
+     * @return The memory size, in bytes.
+     * @script{ignore}
+     */
+    size_t getMemorySize() const;
+
     /**
      * Returns the texture handle.
      *
@@ -322,6 +345,11 @@ private:
      */
     Texture& operator=(const Texture&);
 
+    /**
+     * Creates a texture from an image loaded from a path, and caches it as the texture of the path.
+     */
+    static Texture* create(const char* path, Image* image, bool generateMipmaps);
+
     static Texture* createCompressedPVRTC(const char* path);
 
     static Texture* createCompressedDDS(const char* path);
@@ -344,6 +372,7 @@ private:
     bool _mipmapped;
     bool _cached;
     bool _compressed;
+    size_t _dataSize;       // Bytes of the levels loaded from a compressed or DDS file, 0 otherwise.
     Wrap _wrapS;
     Wrap _wrapT;
     Wrap _wrapR;
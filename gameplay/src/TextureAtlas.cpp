@@ -0,0 +1,265 @@
+#include "Base.h"
+#include "TextureAtlas.h"
+#include "Image.h"
+#include "SpriteBatch.h"
+#include "Texture.h"
+
+// Width of the border repeating the edge pixels of each image, in pixels
+#define TEXTURE_ATLAS_BORDER 1
+
+namespace gameplay
+{
+
+TextureAtlas::TextureAtlas(unsigned int pageWidth, unsigned int pageHeight)
+    : _pageWidth(pageWidth), _pageHeight(pageHeight)
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    for (size_t i = 0, count = _pages.size(); i < count; ++i)
+    {
+        SAFE_DELETE(_pages[i]->batch);
+        SAFE_RELEASE(_pages[i]->texture);
+        SAFE_DELETE(_pages[i]);
+    }
+    for (std::map<std::string, Region*>::iterator itr = _regions.begin(); itr != _regions.end(); ++itr)
+    {
+        SAFE_DELETE(itr->second);
+    }
+}
+
+TextureAtlas* TextureAtlas::create(unsigned int pageWidth, unsigned int pageHeight)
+{
+    GP_ASSERT(pageWidth > 2 * TEXTURE_ATLAS_BORDER && pageHeight > 2 * TEXTURE_ATLAS_BORDER);
+
+    return new TextureAtlas(pageWidth, pageHeight);
+}
+
+const TextureAtlas::Region* TextureAtlas::add(const char* path)
+{
+    GP_ASSERT(path);
+
+    std::map<std::string, Region*>::const_iterator itr = _regions.find(path);
+    if (itr != _regions.end())
+        return itr->second;
+
+    // Only pack the formats loaded into images, compressed textures cannot be packed.
+    Image* image = NULL;
+    const char* ext = strrchr(path, '.');
+    if (ext && (strcmpnocase(ext, ".png") == 0 || strcmpnocase(ext, ".jpg") == 0))
+        image = Image::create(path);
+    if (image == NULL)
+    {
+        _regions[path] = NULL;
+        return NULL;
+    }
+
+    const Region* region = add(path, image);
+    SAFE_RELEASE(image);
+    return region;
+}
+
+const TextureAtlas::Region* TextureAtlas::add(const char* id, Image* image)
+{
+    GP_ASSERT(id);
+    GP_ASSERT(image);
+
+    std::map<std::string, Region*>::const_iterator itr = _regions.find(id);
+    if (itr != _regions.end())
+        return itr->second;
+
+    unsigned int imageWidth = image->getWidth();
+    unsigned int imageHeight = image->getHeight();
+    unsigned int width = imageWidth + 2 * TEXTURE_ATLAS_BORDER;
+    unsigned int height = imageHeight + 2 * TEXTURE_ATLAS_BORDER;
+    if (imageWidth == 0 || imageHeight == 0 || width > _pageWidth || height > _pageHeight)
+    {
+        GP_WARN("Image '%s' (%ux%u) does not fit in a texture atlas page (%ux%u).", id, imageWidth, imageHeight, _pageWidth, _pageHeight);
+        _regions[id] = NULL;
+        return NULL;
+    }
+
+    // Pack the image in the first page it fits in, or in a new page.
+    unsigned int x = 0;
+    unsigned int y = 0;
+    unsigned int pageIndex = 0;
+    while (pageIndex < _pages.size() && !pack(_pages[pageIndex], width, height, &x, &y))
+        ++pageIndex;
+    if (pageIndex == _pages.size())
+    {
+        Page* page = createPage();
+        if (page == NULL)
+        {
+            _regions[id] = NULL;
+            return NULL;
+        }
+        _pages.push_back(page);
+        pack(page, width, height, &x, &y);
+    }
+
+    // Copy the image to RGBA texels, repeating its edge pixels in the border.
+    unsigned int bpp = image->getFormat() == Image::RGBA ? 4 : 3;
+    const unsigned char* src = image->getData();
+    std::vector<unsigned char> texels(width * height * 4);
+    unsigned char* dst = &texels[0];
+    for (unsigned int row = 0; row < height; ++row)
+    {
+        unsigned int srcRow = (unsigned int)std::min(std::max((int)row - TEXTURE_ATLAS_BORDER, 0), (int)imageHeight - 1);
+        for (unsigned int column = 0; column < width; ++column)
+        {
+            unsigned int srcColumn = (unsigned int)std::min(std::max((int)column - TEXTURE_ATLAS_BORDER, 0), (int)imageWidth - 1);
+            const unsigned char* texel = src + (srcRow * imageWidth + srcColumn) * bpp;
+            dst[0] = texel[0];
+            dst[1] = texel[1];
+            dst[2] = texel[2];
+            dst[3] = bpp == 4 ? texel[3] : 255;
+            dst += 4;
+        }
+    }
+    _pages[pageIndex]->texture->setData(&texels[0], x, y, width, height);
+
+    Region* region = new Region();
+    region->page = pageIndex;
+    region->bounds.set((float)(x + TEXTURE_ATLAS_BORDER), (float)(y + TEXTURE_ATLAS_BORDER), (float)imageWidth, (float)imageHeight);
+    region->u1 = region->bounds.x / (float)_pageWidth;
+    region->v1 = region->bounds.y / (float)_pageHeight;
+    region->u2 = region->bounds.right() / (float)_pageWidth;
+    region->v2 = region->bounds.bottom() / (float)_pageHeight;
+    _regions[id] = region;
+
+    return region;
+}
+
+const TextureAtlas::Region* TextureAtlas::getRegion(const char* id) const
+{
+    GP_ASSERT(id);
+
+    std::map<std::string, Region*>::const_iterator itr = _regions.find(id);
+    return itr != _regions.end() ? itr->second : NULL;
+}
+
+unsigned int TextureAtlas::getPageCount() const
+{
+    return (unsigned int)_pages.size();
+}
+
+Texture* TextureAtlas::getPage(unsigned int index) const
+{
+    GP_ASSERT(index < _pages.size());
+    return _pages[index]->texture;
+}
+
+SpriteBatch* TextureAtlas::getSpriteBatch(unsigned int index) const
+{
+    GP_ASSERT(index < _pages.size());
+    return _pages[index]->batch;
+}
+
+TextureAtlas::Page* TextureAtlas::createPage()
+{
+    std::vector<unsigned char> texels(_pageWidth * _pageHeight * 4, 0);
+    Texture* texture = Texture::create(Texture::RGBA, _pageWidth, _pageHeight, &texels[0]);
+    if (texture == NULL)
+    {
+        GP_WARN("Failed to create a texture atlas page (%ux%u).", _pageWidth, _pageHeight);
+        return NULL;
+    }
+
+    SpriteBatch* batch = SpriteBatch::create(texture);
+    if (batch == NULL)
+    {
+        GP_WARN("Failed to create the sprite batch of a texture atlas page.");
+        SAFE_RELEASE(texture);
+        return NULL;
+    }
+    batch->getSampler()->setWrapMode(Texture::CLAMP, Texture::CLAMP);
+
+    Page* page = new Page();
+    page->texture = texture;
+    page->batch = batch;
+    SkylineNode node = { 0, 0, _pageWidth };
+    page->skyline.push_back(node);
+    return page;
+}
+
+bool TextureAtlas::pack(Page* page, unsigned int width, unsigned int height, unsigned int* x, unsigned int* y)
+{
+    GP_ASSERT(page);
+    std::vector<SkylineNode>& skyline = page->skyline;
+
+    // Find the node where the rectangle, resting on the highest of the nodes it spans,
+    // ends the lowest, preferring narrower nodes to leave wider ones for larger rectangles.
+    int best = -1;
+    unsigned int bestY = 0;
+    unsigned int bestBottom = UINT_MAX;
+    unsigned int bestWidth = UINT_MAX;
+    for (size_t i = 0, count = skyline.size(); i < count; ++i)
+    {
+        if (skyline[i].x + width > _pageWidth)
+            break;
+
+        unsigned int top = 0;
+        unsigned int spanned = 0;
+        for (size_t j = i; spanned < width; ++j)
+        {
+            GP_ASSERT(j < count);
+            top = std::max(top, skyline[j].y);
+            spanned += skyline[j].width;
+        }
+
+        unsigned int bottom = top + height;
+        if (bottom > _pageHeight)
+            continue;
+        if (bottom < bestBottom || (bottom == bestBottom && skyline[i].width < bestWidth))
+        {
+            best = (int)i;
+            bestY = top;
+            bestBottom = bottom;
+            bestWidth = skyline[i].width;
+        }
+    }
+    if (best < 0)
+        return false;
+
+    *x = skyline[best].x;
+    *y = bestY;
+
+    // Raise the skyline over the rectangle, removing or shortening the nodes it covers.
+    SkylineNode node = { *x, bestBottom, width };
+    skyline.insert(skyline.begin() + best, node);
+    unsigned int right = node.x + node.width;
+    size_t i = best + 1;
+    while (i < skyline.size() && skyline[i].x < right)
+    {
+        unsigned int covered = right - skyline[i].x;
+        if (skyline[i].width <= covered)
+        {
+            skyline.erase(skyline.begin() + i);
+        }
+        else
+        {
+            skyline[i].x += covered;
+            skyline[i].width -= covered;
+            break;
+        }
+    }
+
+    // Merge neighbouring nodes of the same height.
+    for (i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,175 @@
+#ifndef TEXTUREATLAS_H_
+#define TEXTUREATLAS_H_
+
+#include "Ref.h"
+#include "Rectangle.h"
+
+namespace gameplay
+{
+
+class Image;
+class SpriteBatch;
+class Texture;
+
+/**
+ * Defines a texture atlas, which packs images into a few large textures, its pages, at runtime.
+ *
+ * Sprites drawn from the images of a page can all be drawn with the sprite batch of the page,
+ * in one draw call, instead of one batch and one draw call for the texture of each image.
+ *
+ * Images are packed with a skyline packer, which keeps the top edge of the area used in each
+ * page and places each image where its top ends the lowest. Images are surrounded by a border
+ * repeating their edge pixels, so that filtering does not blend them with their neighbours.
+ * Images stay in the atlas until it is destroyed.
+ *
+ * @script{ignore}
+ */
+class TextureAtlas : public Ref
+{
+public:
+
+    /**
+     * An image packed in the atlas.
+     */
+    struct Region
+    {
+        /** The index of the page the image is packed in. */
+        unsigned int page;
+        /** The bounds of the image in the page, in pixels. */
+        Rectangle bounds;
+        /** The texture coordinates of the top left corner of the image in the page. */
+        float u1;
+        float v1;
+        /** The texture coordinates of the bottom right corner of the image in the page. */
+        float u2;
+        float v2;
+    };
+
+    /**
+     * Creates an empty texture atlas.
+     *
+     * @param pageWidth The width of the pages, in pixels.
+     * @param pageHeight The height of the pages, in pixels.
+     *
+     * @return The new texture atlas.
+     */
+    static TextureAtlas* create(unsigned int pageWidth = 1024, unsigned int pageHeight = 1024);
+
+    /**
+     * Packs the image at a path in the atlas, if it is not packed yet.
+     *
+     * Only PNG and JPEG images are packed.
+     *
+     * @param path The path of the image, which identifies its region.
+     *
+     * @return The region of the image, or NULL if it could not be loaded or is larger than a page.
+     */
+    const Region* add(const char* path);
+
+    /**
+     * Packs an image in the atlas, if no image with the same identifier is packed yet.
+     *
+     * @param id The identifier of the region of the image.
+     * @param image The image.
+     *
+     * @return The region of the image, or NULL if it is larger than a page.
+     */
+    const Region* add(const char* id, Image* image);
+
+    /**
+     * Gets the region of a packed image.
+     *
+     * @param id The path or identifier the image was added with.
+     *
+     * @return The region of the image, or NULL if it is not packed in the atlas.
+     */
+    const Region* getRegion(const char* id) const;
+
+    /**
+     * Gets the number of pages.
+     *
+     * @return The number of pages.
+     */
+    unsigned int getPageCount() const;
+
+    /**
+     * Gets the texture of a page.
+     *
+     * @param index The index of the page.
+     *
+     * @return The texture of the page.
+     */
+    Texture* getPage(unsigned int index) const;
+
+    /**
+     * Gets the sprite batch drawing from a page.
+     *
+     * The texture coordinates given to the batch are those of the page, see Region.
+     *
+     * @param index The index of the page.
+     *
+     * @return The sprite batch of the page.
+     */
+    SpriteBatch* getSpriteBatch(unsigned int index) const;
+
+private:
+
+    /**
+     * A segment of the top edge of the area used in a page.
+     */
+    struct SkylineNode
+    {
+        unsigned int x;
+        unsigned int y;
+        unsigned int width;
+    };
+
+    /**
+     * A page of the atlas.
+     */
+    struct Page
+    {
+        Texture* texture;
+        SpriteBatch* batch;
+        std::vector<SkylineNode> skyline;   // Sorted by x, covering the width of the page.
+    };
+
+    /**
+     * Constructor.
+     */
+    TextureAtlas(unsigned int pageWidth, unsigned int pageHeight);
+
+    /**
+     * Destructor.
+     */
+    ~TextureAtlas();
+
+    /**
+     * Hidden copy constructor.
+     */
+    TextureAtlas(const TextureAtlas& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    TextureAtlas& operator=(const TextureAtlas&);
+
+    /**
+     * Creates a new empty page.
+     */
+    Page* createPage();
+
+    /**
+     * Finds a place for a rectangle in a page and raises the skyline of the page over it.
+     */
+    bool pack(Page* page, unsigned int width, unsigned int height, unsigned int* x, unsigned int* y);
+
+    unsigned int _pageWidth;
+    unsigned int _pageHeight;
+    std::vector<Page*> _pages;
+    std::map<std::string, Region*> _regions;    // NULL for images that could not be packed.
+};
+
+}
+
+#endif
@@ -6,9 +6,59 @@
 namespace gameplay
 {
 
-int Transform::_suspendTransformChanged(0);
-std::vector<Transform*> Transform::_transformsChanged;
-std::recursive_mutex Transform::_transformsChangedMutex;
+std::atomic<int> Transform::_suspendTransformChanged(0);
+
+// Transforms waiting for transformChanged() while notifications are suspended. Each thread
+// queues to its own list so that transforms can be changed concurrently without locking.
+// The lists are registered while their thread runs and merged by resumeTransformChanged().
+struct TransformsChangedQueue;
+static std::vector<TransformsChangedQueue*> __transformsChangedQueues;
+static std::vector<Transform*> __transformsChangedByExitedThreads;
+static std::mutex __transformsChangedQueuesMutex;
+
+/**
+ * The list of transforms queued by a thread, owned by the thread.
+ */
+struct TransformsChangedQueue
+{
+    TransformsChangedQueue()
+    {
+        std::lock_guard<std::mutex> lock(__transformsChangedQueuesMutex);
+        __transformsChangedQueues.push_back(this);
+    }
+
+    ~TransformsChangedQueue()
+    {
+        // The transforms queued by an exiting thread are notified by the next resume.
+        std::lock_guard<std::mutex> lock(__transformsChangedQueuesMutex);
+        __transformsChangedQueues.erase(std::find(__transformsChangedQueues.begin(), __transformsChangedQueues.end(), this));
+        __transformsChangedByExitedThreads.insert(__transformsChangedByExitedThreads.end(), transforms.begin(), transforms.end());
+    }
+
+    std::vector<Transform*> transforms;
+};
+
+static std::vector<Transform*>& getTransformsChanged()
+{
+    static thread_local TransformsChangedQueue queue;
+    return queue.transforms;
+}
+
+/**
+ * Moves the transforms queued by all the threads to a list.
+ */
+static void takeTransformsChanged(std::vector<Transform*>& out)
+{
+    std::lock_guard<std::mutex> lock(__transformsChangedQueuesMutex);
+    for (size_t q = 0, queueCount = __transformsChangedQueues.size(); q < queueCount; q++)
+    {
+        std::vector<Transform*>& transforms = __transformsChangedQueues[q]->transforms;
+        out.insert(out.end(), transforms.begin(), transforms.end());
+        transforms.clear();
+    }
+    out.insert(out.end(), __transformsChangedByExitedThreads.begin(), __transformsChangedByExitedThreads.end());
+    __transformsChangedByExitedThreads.clear();
+}
 
 Transform::Transform()
     : _matrixDirtyBits(0), _listeners(NULL), _translation( 0.0f, 0.0f, 0.0f )
@@ -63,29 +113,30 @@ void Transform::resumeTransformChanged()
     
     if (_suspendTransformChanged == 1)
     {
-        std::unique_lock<std::recursive_mutex> lock(_transformsChangedMutex);
+        // Take the queued transforms out of the lists and notify them without holding the lock,
+        // listeners may change transforms on threads that do not have a list yet.
+        std::vector<Transform*> transformsChanged;
+        takeTransformsChanged(transformsChanged);
 
         // Call transformChanged() on all transforms in the list
-        size_t transformCount = _transformsChanged.size();
+        size_t transformCount = transformsChanged.size();
         for (size_t i = 0; i < transformCount; i++)
         {
-            Transform* t = _transformsChanged.at(i);
+            Transform* t = transformsChanged[i];
             GP_ASSERT(t);
             t->transformChanged();
         }
 
         // Go through list and reset DIRTY_NOTIFY bit. The list could potentially be larger here if the 
         // transforms we were delaying calls to transformChanged() have any child nodes.
-        transformCount = _transformsChanged.size();
+        takeTransformsChanged(transformsChanged);
+        transformCount = transformsChanged.size();
         for (size_t i = 0; i < transformCount; i++)
         {
-            Transform* t = _transformsChanged.at(i);
+            Transform* t = transformsChanged[i];
             GP_ASSERT(t);
             t->_matrixDirtyBits &= ~DIRTY_NOTIFY;
         }
-
-        // empty list for next frame.
-        _transformsChanged.clear();
     }
     _suspendTransformChanged--;
 }
@@ -941,11 +992,9 @@ bool Transform::isDirty(char matrixDirtyBits) const
 
 void Transform::suspendTransformChange(Transform* transform)
 {
-    std::unique_lock<std::recursive_mutex> lock(_transformsChangedMutex);
-
     GP_ASSERT(transform);
     transform->_matrixDirtyBits |= DIRTY_NOTIFY;
-    _transformsChanged.push_back(transform);
+    getTransformsChanged().push_back(transform);
 }
 
 void Transform::addListener(Transform::Listener* listener, long cookie)
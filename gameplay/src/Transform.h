@@ -108,11 +108,17 @@ public:
 
     /**
      * Globally suspends all transform changed events.
+     *
+     * While suspended, transforms that change on any thread are queued on a queue owned by
+     * that thread, without locking. The queues of all the threads are merged and notified
+     * when the events are resumed.
      */
     static void suspendTransformChanged();
 
     /**
      * Globally resumes all transform changed events.
+     *
+     * Must not be called while other threads are still changing transforms.
      */
     static void resumeTransformChanged();
 
@@ -842,8 +848,8 @@ protected:
     bool isDirty(char matrixDirtyBits) const;
 
     /** 
-     * Adds the specified transform to the list of transforms waiting to be notified of a change.
-     * Sets the DIRTY_NOTIFY bit on the transform.
+     * Adds the specified transform to the calling thread's list of transforms waiting to be
+     * notified of a change. Sets the DIRTY_NOTIFY bit on the transform.
      */
     static void suspendTransformChange(Transform* transform);
 
@@ -894,9 +900,7 @@ private:
    
     void applyAnimationValueRotation(AnimationValue* value, unsigned int index, float blendWeight);
 
-    static int _suspendTransformChanged;
-    static std::vector<Transform*> _transformsChanged;
-    static std::recursive_mutex _transformsChangedMutex;
+    static std::atomic<int> _suspendTransformChanged;
 
 };
 
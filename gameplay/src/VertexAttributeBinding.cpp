@@ -6,8 +6,92 @@
 namespace gameplay
 {
 
+/**
+ * Key of a mesh binding in the cache: the mesh and the attribute location of each of its vertex elements.
+ */
+struct VertexAttributeBindingKey
+{
+    Mesh* mesh;
+    std::vector<GLint> locations;
+
+    bool operator==(const VertexAttributeBindingKey& key) const
+    {
+        return mesh == key.mesh && locations == key.locations;
+    }
+};
+
+struct VertexAttributeBindingKeyHash
+{
+    size_t operator()(const VertexAttributeBindingKey& key) const
+    {
+        size_t hash = std::hash<Mesh*>()(key.mesh);
+        for (size_t i = 0, count = key.locations.size(); i < count; ++i)
+        {
+            hash = hash * 31 + (size_t)(key.locations[i] + 1);
+        }
+        return hash;
+    }
+};
+
 static GLuint __maxVertexAttribs = 0;
-static std::vector<VertexAttributeBinding*> __vertexAttributeBindingCache;
+static std::unordered_map<VertexAttributeBindingKey, VertexAttributeBinding*, VertexAttributeBindingKeyHash> __vertexAttributeBindingCache;
+static VertexAttributeBinding::CacheStatistics __vertexAttributeBindingCacheStatistics = { 0, 0, 0, 0 };
+
+/**
+ * Gets the vertex attribute of an effect that a vertex element with a usage is bound to, or -1.
+ */
+static VertexAttribute getVertexAttribute(Effect* effect, VertexFormat::Usage usage)
+{
+    VertexAttribute attrib;
+    std::string name;
+
+    // Constructor vertex attribute name expected in shader.
+    switch (usage)
+    {
+    case VertexFormat::POSITION:
+        attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_POSITION_NAME);
+        break;
+    case VertexFormat::NORMAL:
+        attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_NORMAL_NAME);
+        break;
+    case VertexFormat::COLOR:
+        attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_COLOR_NAME);
+        break;
+    case VertexFormat::TANGENT:
+        attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_TANGENT_NAME);
+        break;
+    case VertexFormat::BINORMAL:
+        attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_BINORMAL_NAME);
+        break;
+    case VertexFormat::BLENDWEIGHTS:
+        attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_BLENDWEIGHTS_NAME);
+        break;
+    case VertexFormat::BLENDINDICES:
+        attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_BLENDINDICES_NAME);
+        break;
+    case VertexFormat::TEXCOORD0:
+        if ((attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME)) != -1)
+            break;
+
+    case VertexFormat::TEXCOORD1:
+    case VertexFormat::TEXCOORD2:
+    case VertexFormat::TEXCOORD3:
+    case VertexFormat::TEXCOORD4:
+    case VertexFormat::TEXCOORD5:
+    case VertexFormat::TEXCOORD6:
+    case VertexFormat::TEXCOORD7:
+        name = VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME;
+        name += '0' + (usage - VertexFormat::TEXCOORD0);
+        attrib = effect->getVertexAttribute(name.c_str());
+        break;
+    default:
+        // This happens whenever vertex data contains extra information (not an error).
+        attrib = -1;
+        break;
+    }
+
+    return attrib;
+}
 
 VertexAttributeBinding::VertexAttributeBinding() :
     _handle(0), _attributes(NULL), _mesh(NULL), _effect(NULL), _attributesCount( 0 )
@@ -17,10 +101,17 @@ VertexAttributeBinding::VertexAttributeBinding() :
 VertexAttributeBinding::~VertexAttributeBinding()
 {
     // Delete from the vertex attribute binding cache.
-    std::vector<VertexAttributeBinding*>::iterator itr = std::find(__vertexAttributeBindingCache.begin(), __vertexAttributeBindingCache.end(), this);
-    if (itr != __vertexAttributeBindingCache.end())
+    if (_mesh)
     {
-        __vertexAttributeBindingCache.erase(itr);
+        VertexAttributeBindingKey key;
+        key.mesh = _mesh;
+        key.locations = _locations;
+        std::unordered_map<VertexAttributeBindingKey, VertexAttributeBinding*, VertexAttributeBindingKeyHash>::iterator itr = __vertexAttributeBindingCache.find(key);
+        if (itr != __vertexAttributeBindingCache.end() && itr->second == this)
+        {
+            __vertexAttributeBindingCache.erase(itr);
+            __vertexAttributeBindingCacheStatistics.size = (unsigned int)__vertexAttributeBindingCache.size();
+        }
     }
 
     SAFE_RELEASE(_mesh);
@@ -37,32 +128,54 @@ VertexAttributeBinding::~VertexAttributeBinding()
 VertexAttributeBinding* VertexAttributeBinding::create(Mesh* mesh, Effect* effect)
 {
     GP_ASSERT(mesh);
+    GP_ASSERT(effect);
+
+    // A binding only depends on the attribute locations the effect gives to the vertex
+    // elements of the mesh, so effects with the same locations share it.
+    const VertexFormat& vertexFormat = mesh->getVertexFormat();
+    VertexAttributeBindingKey key;
+    key.mesh = mesh;
+    key.locations.resize(vertexFormat.getElementCount());
+    for (size_t i = 0, count = vertexFormat.getElementCount(); i < count; ++i)
+    {
+        key.locations[i] = getVertexAttribute(effect, vertexFormat.getElement(i).usage);
+    }
 
     // Search for an existing vertex attribute binding that can be used.
-    VertexAttributeBinding* b;
-    for (size_t i = 0, count = __vertexAttributeBindingCache.size(); i < count; ++i)
+    std::unordered_map<VertexAttributeBindingKey, VertexAttributeBinding*, VertexAttributeBindingKeyHash>::const_iterator itr = __vertexAttributeBindingCache.find(key);
+    if (itr != __vertexAttributeBindingCache.end())
     {
-        b = __vertexAttributeBindingCache[i];
+        // Found a match!
+        VertexAttributeBinding* b = itr->second;
         GP_ASSERT(b);
-        if (b->_mesh == mesh && b->_effect == effect)
+        b->addRef();
+        ++__vertexAttributeBindingCacheStatistics.hits;
+        if (b->_effect != effect)
         {
-            // Found a match!
-            b->addRef();
-            return b;
+            ++__vertexAttributeBindingCacheStatistics.sharedHits;
         }
+        return b;
     }
 
-    b = create(mesh, mesh->getVertexFormat(), 0, effect);
+    ++__vertexAttributeBindingCacheStatistics.misses;
+    VertexAttributeBinding* b = create(mesh, vertexFormat, 0, effect);
 
     // Add the new vertex attribute binding to the cache.
     if (b)
     {
-        __vertexAttributeBindingCache.push_back(b);
+        b->_locations = key.locations;
+        __vertexAttributeBindingCache[key] = b;
+        __vertexAttributeBindingCacheStatistics.size = (unsigned int)__vertexAttributeBindingCache.size();
     }
 
     return b;
 }
 
+const VertexAttributeBinding::CacheStatistics& VertexAttributeBinding::getCacheStatistics()
+{
+    return __vertexAttributeBindingCacheStatistics;
+}
+
 VertexAttributeBinding* VertexAttributeBinding::create(const VertexFormat& vertexFormat, void* vertexPointer, Effect* effect)
 {
     return create(NULL, vertexFormat, vertexPointer, effect);
@@ -140,57 +253,11 @@ VertexAttributeBinding* VertexAttributeBinding::create(Mesh* mesh, const VertexF
     effect->addRef();
 
     // Call setVertexAttribPointer for each vertex element.
-    std::string name;
     size_t offset = 0;
     for (size_t i = 0, count = vertexFormat.getElementCount(); i < count; ++i)
     {
         const VertexFormat::Element& e = vertexFormat.getElement(i);
-        gameplay::VertexAttribute attrib;
-
-        // Constructor vertex attribute name expected in shader.
-        switch (e.usage)
-        {
-        case VertexFormat::POSITION:
-            attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_POSITION_NAME);
-            break;
-        case VertexFormat::NORMAL:
-            attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_NORMAL_NAME);
-            break;
-        case VertexFormat::COLOR:
-            attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_COLOR_NAME);
-            break;
-        case VertexFormat::TANGENT:
-            attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_TANGENT_NAME);
-            break;
-        case VertexFormat::BINORMAL:
-            attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_BINORMAL_NAME);
-            break;
-        case VertexFormat::BLENDWEIGHTS:
-            attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_BLENDWEIGHTS_NAME);
-            break;
-        case VertexFormat::BLENDINDICES:
-            attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_BLENDINDICES_NAME);
-            break;
-        case VertexFormat::TEXCOORD0:
-            if ((attrib = effect->getVertexAttribute(VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME)) != -1)
-                break;
-
-        case VertexFormat::TEXCOORD1:
-        case VertexFormat::TEXCOORD2:
-        case VertexFormat::TEXCOORD3:
-        case VertexFormat::TEXCOORD4:
-        case VertexFormat::TEXCOORD5:
-        case VertexFormat::TEXCOORD6:
-        case VertexFormat::TEXCOORD7:
-            name = VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME;
-            name += '0' + (e.usage - VertexFormat::TEXCOORD0);
-            attrib = effect->getVertexAttribute(name.c_str());
-            break;
-        default:
-            // This happens whenever vertex data contains extra information (not an error).
-            attrib = -1;
-            break;
-        }
+        gameplay::VertexAttribute attrib = getVertexAttribute(effect, e.usage);
 
         if (attrib == -1)
         {
@@ -33,14 +33,31 @@ class VertexAttributeBinding : public Ref
 {
 public:
 
+    /**
+     * Counters of the cache of mesh vertex attribute bindings.
+     */
+    struct CacheStatistics
+    {
+        /** Number of lookups that returned a cached binding. */
+        unsigned int hits;
+        /** Number of cache hits where the binding was created for another effect with the same attribute locations. */
+        unsigned int sharedHits;
+        /** Number of lookups that created a new binding. */
+        unsigned int misses;
+        /** Number of bindings in the cache. */
+        unsigned int size;
+    };
+
     /**
      * Creates a new VertexAttributeBinding between the given Mesh and Effect.
      *
-     * If a VertexAttributeBinding matching the specified Mesh and Effect already
-     * exists, it will be returned. Otherwise, a new VertexAttributeBinding will
-     * be returned. If OpenGL VAOs are enabled, the a new VAO will be created and
-     * stored in the returned VertexAttributeBinding, otherwise a client-side
-     * array of vertex attribute bindings will be stored.
+     * If a VertexAttributeBinding matching the specified Mesh and the attribute
+     * locations of the specified Effect already exists, it will be returned, so
+     * effects that use the same attribute locations share the same VAO. Otherwise,
+     * a new VertexAttributeBinding will be returned. If OpenGL VAOs are enabled,
+     * the a new VAO will be created and stored in the returned
+     * VertexAttributeBinding, otherwise a client-side array of vertex attribute
+     * bindings will be stored.
      *
      * @param mesh The mesh.
      * @param effect The effect.
@@ -68,6 +85,14 @@ public:
      */
     static VertexAttributeBinding* create(const VertexFormat& vertexFormat, void* vertexPointer, Effect* effect);
 
+    /**
+     * Gets the counters of the cache of mesh vertex attribute bindings.
+     *
+     * @return The cache statistics.
+     * @script{ignore}
+     */
+    static const CacheStatistics& getCacheStatistics();
+
     /**
      * Binds this vertex array object.
      */
@@ -114,6 +139,7 @@ private:
     VertexAttribute* _attributes;
     unsigned int _attributesCount;
     Mesh* _mesh;
+    std::vector<GLint> _locations;      // Attribute location of each vertex element of the mesh, the cache key with the mesh.
     Effect* _effect;
 };
 
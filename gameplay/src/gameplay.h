@@ -17,6 +17,10 @@
 #include "MathUtil.h"
 #include "Logger.h"
 #include "Package.h"
+#include "JobScheduler.h"
+#include "ResourceLoader.h"
+#include "ResourceCache.h"
+#include "ProgramCache.h"
 
 // Math
 #include "Rectangle.h"
@@ -32,6 +36,8 @@
 #include "Frustum.h"
 #include "BoundingSphere.h"
 #include "BoundingBox.h"
+#include "BoundingVolumeHierarchy.h"
+#include "OcclusionCuller.h"
 #include "Curve.h"
 
 // Graphics
@@ -46,6 +52,8 @@
 #include "VertexAttributeBinding.h"
 #include "Drawable.h"
 #include "Model.h"
+#include "InstancedModel.h"
+#include "RenderQueue.h"
 #include "Camera.h"
 #include "Light.h"
 #include "Node.h"
@@ -53,6 +61,7 @@
 #include "Scene.h"
 #include "Font.h"
 #include "SpriteBatch.h"
+#include "TextureAtlas.h"
 #include "Sprite.h"
 #include "Text.h"
 #include "TileSet.h"
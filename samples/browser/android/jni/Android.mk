@@ -38,6 +38,7 @@ LOCAL_SRC_FILES := ../../../gameplay/src/gameplay-main-android.cpp \
     LightSample.cpp \
     MeshBatchSample.cpp \
     MeshPrimitiveSample.cpp \
+    ParticleBenchmarkSample.cpp \
     ParticlesSample.cpp \
     PhysicsCollisionObjectSample.cpp \
     PostProcessSample.cpp \
@@ -23,6 +23,7 @@ SOURCES += src/Audio3DSample.cpp \
     src/LightSample.cpp \
     src/MeshBatchSample.cpp \
     src/MeshPrimitiveSample.cpp \
+    src/ParticleBenchmarkSample.cpp \
     src/ParticlesSample.cpp \
     src/PhysicsCollisionObjectSample.cpp \
     src/PostProcessSample.cpp \
@@ -50,6 +51,7 @@ HEADERS += src/Audio3DSample.h \
     src/LightSample.h \
     src/MeshBatchSample.h \
     src/MeshPrimitiveSample.h \
+    src/ParticleBenchmarkSample.h \
     src/ParticlesSample.h \
     src/PhysicsCollisionObjectSample.h \
     src/PostProcessSample.h \
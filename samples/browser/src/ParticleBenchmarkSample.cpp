@@ -0,0 +1,169 @@
+#include "ParticleBenchmarkSample.h"
+#include "SamplesGame.h"
+
+#if defined(ADD_SAMPLE)
+    ADD_SAMPLE("Graphics", "Particle Benchmark", ParticleBenchmarkSample, 17);
+#endif
+
+#define BENCHMARK_PARTICLE_EMITTER "res/common/particles/fire.particle"
+#define BENCHMARK_SAMPLE_PERIOD    1000.0
+
+static const unsigned int __emitterCounts[] = { 1, 100, 1000 };
+static const unsigned int __emitterCountsSize = sizeof(__emitterCounts) / sizeof(__emitterCounts[0]);
+
+ParticleBenchmarkSample::ParticleBenchmarkSample()
+    : _font(NULL), _scene(NULL), _emitterCountIndex(0), _batched(false), _updateTime(0), _updateCount(0),
+    _sampleStartTime(0), _averageUpdateTime(0)
+{
+}
+
+void ParticleBenchmarkSample::initialize()
+{
+    // Create the font for drawing the results.
+    _font = Font::create("res/ui/arial.gpb");
+
+    // The emitters only need a scene for their world transforms, they are not drawn.
+    _scene = Scene::create();
+
+    createEmitters(__emitterCounts[_emitterCountIndex]);
+}
+
+void ParticleBenchmarkSample::finalize()
+{
+    _emitters.clear();
+    SAFE_RELEASE(_scene);
+    SAFE_RELEASE(_font);
+}
+
+void ParticleBenchmarkSample::createEmitters(unsigned int count)
+{
+    _scene->removeAllNodes();
+    _emitters.clear();
+
+    // Spread the emitters on a grid in the XY plane.
+    unsigned int columns = (unsigned int)ceilf(sqrtf((float)count));
+    for (unsigned int i = 0; i < count; i++)
+    {
+        ParticleEmitter* emitter = ParticleEmitter::create(BENCHMARK_PARTICLE_EMITTER);
+        if (emitter == NULL)
+        {
+            GP_ERROR("Failed to create particle emitter '%s'.", BENCHMARK_PARTICLE_EMITTER);
+            break;
+        }
+
+        Node* node = _scene->addNode();
+        node->setTranslation((float)(i % columns) * 4.0f, (float)(i / columns) * 4.0f, 0.0f);
+        node->setDrawable(emitter);
+        emitter->release();
+        emitter->start();
+        _emitters.push_back(emitter);
+    }
+
+    resetTimings();
+}
+
+void ParticleBenchmarkSample::resetTimings()
+{
+    _updateTime = 0;
+    _updateCount = 0;
+    _sampleStartTime = getAbsoluteTime();
+    _averageUpdateTime = 0;
+}
+
+void ParticleBenchmarkSample::update(float elapsedTime)
+{
+    if (_emitters.empty())
+        return;
+
+    double start = Game::getPlatformTime();
+    if (_batched)
+    {
+        ParticleEmitter::updateEmitters(&_emitters[0], (unsigned int)_emitters.size(), elapsedTime);
+    }
+    else
+    {
+        for (size_t i = 0, count = _emitters.size(); i < count; i++)
+            _emitters[i]->update(elapsedTime);
+    }
+    _updateTime += Game::getPlatformTime() - start;
+    _updateCount++;
+
+    // Publish the average update time once per sample period.
+    if (getAbsoluteTime() - _sampleStartTime >= BENCHMARK_SAMPLE_PERIOD)
+    {
+        _averageUpdateTime = (float)(_updateTime / _updateCount);
+        _updateTime = 0;
+        _updateCount = 0;
+        _sampleStartTime = getAbsoluteTime();
+    }
+}
+
+void ParticleBenchmarkSample::render(float elapsedTime)
+{
+    clear(CLEAR_COLOR_DEPTH, Vector4::zero(), 1.0f, 0);
+
+    unsigned int particleCount = 0;
+    for (size_t i = 0, count = _emitters.size(); i < count; i++)
+        particleCount += _emitters[i]->getParticlesCount();
+
+    JobScheduler* scheduler = Game::getInstance()->getJobScheduler();
+    wchar_t buffer[256];
+    swprintf(buffer, 256,
+        L"Emitters: %u (touch the left side to change)\n"
+        L"Particles: %u\n"
+        L"Update: %ls (touch the right side to change)\n"
+        L"Worker threads: %u\n"
+        L"Average update time: %.3f ms",
+        (unsigned int)_emitters.size(), particleCount,
+        _batched ? L"ParticleEmitter::updateEmitters" : L"ParticleEmitter::update",
+        scheduler ? scheduler->getWorkerCount() : 0, _averageUpdateTime);
+
+    _font->start();
+    _font->drawText(buffer, 20, 40, Vector4::one(), 18);
+    _font->finish();
+
+    drawFrameRate(_font, Vector4(0, 0.5f, 1, 1), 5, 1, getFrameRate());
+}
+
+void ParticleBenchmarkSample::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
+{
+    if (evt != Touch::TOUCH_PRESS)
+        return;
+
+    if (x < 75 && y < 50)
+    {
+        // Toggle Vsync if the user touches the top left corner.
+        setVsync(!isVsync());
+    }
+    else if (x < (int)getWidth() / 2)
+    {
+        _emitterCountIndex = (_emitterCountIndex + 1) % __emitterCountsSize;
+        createEmitters(__emitterCounts[_emitterCountIndex]);
+    }
+    else
+    {
+        _batched = !_batched;
+        resetTimings();
+    }
+}
+
+void ParticleBenchmarkSample::keyEvent(Keyboard::KeyEvent evt, int key)
+{
+    if (evt != Keyboard::KEY_PRESS)
+        return;
+
+    switch (key)
+    {
+    case Keyboard::KEY_ONE:
+    case Keyboard::KEY_TWO:
+    case Keyboard::KEY_THREE:
+        _emitterCountIndex = key - Keyboard::KEY_ONE;
+        createEmitters(__emitterCounts[_emitterCountIndex]);
+        break;
+    case Keyboard::KEY_B:
+    case Keyboard::KEY_CAPITAL_B:
+        _batched = !_batched;
+        resetTimings();
+        break;
+    }
+}
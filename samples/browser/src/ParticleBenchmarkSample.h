@@ -0,0 +1,50 @@
+#ifndef PARTICLEBENCHMARKSAMPLE_H_
+#define PARTICLEBENCHMARKSAMPLE_H_
+
+#include "gameplay.h"
+#include "Sample.h"
+
+using namespace gameplay;
+
+/**
+ * Sample measuring the cost of updating 1, 100 and 1000 particle emitters,
+ * one at a time or in a batch spread over the job scheduler's worker threads.
+ */
+class ParticleBenchmarkSample : public Sample
+{
+public:
+
+    ParticleBenchmarkSample();
+
+    void touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex);
+
+    void keyEvent(Keyboard::KeyEvent evt, int key);
+
+protected:
+
+    void initialize();
+
+    void finalize();
+
+    void update(float elapsedTime);
+
+    void render(float elapsedTime);
+
+private:
+
+    void createEmitters(unsigned int count);
+
+    void resetTimings();
+
+    Font* _font;
+    Scene* _scene;
+    std::vector<ParticleEmitter*> _emitters;
+    unsigned int _emitterCountIndex;
+    bool _batched;
+    double _updateTime;
+    unsigned int _updateCount;
+    double _sampleStartTime;
+    float _averageUpdateTime;
+};
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef REFERENCEMATH_H_
+#define REFERENCEMATH_H_
+
+/**
+ * Reference scalar matrix kernels, compiled in their own translation unit so that the
+ * kernels selected by MathUtil.h (SSE, NEON or scalar), which are reached through the
+ * Matrix class, can be compared against them in a single executable.
+ */
+namespace reference
+{
+
+void multiplyMatrix(const float* m1, const float* m2, float* dst);
+
+void transposeMatrix(const float* m, float* dst);
+
+bool invertMatrix(const float* m, float* dst);
+
+void transformPoint(const float* m, float x, float y, float z, float* dst);
+
+}
+
+#endif
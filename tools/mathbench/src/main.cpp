@@ -0,0 +1,138 @@
+#include "Base.h"
+#include "Matrix.h"
+#include "Vector3.h"
+#include "MathUtil.h"
+#include "ReferenceMath.h"
+
+using namespace gameplay;
+
+#define MATRIX_COUNT    1024
+#define POINT_COUNT     4096
+#define ITERATIONS      200
+
+static const char* getKernelName()
+{
+#if defined(GP_USE_NEON)
+    return "NEON";
+#elif defined(GP_SIMD_SSE)
+    return "SSE";
+#else
+    return "scalar";
+#endif
+}
+
+static float randomFloat()
+{
+    return (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static double now()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+// Compares two float arrays, returns false if they differ by more than a relative epsilon.
+static bool compare(const float* a, const float* b, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++)
+    {
+        if (fabsf(a[i] - b[i]) > 0.0001f * (1.0f + fabsf(b[i])))
+            return false;
+    }
+    return true;
+}
+
+static void report(const char* name, double referenceTime, double kernelTime, bool match)
+{
+    printf("%-24s %10.3f ms %10.3f ms %8.2fx %s\n", name, referenceTime, kernelTime,
+        kernelTime > 0 ? referenceTime / kernelTime : 0.0, match ? "" : "MISMATCH");
+}
+
+int main(int argc, char** argv)
+{
+    srand(1);
+
+    std::vector<Matrix> matrices(MATRIX_COUNT);
+    for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+    {
+        Matrix::createRotation(Vector3(randomFloat(), randomFloat(), randomFloat()), randomFloat() * MATH_PI, &matrices[i]);
+        matrices[i].scale(1.0f + randomFloat() * 0.5f);
+        matrices[i].translate(randomFloat() * 10.0f, randomFloat() * 10.0f, randomFloat() * 10.0f);
+    }
+
+    std::vector<Vector3> points(POINT_COUNT);
+    for (unsigned int i = 0; i < POINT_COUNT; i++)
+    {
+        points[i].set(randomFloat() * 100.0f, randomFloat() * 100.0f, randomFloat() * 100.0f);
+    }
+
+    std::vector<Matrix> referenceResult(MATRIX_COUNT);
+    std::vector<Matrix> kernelResult(MATRIX_COUNT);
+    std::vector<Vector3> referencePoints(POINT_COUNT);
+    std::vector<Vector3> kernelPoints(POINT_COUNT);
+    double start, referenceTime, kernelTime;
+
+    printf("gameplay math kernels: %s\n", getKernelName());
+    printf("%-24s %13s %13s %9s\n", "", "scalar", getKernelName(), "speedup");
+
+    // Matrix multiply.
+    start = now();
+    for (unsigned int n = 0; n < ITERATIONS; n++)
+        for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+            reference::multiplyMatrix(matrices[i].m, matrices[(i + n + 1) % MATRIX_COUNT].m, referenceResult[i].m);
+    referenceTime = now() - start;
+    start = now();
+    for (unsigned int n = 0; n < ITERATIONS; n++)
+        for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+            Matrix::multiply(matrices[i], matrices[(i + n + 1) % MATRIX_COUNT], &kernelResult[i]);
+    kernelTime = now() - start;
+    report("multiply", referenceTime, kernelTime, compare(kernelResult[0].m, referenceResult[0].m, MATRIX_COUNT * 16));
+
+    // Matrix transpose.
+    start = now();
+    for (unsigned int n = 0; n < ITERATIONS; n++)
+        for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+            reference::transposeMatrix(matrices[(i + n) % MATRIX_COUNT].m, referenceResult[i].m);
+    referenceTime = now() - start;
+    start = now();
+    for (unsigned int n = 0; n < ITERATIONS; n++)
+        for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+            matrices[(i + n) % MATRIX_COUNT].transpose(&kernelResult[i]);
+    kernelTime = now() - start;
+    report("transpose", referenceTime, kernelTime, compare(kernelResult[0].m, referenceResult[0].m, MATRIX_COUNT * 16));
+
+    // Matrix invert. Matrix::invert() computes the adjugate in scalar code and scales it
+    // with the selected multiplyMatrix kernel.
+    start = now();
+    for (unsigned int n = 0; n < ITERATIONS; n++)
+        for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+            reference::invertMatrix(matrices[(i + n) % MATRIX_COUNT].m, referenceResult[i].m);
+    referenceTime = now() - start;
+    start = now();
+    for (unsigned int n = 0; n < ITERATIONS; n++)
+        for (unsigned int i = 0; i < MATRIX_COUNT; i++)
+            matrices[(i + n) % MATRIX_COUNT].invert(&kernelResult[i]);
+    kernelTime = now() - start;
+    report("invert", referenceTime, kernelTime, compare(kernelResult[0].m, referenceResult[0].m, MATRIX_COUNT * 16));
+
+    // Batched point transform.
+    start = now();
+    for (unsigned int n = 0; n < ITERATIONS; n++)
+    {
+        const Matrix& m = matrices[n % MATRIX_COUNT];
+        for (unsigned int i = 0; i < POINT_COUNT; i++)
+            reference::transformPoint(m.m, points[i].x, points[i].y, points[i].z, &referencePoints[i].x);
+    }
+    referenceTime = now() - start;
+    start = now();
+    for (unsigned int n = 0; n < ITERATIONS; n++)
+    {
+        const Matrix& m = matrices[n % MATRIX_COUNT];
+        for (unsigned int i = 0; i < POINT_COUNT; i++)
+            m.transformPoint(points[i], &kernelPoints[i]);
+    }
+    kernelTime = now() - start;
+    report("transformPoint", referenceTime, kernelTime, compare(&kernelPoints[0].x, &referencePoints[0].x, POINT_COUNT * 3));
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include "gameplay.h"
+
+#ifndef GP_NULL_GL
+#error "gameplay-renderbench requires the gameplay library built with the null GL backend (-DGP_NULL_GL=ON)."
+#endif
+
+using namespace gameplay;
+
+#define DEFAULT_FRAME_COUNT     300
+#define WARMUP_FRAME_COUNT      10
+
+/**
+ * Renders scenes with the null GL backend and reports the CPU time and the GL work of a frame.
+ */
+class RenderBench : public Game
+{
+public:
+
+    RenderBench(const std::vector<std::string>& scenes, unsigned int frameCount, bool useRenderQueue, bool useDrawableTree, bool useOcclusion)
+        : _scenes(scenes), _frameCount(frameCount), _useRenderQueue(useRenderQueue), _useDrawableTree(useDrawableTree),
+          _useOcclusion(useOcclusion), _renderQueue(NULL), _occlusionCuller(NULL),
+          _scene(NULL), _sceneIndex(0), _frame(0), _startTime(0.0), _failed(false)
+    {
+    }
+
+    bool failed() const
+    {
+        return _failed;
+    }
+
+protected:
+
+    void initialize()
+    {
+        if (_useRenderQueue)
+        {
+            _renderQueue = RenderQueue::create();
+        }
+        if (_useOcclusion)
+        {
+            _occlusionCuller = OcclusionCuller::create();
+        }
+        printf("%-24s %10s %10s %10s %10s %10s %12s %12s %12s\n", "scene", "frame ms", "draws", "vertices",
+            "states", "redundant", "buffer B", "texture B", "uniform B");
+    }
+
+    void finalize()
+    {
+        SAFE_DELETE(_occlusionCuller);
+        SAFE_RELEASE(_scene);
+        SAFE_DELETE(_renderQueue);
+    }
+
+    void update(float elapsedTime)
+    {
+        if (_scene == NULL)
+        {
+            if (_sceneIndex >= _scenes.size())
+            {
+                exit();
+                return;
+            }
+
+            _scene = Scene::load(_scenes[_sceneIndex].c_str());
+            if (_scene == NULL || _scene->getActiveCamera() == NULL)
+            {
+                GP_WARN("Failed to load a scene with an active camera from '%s'.", _scenes[_sceneIndex].c_str());
+                SAFE_RELEASE(_scene);
+                _failed = true;
+                ++_sceneIndex;
+                return;
+            }
+            _scene->getActiveCamera()->setAspectRatio(getAspectRatio());
+            if (_occlusionCuller)
+            {
+                _occlusionCuller->addOccluders(_scene);
+            }
+            _frame = 0;
+        }
+
+        // The first frames load and bind resources for the first time, they are not measured.
+        if (_frame == WARMUP_FRAME_COUNT)
+        {
+            NullGL::resetStatistics();
+            _startTime = getAbsoluteTime();
+        }
+    }
+
+    void render(float elapsedTime)
+    {
+        if (_scene == NULL)
+            return;
+
+        clear(CLEAR_COLOR_DEPTH, Vector4::zero(), 1.0f, 0);
+        if (_occlusionCuller)
+        {
+            _occlusionCuller->render(_scene->getActiveCamera());
+        }
+        if (_renderQueue)
+        {
+            _renderQueue->begin(_scene->getActiveCamera());
+        }
+        if (_useDrawableTree)
+        {
+            _drawables.clear();
+            _scene->findVisibleDrawables(_scene->getActiveCamera()->getFrustum(), _drawables, _occlusionCuller);
+            for (size_t i = 0, count = _drawables.size(); i < count; ++i)
+            {
+                _drawables[i]->draw();
+            }
+        }
+        else
+        {
+            _scene->visit(this, &RenderBench::drawScene);
+        }
+        if (_renderQueue)
+        {
+            _renderQueue->end();
+        }
+
+        if (++_frame == WARMUP_FRAME_COUNT + _frameCount)
+        {
+            report(_scenes[_sceneIndex].c_str(), getAbsoluteTime() - _startTime);
+            if (_occlusionCuller)
+            {
+                _occlusionCuller->removeAllOccluders();
+            }
+            SAFE_RELEASE(_scene);
+            ++_sceneIndex;
+        }
+    }
+
+private:
+
+    bool drawScene(Node* node)
+    {
+        Drawable* drawable = node->getDrawable();
+        if (drawable && node->getBoundingSphere().intersects(_scene->getActiveCamera()->getFrustum()) &&
+            (_occlusionCuller == NULL || _occlusionCuller->isVisible(node)))
+        {
+            drawable->draw();
+        }
+        return true;
+    }
+
+    void report(const char* scene, double time)
+    {
+        const NullGL::Statistics& statistics = NullGL::getStatistics();
+        const double frames = (double)_frameCount;
+        printf("%-24s %10.3f %10.1f %10.0f %10.1f %10.1f %12.0f %12.0f %12.0f\n", scene, time / frames,
+            statistics.drawCalls / frames, statistics.verticesDrawn / frames,
+            statistics.stateChanges / frames, statistics.redundantStateChanges / frames,
+            statistics.bufferBytes / frames, statistics.textureBytes / frames, statistics.uniformBytes / frames);
+        if (_occlusionCuller)
+        {
+            const OcclusionCuller::Statistics& occlusion = _occlusionCuller->getStatistics();
+            printf("    %-28s %10u\n", "occluder triangles", occlusion.trianglesRasterized);
+            printf("    %-28s %10u of %u\n", "occluded drawables", occlusion.boxesOccluded, occlusion.boxesTested);
+        }
+        for (unsigned int i = 0; i < NullGL::ENTRY_POINT_COUNT; ++i)
+        {
+            if (statistics.calls[i] > 0)
+            {
+                printf("    %-28s %10.1f\n", NullGL::getEntryPointName((NullGL::EntryPoint)i), statistics.calls[i] / frames);
+            }
+        }
+    }
+
+    std::vector<std::string> _scenes;
+    unsigned int _frameCount;
+    bool _useRenderQueue;
+    bool _useDrawableTree;
+    bool _useOcclusion;
+    std::vector<Drawable*> _drawables;
+    RenderQueue* _renderQueue;
+    OcclusionCuller* _occlusionCuller;
+    Scene* _scene;
+    size_t _sceneIndex;
+    unsigned int _frame;
+    double _startTime;
+    bool _failed;
+};
+
+extern int __argc;
+extern char** __argv;
+
+int main(int argc, char** argv)
+{
+    __argc = argc;
+    __argv = argv;
+
+    std::vector<std::string> scenes;
+    unsigned int frameCount = DEFAULT_FRAME_COUNT;
+    bool useRenderQueue = false;
+    bool useDrawableTree = false;
+    bool useOcclusion = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-frames") == 0 && i + 1 < argc)
+        {
+            frameCount = (unsigned int)atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-queue") == 0)
+        {
+            useRenderQueue = true;
+        }
+        else if (strcmp(argv[i], "-tree") == 0)
+        {
+            useDrawableTree = true;
+        }
+        else if (strcmp(argv[i], "-occlusion") == 0)
+        {
+            useOcclusion = true;
+        }
+        else
+        {
+            scenes.push_back(argv[i]);
+        }
+    }
+    if (scenes.empty() || frameCount == 0)
+    {
+        printf("usage: gameplay-renderbench [-frames count] [-queue] [-tree] [-occlusion] scene...\n");
+        return 1;
+    }
+
+    RenderBench bench(scenes, frameCount, useRenderQueue, useDrawableTree, useOcclusion);
+    Platform* platform = Platform::create(&bench);
+    GP_ASSERT(platform);
+    platform->enterMessagePump();
+    delete platform;
+
+    return bench.failed() ? 1 : 0;
+}